@@ -0,0 +1,132 @@
+// benchmarks/lane_benchmark.cpp
+//
+// Measures order-entry latency while "dashboards" poll a deep order book.
+// One client submits and cancels orders in a closed loop; a varying number of
+// dashboard clients call ViewOrderBook as fast as they can. Each load runs
+// with handlers on gRPC's threads and on the lane scheduler.
+//
+// Usage: lane_benchmark [seconds] [book_depth]
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "in_process_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Results {
+        std::vector<double> entry_latencies_us;
+        uint64_t views = 0;
+    };
+
+    order_service::OrderRequest makeOrder(const std::string& order_id, const std::string& symbol, double price) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("lanes");
+        details->set_stock_symbol(symbol);
+        details->set_price(price);
+        details->set_quantity(10);
+        details->set_is_buy_order(true);
+        return request;
+    }
+
+    double percentile(std::vector<double>& values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+
+    Results run(bool use_lanes, int dashboards, int seconds, int book_depth) {
+        auto server = std::make_shared<OrderClientServer>();
+        for (int i = 0; i < book_depth; ++i) {
+            server->submitOrder(makeOrder("book_" + std::to_string(i), "DASH", 50.0 + i % 100));
+        }
+
+        std::shared_ptr<LaneScheduler> lanes;
+        if (use_lanes) {
+            lanes = std::make_shared<LaneScheduler>();
+        }
+        InProcessServer in_process({.orders = server, .lanes = lanes});
+        auto channel = in_process.channel();
+
+        Results results;
+        std::atomic<bool> done{false};
+        std::atomic<uint64_t> views{0};
+        std::vector<std::thread> viewers;
+        for (int d = 0; d < dashboards; ++d) {
+            viewers.emplace_back([&] {
+                auto stub = order_service::OrderService::NewStub(channel);
+                order_service::ViewOrderBookRequest request;
+                request.set_symbol("DASH");
+                while (!done.load(std::memory_order_relaxed)) {
+                    order_service::ViewOrderBookResponse response;
+                    grpc::ClientContext context;
+                    if (stub->ViewOrderBook(&context, request, &response).ok()) {
+                        views.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        auto stub = order_service::OrderService::NewStub(channel);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        for (int i = 0; std::chrono::steady_clock::now() < deadline; ++i) {
+            std::string order_id = "entry_" + std::to_string(i);
+            auto request = makeOrder(order_id, "ENTRY", 10.0);
+            order_service::OrderResponse order_response;
+            grpc::ClientContext order_context;
+            auto start = std::chrono::steady_clock::now();
+            stub->SubmitOrder(&order_context, request, &order_response);
+            auto submitted = std::chrono::steady_clock::now();
+
+            order_service::CancelRequest cancel;
+            cancel.set_order_id(order_id);
+            cancel.set_is_buy_order(true);
+            order_service::CancelResponse cancel_response;
+            grpc::ClientContext cancel_context;
+            stub->CancelOrder(&cancel_context, cancel, &cancel_response);
+            auto cancelled = std::chrono::steady_clock::now();
+
+            results.entry_latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(submitted - start).count());
+            results.entry_latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(cancelled - submitted).count());
+        }
+
+        done = true;
+        for (auto& viewer : viewers) {
+            viewer.join();
+        }
+        results.views = views.load();
+        return results;
+    }
+}
+
+int main(int argc, char** argv) {
+    int seconds = argc > 1 ? std::atoi(argv[1]) : 3;
+    int book_depth = argc > 2 ? std::atoi(argv[2]) : 5000;
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("%d s per run, %d orders in the viewed book\n", seconds, book_depth);
+    std::printf("%-6s %10s %10s %12s %12s %12s\n", "lanes", "dashboards", "views", "entry p50", "entry p99", "entry max");
+    for (int dashboards : {0, 2, 8}) {
+        for (bool use_lanes : {false, true}) {
+            auto results = run(use_lanes, dashboards, seconds, book_depth);
+            auto& latencies = results.entry_latencies_us;
+            double max = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+            std::printf("%-6s %10d %10llu %9.0f us %9.0f us %9.0f us\n", use_lanes ? "on" : "off", dashboards,
+                        static_cast<unsigned long long>(results.views),
+                        percentile(latencies, 0.50), percentile(latencies, 0.99), max);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// benchmarks/overload_benchmark.cpp
+//
+// Drives an in-process OrderServer past saturation: a deep resting book makes
+// every submit expensive, and more client threads submit and cancel than the
+// server can match. The same load runs with admission control off and on, and
+// the latency of the requests the server accepted is compared.
+//
+// Usage: overload_benchmark [client_threads] [seconds] [max_in_flight] [target_delay_us]
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "in_process_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int kRestingOrders = 20000;
+
+    struct Results {
+        std::vector<double> order_latencies_us;
+        std::vector<double> cancel_latencies_us;
+        uint64_t orders_rejected = 0;
+        uint64_t cancels_rejected = 0;
+        uint64_t failed = 0;
+    };
+
+    order_service::OrderRequest makeOrder(const std::string& order_id, double price, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("overload");
+        details->set_stock_symbol("LOAD");
+        details->set_price(price);
+        details->set_quantity(10);
+        details->set_is_buy_order(is_buy);
+        return request;
+    }
+
+    double percentile(std::vector<double>& values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+
+    // Classifies one call; returns false when it was shed
+    bool record(const grpc::Status& status, uint64_t& rejected, uint64_t& failed) {
+        if (status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+            ++rejected;
+            return false;
+        }
+        if (!status.ok()) {
+            ++failed;
+            return false;
+        }
+        return true;
+    }
+
+    Results run(std::shared_ptr<AdmissionController> admission, int client_threads, int seconds) {
+        auto server = std::make_shared<OrderClientServer>();
+        for (int i = 0; i < kRestingOrders; ++i) {
+            server->submitOrder(makeOrder("rest_" + std::to_string(i), 200.0 + i % 500, false));
+        }
+
+        InProcessServer in_process({.orders = server, .admission = std::move(admission)});
+        auto channel = in_process.channel();
+
+        Results results;
+        std::mutex results_mutex;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+
+        std::vector<std::thread> clients;
+        for (int t = 0; t < client_threads; ++t) {
+            clients.emplace_back([&, t] {
+                auto stub = order_service::OrderService::NewStub(channel);
+                Results local;
+                std::string resting;
+                for (int i = 0; std::chrono::steady_clock::now() < deadline; ++i) {
+                    // Every third call cancels the client's last resting order
+                    if (i % 3 == 2 && !resting.empty()) {
+                        order_service::CancelRequest request;
+                        request.set_order_id(resting);
+                        request.set_is_buy_order(true);
+                        order_service::CancelResponse response;
+                        grpc::ClientContext context;
+                        auto start = std::chrono::steady_clock::now();
+                        auto status = stub->CancelOrder(&context, request, &response);
+                        std::chrono::duration<double, std::micro> elapsed =
+                            std::chrono::steady_clock::now() - start;
+                        if (record(status, local.cancels_rejected, local.failed)) {
+                            local.cancel_latencies_us.push_back(elapsed.count());
+                            resting.clear();
+                        }
+                        continue;
+                    }
+
+                    std::string order_id = "c" + std::to_string(t) + "_" + std::to_string(i);
+                    auto request = makeOrder(order_id, 100.0, true);
+                    order_service::OrderResponse response;
+                    grpc::ClientContext context;
+                    auto start = std::chrono::steady_clock::now();
+                    auto status = stub->SubmitOrder(&context, request, &response);
+                    std::chrono::duration<double, std::micro> elapsed =
+                        std::chrono::steady_clock::now() - start;
+                    if (record(status, local.orders_rejected, local.failed)) {
+                        local.order_latencies_us.push_back(elapsed.count());
+                        resting = order_id;
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(results_mutex);
+                results.order_latencies_us.insert(results.order_latencies_us.end(),
+                                                  local.order_latencies_us.begin(),
+                                                  local.order_latencies_us.end());
+                results.cancel_latencies_us.insert(results.cancel_latencies_us.end(),
+                                                   local.cancel_latencies_us.begin(),
+                                                   local.cancel_latencies_us.end());
+                results.orders_rejected += local.orders_rejected;
+                results.cancels_rejected += local.cancels_rejected;
+                results.failed += local.failed;
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        return results;
+    }
+
+    void report(const char* label, Results& results) {
+        auto line = [](const char* kind, std::vector<double>& latencies, uint64_t rejected) {
+            std::printf("  %-7s admitted %8zu  rejected %8llu  p50 %9.0f us  p99 %9.0f us  max %9.0f us\n",
+                        kind, latencies.size(), static_cast<unsigned long long>(rejected),
+                        percentile(latencies, 0.50), percentile(latencies, 0.99),
+                        latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end()));
+        };
+        std::printf("%s\n", label);
+        line("orders", results.order_latencies_us, results.orders_rejected);
+        line("cancels", results.cancel_latencies_us, results.cancels_rejected);
+        if (results.failed > 0) {
+            std::printf("  %llu calls failed\n", static_cast<unsigned long long>(results.failed));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int client_threads = argc > 1 ? std::atoi(argv[1]) : 32;
+    int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    // One order or cancel per core: the order lock serialises the rest anyway
+    size_t max_in_flight = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    long target_delay_us = argc > 4 ? std::atol(argv[4]) : 500;
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("%d client threads, %d s per run, %d resting orders, budget %zu in flight, target %ld us\n",
+                client_threads, seconds, kRestingOrders, max_in_flight, target_delay_us);
+
+    auto unbounded = run(nullptr, client_threads, seconds);
+    report("admission control off", unbounded);
+
+    AdmissionConfig config;
+    config.max_in_flight = max_in_flight;
+    config.cancel_reserve = max_in_flight;
+    config.target_delay = std::chrono::microseconds(target_delay_us);
+    auto bounded = run(std::make_shared<AdmissionController>(config), client_threads, seconds);
+    report("admission control on", bounded);
+    return 0;
+}
@@ -0,0 +1,156 @@
+// benchmarks/rpc_allocation_benchmark.cpp
+//
+// Counts C++ heap allocations (operator new) per RPC through an in-process
+// channel. The figures cover the client stub, the gRPC C++ layer and the
+// service; gRPC core's own C allocations do not go through operator new and
+// are not counted.
+#include <benchmark/benchmark.h>
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "in_process_server.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <set>
+
+namespace {
+    std::atomic<uint64_t> allocation_count{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+}
+
+// GCC flags the malloc/free pairing once the replaced operators are inlined
+// into library code
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    // One server for every benchmark, started on first use
+    order_service::OrderService::Stub& inProcessStub() {
+        static auto stub = [] {
+            spdlog::set_level(spdlog::level::off);
+            static InProcessServer server;
+            return order_service::OrderService::NewStub(server.channel());
+        }();
+        return *stub;
+    }
+
+    order_service::OrderRequest makeOrder(const std::string& order_id, const std::string& symbol,
+                                          double price, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("bench_trader");
+        details->set_stock_symbol(symbol);
+        details->set_price(price);
+        details->set_quantity(100);
+        details->set_is_buy_order(is_buy);
+        return request;
+    }
+
+    // Runs `rpc` once per iteration and reports allocations per RPC, with the
+    // request messages built outside the counted region
+    template <typename Rpc>
+    void measure(benchmark::State& state, int rpcs_per_iteration, Rpc&& rpc) {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        int64_t iteration = 0;
+        for (auto _ : state) {
+            uint64_t count_before = allocation_count.load(std::memory_order_relaxed);
+            uint64_t bytes_before = allocated_bytes.load(std::memory_order_relaxed);
+            rpc(iteration++);
+            allocations += allocation_count.load(std::memory_order_relaxed) - count_before;
+            bytes += allocated_bytes.load(std::memory_order_relaxed) - bytes_before;
+        }
+        double rpcs = static_cast<double>(state.iterations()) * rpcs_per_iteration;
+        state.counters["allocs_per_rpc"] = static_cast<double>(allocations) / rpcs;
+        state.counters["bytes_per_rpc"] = static_cast<double>(bytes) / rpcs;
+    }
+}
+
+static void BM_SubmitCrossingOrders(benchmark::State& state) {
+    auto& stub = inProcessStub();
+    auto sell = makeOrder("sell", "FILL", 100.0, false);
+    auto buy = makeOrder("buy", "FILL", 100.0, true);
+    measure(state, 2, [&](int64_t) {
+        order_service::OrderResponse response;
+        grpc::ClientContext sell_context;
+        stub.SubmitOrder(&sell_context, sell, &response);
+        grpc::ClientContext buy_context;
+        stub.SubmitOrder(&buy_context, buy, &response);
+    });
+}
+BENCHMARK(BM_SubmitCrossingOrders);
+
+static void BM_SubmitAndCancel(benchmark::State& state) {
+    auto& stub = inProcessStub();
+    auto order = makeOrder("resting", "CANCEL", 50.0, true);
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("resting");
+    cancel.set_is_buy_order(true);
+    measure(state, 2, [&](int64_t) {
+        order_service::OrderResponse order_response;
+        grpc::ClientContext order_context;
+        stub.SubmitOrder(&order_context, order, &order_response);
+        order_service::CancelResponse cancel_response;
+        grpc::ClientContext cancel_context;
+        stub.CancelOrder(&cancel_context, cancel, &cancel_response);
+    });
+}
+BENCHMARK(BM_SubmitAndCancel);
+
+static void BM_ViewOrderBook(benchmark::State& state) {
+    auto& stub = inProcessStub();
+    const std::string symbol = "VIEW" + std::to_string(state.range(0));
+    static std::set<int64_t> populated;
+    if (populated.insert(state.range(0)).second) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            order_service::OrderResponse response;
+            grpc::ClientContext context;
+            stub.SubmitOrder(&context, makeOrder(symbol + "_" + std::to_string(i), symbol,
+                                                 10.0 + static_cast<double>(i % 50), true),
+                             &response);
+        }
+    }
+    order_service::ViewOrderBookRequest request;
+    request.set_symbol(symbol);
+    measure(state, 1, [&](int64_t) {
+        order_service::ViewOrderBookResponse response;
+        grpc::ClientContext context;
+        stub.ViewOrderBook(&context, request, &response);
+    });
+}
+BENCHMARK(BM_ViewOrderBook)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_GetOrderStatus(benchmark::State& state) {
+    auto& stub = inProcessStub();
+    static bool populated = false;
+    if (!populated) {
+        populated = true;
+        order_service::OrderResponse response;
+        grpc::ClientContext context;
+        stub.SubmitOrder(&context, makeOrder("status_order", "STATUS", 10.0, true), &response);
+    }
+    order_service::OrderStatusRequest request;
+    request.set_order_id("status_order");
+    measure(state, 1, [&](int64_t) {
+        order_service::OrderStatusResponse response;
+        grpc::ClientContext context;
+        stub.GetOrderStatus(&context, request, &response);
+    });
+}
+BENCHMARK(BM_GetOrderStatus);
+
+BENCHMARK_MAIN();
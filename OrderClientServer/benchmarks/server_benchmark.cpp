@@ -0,0 +1,243 @@
+// benchmarks/server_benchmark.cpp
+//
+// End-to-end throughput and latency of OrderClientServer against resting
+// books of 10 to 1M orders, from 1..N client threads. Each load runs twice:
+// calling OrderClientServer directly, and through OrderServiceImpl over an
+// in-process gRPC channel (no network).
+//
+// Every client submits a sell that rests above the whole bid side, then
+// cancels it, so the book keeps its size. The submit still sorts the full
+// bid side under the order lock, which is the O(n log n)-per-submit cost;
+// the "ns/nlogn" column divides submit p50 by n * log2(n) and stays roughly
+// flat while that sort dominates. Lock wait is the time requests spent
+// waiting for the order lock, as reported by the lock-wait listener.
+//
+// Usage: server_benchmark [seconds] [max_threads] [max_book] [json_out]
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "in_process_server.hpp"
+#include "order_client_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Results {
+        std::vector<double> submit_latencies_us;
+        std::vector<double> cancel_latencies_us;
+        uint64_t failed = 0;
+        double seconds = 0.0;
+        double lock_wait_total_us = 0.0;
+        uint64_t lock_waits = 0;
+    };
+
+    struct LockWaitTotals {
+        std::atomic<uint64_t> nanos{0};
+        std::atomic<uint64_t> count{0};
+    };
+
+    order_service::OrderRequest makeOrder(const std::string& order_id, double price, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("bench");
+        details->set_stock_symbol("BENCH");
+        details->set_price(price);
+        details->set_quantity(10);
+        details->set_is_buy_order(is_buy);
+        return request;
+    }
+
+    order_service::CancelRequest makeCancel(const std::string& order_id) {
+        order_service::CancelRequest request;
+        request.set_order_id(order_id);
+        request.set_is_buy_order(false);
+        return request;
+    }
+
+    double percentile(std::vector<double>& values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+
+    double micros(Clock::duration elapsed) {
+        return std::chrono::duration<double, std::micro>(elapsed).count();
+    }
+
+    // One resting book, shared by every run at its size. Runs leave it as
+    // they found it, so it is filled once.
+    class BenchServer {
+    public:
+        explicit BenchServer(int book_size)
+            : server_(std::make_shared<OrderClientServer>())
+        {
+            server_->setLockWaitListener([this](std::chrono::nanoseconds waited) {
+                lock_waits_.nanos.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
+                lock_waits_.count.fetch_add(1, std::memory_order_relaxed);
+            });
+            for (int i = 0; i < book_size; ++i) {
+                server_->submitOrder(makeOrder("rest_" + std::to_string(i), 50.0 + (i % 5000) * 0.01, true));
+            }
+
+            in_process_ = std::make_unique<InProcessServer>(InProcessServerOptions{.orders = server_});
+            channel_ = in_process_->channel();
+        }
+
+        Results run(bool use_grpc, int threads, double seconds) {
+            lock_waits_.nanos = 0;
+            lock_waits_.count = 0;
+            std::mutex results_mutex;
+            Results results;
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(seconds));
+
+            auto started = Clock::now();
+            std::vector<std::thread> clients;
+            for (int t = 0; t < threads; ++t) {
+                clients.emplace_back([&, t] {
+                    Results local;
+                    auto stub = use_grpc ? order_service::OrderService::NewStub(channel_) : nullptr;
+                    for (int i = 0; Clock::now() < deadline; ++i) {
+                        std::string order_id = "c" + std::to_string(t) + "_" + std::to_string(i);
+                        auto order = makeOrder(order_id, 200.0 + t * 0.01, false);
+                        auto cancel = makeCancel(order_id);
+
+                        auto start = Clock::now();
+                        bool ok = submit(stub.get(), order);
+                        auto submitted = Clock::now();
+                        ok = cancelOrder(stub.get(), cancel) && ok;
+                        auto cancelled = Clock::now();
+
+                        local.submit_latencies_us.push_back(micros(submitted - start));
+                        local.cancel_latencies_us.push_back(micros(cancelled - submitted));
+                        local.failed += ok ? 0 : 1;
+                    }
+                    std::lock_guard<std::mutex> lock(results_mutex);
+                    results.submit_latencies_us.insert(results.submit_latencies_us.end(),
+                                                       local.submit_latencies_us.begin(),
+                                                       local.submit_latencies_us.end());
+                    results.cancel_latencies_us.insert(results.cancel_latencies_us.end(),
+                                                       local.cancel_latencies_us.begin(),
+                                                       local.cancel_latencies_us.end());
+                    results.failed += local.failed;
+                });
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+            results.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+            results.lock_wait_total_us = static_cast<double>(lock_waits_.nanos.load()) / 1000.0;
+            results.lock_waits = lock_waits_.count.load();
+            return results;
+        }
+
+    private:
+        std::shared_ptr<OrderClientServer> server_;
+        std::unique_ptr<InProcessServer> in_process_;
+        std::shared_ptr<grpc::Channel> channel_;
+        LockWaitTotals lock_waits_;
+
+        bool submit(order_service::OrderService::Stub* stub, const order_service::OrderRequest& order) {
+            if (!stub) {
+                return server_->submitOrder(order).status() == order_service::OrderStatus::SUCCESS;
+            }
+            order_service::OrderResponse response;
+            grpc::ClientContext context;
+            return stub->SubmitOrder(&context, order, &response).ok() &&
+                   response.status() == order_service::OrderStatus::SUCCESS;
+        }
+
+        bool cancelOrder(order_service::OrderService::Stub* stub, const order_service::CancelRequest& cancel) {
+            if (!stub) {
+                return server_->cancelOrder(cancel).status() == order_service::OrderStatus::CANCELLED;
+            }
+            order_service::CancelResponse response;
+            grpc::ClientContext context;
+            return stub->CancelOrder(&context, cancel, &response).ok() &&
+                   response.status() == order_service::OrderStatus::CANCELLED;
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+    int max_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+    int max_book = argc > 3 ? std::atoi(argv[3]) : 1'000'000;
+    const char* json_path = argc > 4 ? argv[4] : nullptr;
+    spdlog::set_level(spdlog::level::off);
+
+    std::FILE* json = nullptr;
+    if (json_path) {
+        json = std::fopen(json_path, "w");
+        if (!json) {
+            std::fprintf(stderr, "cannot open %s\n", json_path);
+            return 1;
+        }
+        std::fprintf(json, "[");
+    }
+
+    std::printf("%.1f s per run; each op submits a resting sell and cancels it\n", seconds);
+    std::printf("%-6s %8s %7s %10s %10s %10s %10s %10s %10s %9s %9s\n", "mode", "book", "threads", "ops/s",
+                "submit p50", "p99", "p99.9", "cancel p50", "p99", "ns/nlogn", "lock wait");
+    bool first_row = true;
+    for (int book = 10; book <= max_book; book *= 10) {
+        BenchServer bench(book);
+        for (bool use_grpc : {false, true}) {
+            for (int threads = 1; threads <= max_threads; threads *= 2) {
+                Results results = bench.run(use_grpc, threads, seconds);
+                auto& submits = results.submit_latencies_us;
+                auto& cancels = results.cancel_latencies_us;
+                double ops_per_second = static_cast<double>(submits.size()) / results.seconds;
+                double submit_p50 = percentile(submits, 0.50);
+                double submit_p99 = percentile(submits, 0.99);
+                double submit_p999 = percentile(submits, 0.999);
+                double cancel_p50 = percentile(cancels, 0.50);
+                double cancel_p99 = percentile(cancels, 0.99);
+                double nlogn = static_cast<double>(book) * std::log2(static_cast<double>(book));
+                double ns_per_nlogn = submit_p50 * 1000.0 / nlogn;
+                // Share of the clients' time spent queued on the order lock
+                double lock_share = 100.0 * results.lock_wait_total_us / (results.seconds * 1e6 * threads);
+                const char* mode = use_grpc ? "grpc" : "direct";
+
+                std::printf("%-6s %8d %7d %10.0f %7.1f us %7.1f us %7.1f us %7.1f us %7.1f us %9.3f %8.1f%%\n",
+                            mode, book, threads, ops_per_second, submit_p50, submit_p99, submit_p999,
+                            cancel_p50, cancel_p99, ns_per_nlogn, lock_share);
+                if (results.failed > 0) {
+                    std::printf("       %llu operations failed\n", static_cast<unsigned long long>(results.failed));
+                }
+                if (json) {
+                    std::fprintf(json,
+                                 "%s\n  {\"mode\": \"%s\", \"book\": %d, \"threads\": %d, \"ops_per_second\": %.1f, "
+                                 "\"submit_p50_us\": %.3f, \"submit_p99_us\": %.3f, \"submit_p999_us\": %.3f, "
+                                 "\"cancel_p50_us\": %.3f, \"cancel_p99_us\": %.3f, \"ns_per_nlogn\": %.5f, "
+                                 "\"lock_wait_share_pct\": %.2f, \"failed\": %llu}",
+                                 first_row ? "" : ",", mode, book, threads, ops_per_second, submit_p50, submit_p99,
+                                 submit_p999, cancel_p50, cancel_p99, ns_per_nlogn, lock_share,
+                                 static_cast<unsigned long long>(results.failed));
+                    first_row = false;
+                }
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (json) {
+        std::fprintf(json, "\n]\n");
+        std::fclose(json);
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// benchmarks/transport_benchmark.cpp
+//
+// Latency and throughput of the same server reached over the three
+// transports AsyncOrderClient supports: loopback TCP, a unix socket, and
+// an in-process channel. One server listens on 127.0.0.1 (on a free port)
+// and on a unix socket, and is also called in process, so the transports
+// differ only in how the bytes travel.
+//
+// Each transport runs two loads of submit-then-cancel pairs, so the book
+// stays empty:
+//   - one call at a time, for the round-trip latency of a single RPC;
+//   - batches of `window` submits then `window` cancels, for throughput
+//     with many calls in flight.
+//
+// Usage: transport_benchmark [seconds] [window] [channels]
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "async_order_client.hpp"
+#include "in_process_server.hpp"
+#include "latency_histogram.hpp"
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Results {
+        LatencyHistogram submit;
+        LatencyHistogram cancel;
+        double pipelined_ops_per_second = 0.0;
+        uint64_t failed = 0;
+    };
+
+    order_service::OrderDetails makeOrder(const std::string& order_id) {
+        order_service::OrderDetails details;
+        details.set_order_id(order_id);
+        details.set_trader_id("bench");
+        details.set_stock_symbol("BENCH");
+        details.set_price(100.0);
+        details.set_quantity(10);
+        details.set_is_buy_order(true);
+        return details;
+    }
+
+    order_service::CancelRequest makeCancel(const std::string& order_id) {
+        order_service::CancelRequest request;
+        request.set_order_id(order_id);
+        request.set_is_buy_order(true);
+        request.set_trader_id("bench");
+        return request;
+    }
+
+    double micros(uint64_t nanos) {
+        return static_cast<double>(nanos) / 1000.0;
+    }
+
+    Results run(AsyncOrderClient& client, const std::string& prefix, double seconds, size_t window) {
+        Results results;
+        auto duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+
+        // Warm the connections and the call pools
+        for (int i = 0; i < 200; ++i) {
+            std::string order_id = prefix + "w" + std::to_string(i);
+            client.submitOrder(makeOrder(order_id)).get();
+            client.cancelOrder(makeCancel(order_id)).get();
+        }
+
+        auto deadline = Clock::now() + duration;
+        for (uint64_t i = 0; Clock::now() < deadline; ++i) {
+            std::string order_id = prefix + "s" + std::to_string(i);
+            auto start = Clock::now();
+            auto submitted = client.submitOrder(makeOrder(order_id)).get();
+            auto middle = Clock::now();
+            auto cancelled = client.cancelOrder(makeCancel(order_id)).get();
+            auto end = Clock::now();
+            results.submit.record(middle - start);
+            results.cancel.record(end - middle);
+            results.failed += submitted.ok() && cancelled.ok() ? 0 : 1;
+        }
+
+        std::vector<order_service::OrderDetails> orders(window);
+        std::vector<order_service::CancelRequest> cancels(window);
+        uint64_t operations = 0;
+        auto started = Clock::now();
+        deadline = started + duration;
+        for (uint64_t batch = 0; Clock::now() < deadline; ++batch) {
+            for (size_t i = 0; i < window; ++i) {
+                std::string order_id = prefix + "p" + std::to_string(batch) + "_" + std::to_string(i);
+                orders[i] = makeOrder(order_id);
+                cancels[i] = makeCancel(order_id);
+            }
+            for (const auto& result : client.submitOrders(orders).get()) {
+                results.failed += result.ok() ? 0 : 1;
+            }
+            for (const auto& result : client.cancelOrders(cancels).get()) {
+                results.failed += result.ok() ? 0 : 1;
+            }
+            operations += window;
+        }
+        results.pipelined_ops_per_second =
+            static_cast<double>(operations) / std::chrono::duration<double>(Clock::now() - started).count();
+        return results;
+    }
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    size_t window = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 256;
+    size_t channels = argc > 3 ? static_cast<size_t>(std::atol(argv[3])) : 1;
+    spdlog::set_level(spdlog::level::off);
+
+    std::string socket_path = (std::filesystem::temp_directory_path() /
+                               ("transport_benchmark_" + std::to_string(::getpid()) + ".sock")).string();
+    InProcessServer server({.unix_socket_path = socket_path, .listen_tcp = true});
+
+    std::printf("%.1f s per load; an op is a submit and its cancel; %zu channel(s), window %zu\n",
+                seconds, channels, window);
+    std::printf("%-10s %10s %10s %10s %10s %10s %10s %12s\n", "transport", "submit p50", "p99", "p99.9", "max",
+                "cancel p50", "p99", "pipelined/s");
+
+    const std::pair<OrderTransport, const char*> transports[] = {
+        {OrderTransport::Tcp, "tcp"},
+        {OrderTransport::UnixSocket, "unix"},
+        {OrderTransport::InProcess, "inprocess"},
+    };
+    for (const auto& [transport, name] : transports) {
+        AsyncOrderClient client(server.clientConfig(channels, transport));
+        Results results = run(client, name, seconds, window);
+        std::printf("%-10s %7.1f us %7.1f us %7.1f us %7.1f us %7.1f us %7.1f us %12.0f\n", name,
+                    micros(results.submit.valueAtPercentile(50.0)), micros(results.submit.valueAtPercentile(99.0)),
+                    micros(results.submit.valueAtPercentile(99.9)), micros(results.submit.max()),
+                    micros(results.cancel.valueAtPercentile(50.0)), micros(results.cancel.valueAtPercentile(99.0)),
+                    results.pipelined_ops_per_second);
+        if (results.failed > 0) {
+            std::printf("           %llu calls failed\n", static_cast<unsigned long long>(results.failed));
+        }
+        std::fflush(stdout);
+    }
+    return 0;
+}
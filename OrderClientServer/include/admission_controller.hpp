@@ -0,0 +1,86 @@
+// include/admission_controller.hpp
+#ifndef ADMISSION_CONTROLLER_HPP
+#define ADMISSION_CONTROLLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Shedding order: queries go first, then new orders; cancels reduce risk and
+// are only refused once even their reserved budget is exhausted.
+enum class RequestPriority { Cancel, Order, Query };
+
+struct AdmissionConfig {
+    size_t max_in_flight = 64;                        // Budget shared by orders and cancels
+    size_t cancel_reserve = 16;                       // Extra slots only cancels may use
+    size_t max_queries_in_flight = 16;                // Queries are admitted below this total
+    std::chrono::microseconds target_delay{2000};     // Acceptable standing queueing delay
+    std::chrono::milliseconds interval{100};          // How long the delay must stand
+    std::chrono::milliseconds retry_after{20};        // Hint when only the budget is full
+};
+
+// Admission control for the unary request path, in two parts:
+//  - an in-flight budget per priority, checked on every request;
+//  - a CoDel-style delay detector fed with the time admitted requests wait
+//    for the order lock. If the smallest delay seen in a whole interval is
+//    above target, a queue is standing rather than absorbing a burst, and
+//    orders and queries are shed until an interval passes below target.
+// Everything is atomics; no lock is taken on the request path.
+class AdmissionController {
+public:
+    // An admission decision. Admitted tickets hold an in-flight slot until
+    // destroyed; a default-constructed ticket is admitted without a budget.
+    class Ticket {
+    public:
+        Ticket() = default;
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+        ~Ticket();
+
+        explicit operator bool() const noexcept { return admitted_; }
+        // How long a rejected client should wait before retrying
+        [[nodiscard]] std::chrono::milliseconds retryAfter() const noexcept { return retry_after_; }
+
+    private:
+        friend class AdmissionController;
+        Ticket(AdmissionController* owner, bool admitted, std::chrono::milliseconds retry_after)
+            : owner_(owner), admitted_(admitted), retry_after_(retry_after) {}
+
+        AdmissionController* owner_{nullptr};
+        bool admitted_{true};
+        std::chrono::milliseconds retry_after_{0};
+    };
+
+    explicit AdmissionController(AdmissionConfig config = {});
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    Ticket tryAdmit(RequestPriority priority);
+
+    // Queueing delay experienced by an admitted request
+    void observeQueueDelay(std::chrono::nanoseconds delay);
+
+    [[nodiscard]] const AdmissionConfig& config() const noexcept { return config_; }
+    [[nodiscard]] bool overloaded() const noexcept { return overloaded_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t inFlight() const noexcept { return in_flight_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    static int64_t nowNanos() noexcept;
+    void rollWindow(int64_t now);
+    Ticket reject(std::chrono::milliseconds retry_after);
+    void release() noexcept;
+
+    const AdmissionConfig config_;
+
+    std::atomic<size_t> in_flight_{0};
+    std::atomic<uint64_t> rejected_{0};
+
+    std::atomic<bool> overloaded_{false};
+    std::atomic<int64_t> window_end_;
+    std::atomic<int64_t> window_min_;
+};
+
+#endif // ADMISSION_CONTROLLER_HPP
@@ -0,0 +1,43 @@
+// include/arena_message_allocator.hpp
+#ifndef ARENA_MESSAGE_ALLOCATOR_HPP
+#define ARENA_MESSAGE_ALLOCATOR_HPP
+
+#include <google/protobuf/arena.h>
+#include <grpcpp/support/message_allocator.h>
+#include <cstddef>
+
+// Allocates the request and response of each unary callback RPC on a protobuf
+// Arena owned by the call. The arena starts in a block embedded in the
+// holder, so a small call costs a single heap allocation, and everything the
+// handler builds into the response is released at once when the call ends.
+template <typename Request, typename Response, size_t InitialBlockSize = 1024>
+class ArenaMessageAllocator : public grpc::MessageAllocator<Request, Response> {
+public:
+    grpc::MessageHolder<Request, Response>* AllocateMessages() override {
+        return new Holder();
+    }
+
+private:
+    class Holder : public grpc::MessageHolder<Request, Response> {
+    public:
+        Holder() : arena_(arenaOptions(initial_block_)) {
+            this->set_request(google::protobuf::Arena::CreateMessage<Request>(&arena_));
+            this->set_response(google::protobuf::Arena::CreateMessage<Response>(&arena_));
+        }
+
+        void Release() override { delete this; }
+
+    private:
+        static google::protobuf::ArenaOptions arenaOptions(char* initial_block) {
+            google::protobuf::ArenaOptions options;
+            options.initial_block = initial_block;
+            options.initial_block_size = InitialBlockSize;
+            return options;
+        }
+
+        alignas(std::max_align_t) char initial_block_[InitialBlockSize];
+        google::protobuf::Arena arena_;
+    };
+};
+
+#endif // ARENA_MESSAGE_ALLOCATOR_HPP
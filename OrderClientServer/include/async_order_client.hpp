@@ -0,0 +1,176 @@
+// include/async_order_client.hpp
+#ifndef ASYNC_ORDER_CLIENT_HPP
+#define ASYNC_ORDER_CLIENT_HPP
+
+#include "order_service.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class OrderTransport {
+    Tcp,         // target, host:port
+    UnixSocket,  // unix_socket_path, for a server on the same machine
+    InProcess,   // in_process_server, a server embedded in this process
+};
+
+struct OrderClientConfig {
+    OrderTransport transport = OrderTransport::Tcp;
+    std::string target = "localhost:50051";
+    std::string unix_socket_path;
+    // Not owned; must outlive the client
+    grpc::Server* in_process_server = nullptr;
+    // Connections opened to the server. Calls are spread over them round
+    // robin, so no single HTTP/2 connection hits its concurrent stream limit.
+    size_t channels = 4;
+    // 0 connects lazily on the first call instead of waiting in the
+    // constructor
+    std::chrono::milliseconds connect_timeout{0};
+    std::chrono::milliseconds call_timeout{10000};
+    // Finished calls kept for reuse, per RPC
+    size_t pooled_calls = 1024;
+
+    // The gRPC target string of a Tcp or UnixSocket config
+    [[nodiscard]] std::string channelTarget() const;
+
+    // SERVER_SOCKET selects a unix socket; otherwise SERVER_HOST and
+    // SERVER_PORT (default 50051) name a TCP server, localhost by default
+    static OrderClientConfig fromEnvironment();
+};
+
+// Non-blocking client for the unary OrderService RPCs. Every call returns
+// at once and completes either through a callback or a future.
+//
+// Each channel has its own completion queue and thread, which runs the
+// callbacks, so callbacks should be short and must not destroy the
+// client. Calls are pooled: a finished call's request and response
+// messages are cleared and reused by a later call rather than freed.
+//
+// Callbacks may start further calls. Once the destructor has waited for
+// pending amends, new calls are refused: their callback runs at once, on
+// the calling thread, with CANCELLED.
+//
+// The streaming RPCs are not wrapped; open them on channel().
+class AsyncOrderClient {
+public:
+    template<typename Response>
+    using Callback = std::function<void(const grpc::Status& status, Response& response)>;
+
+    template<typename Response>
+    struct Result {
+        grpc::Status status;
+        Response response;
+
+        [[nodiscard]] bool ok() const noexcept { return status.ok(); }
+    };
+
+    // The protocol has no amend RPC, so an amend is a cancel followed, once
+    // the cancel is answered CANCELLED, by the submit of the replacement
+    struct AmendResult {
+        grpc::Status status;  // Of the last call made
+        order_service::CancelResponse cancel;
+        // The cancel succeeded and the replacement was sent; its answer is
+        // in replacement when status is OK
+        bool replaced = false;
+        order_service::OrderResponse replacement;
+
+        [[nodiscard]] bool ok() const noexcept { return status.ok(); }
+    };
+    using AmendCallback = std::function<void(AmendResult& result)>;
+
+    using ChannelFactory = std::function<std::shared_ptr<grpc::Channel>(size_t index)>;
+
+    // Throws std::invalid_argument for a config without channels or
+    // without the address its transport needs, and std::runtime_error if
+    // connect_timeout passes before every channel connects
+    explicit AsyncOrderClient(OrderClientConfig config);
+    // Takes the channels from the factory instead of opening them from the
+    // config's transport
+    AsyncOrderClient(OrderClientConfig config, ChannelFactory channels);
+    // Waits for calls still in flight, amends included, which the call
+    // timeout bounds
+    ~AsyncOrderClient();
+
+    AsyncOrderClient(const AsyncOrderClient&) = delete;
+    AsyncOrderClient& operator=(const AsyncOrderClient&) = delete;
+
+    void submitOrder(const order_service::OrderDetails& details, Callback<order_service::OrderResponse> done);
+    void cancelOrder(const order_service::CancelRequest& request, Callback<order_service::CancelResponse> done);
+    void getOrderStatus(const std::string& order_id, Callback<order_service::OrderStatusResponse> done);
+    void viewOrderBook(const std::string& symbol, Callback<order_service::ViewOrderBookResponse> done);
+    void amendOrder(const order_service::CancelRequest& cancel, const order_service::OrderDetails& replacement,
+                    AmendCallback done);
+
+    std::future<Result<order_service::OrderResponse>> submitOrder(const order_service::OrderDetails& details);
+    std::future<Result<order_service::CancelResponse>> cancelOrder(const order_service::CancelRequest& request);
+    std::future<Result<order_service::OrderStatusResponse>> getOrderStatus(const std::string& order_id);
+    std::future<Result<order_service::ViewOrderBookResponse>> viewOrderBook(const std::string& symbol);
+    std::future<AmendResult> amendOrder(const order_service::CancelRequest& cancel,
+                                        const order_service::OrderDetails& replacement);
+
+    // Sends every entry at once; the future is ready when the last is
+    // answered, with the results in input order
+    std::future<std::vector<Result<order_service::OrderResponse>>> submitOrders(
+        std::span<const order_service::OrderDetails> orders);
+    std::future<std::vector<Result<order_service::CancelResponse>>> cancelOrders(
+        std::span<const order_service::CancelRequest> requests);
+
+    // Blocks until every channel is connected or the timeout passes.
+    // In-process channels are always connected.
+    bool waitForConnected(std::chrono::milliseconds timeout);
+
+    [[nodiscard]] size_t channelCount() const noexcept { return connections_.size(); }
+    [[nodiscard]] std::shared_ptr<grpc::Channel> channel(size_t index = 0) const {
+        return connections_.at(index)->channel;
+    }
+    [[nodiscard]] size_t inFlight() const noexcept { return in_flight_.load(std::memory_order_relaxed); }
+    [[nodiscard]] const OrderClientConfig& config() const noexcept { return config_; }
+
+private:
+    struct Connection {
+        std::shared_ptr<grpc::Channel> channel;
+        std::unique_ptr<order_service::OrderService::Stub> stub;
+        grpc::CompletionQueue cq;
+        std::thread completions;
+    };
+
+    // Defined in the source file; the completion queue tag is a CallBase*
+    struct CallBase;
+    template<typename Request, typename Response>
+    struct Call;
+    template<typename Request, typename Response>
+    class CallPool;
+
+    OrderClientConfig config_;
+    std::vector<std::unique_ptr<Connection>> connections_;
+    std::atomic<size_t> next_connection_{0};
+    std::atomic<size_t> in_flight_{0};
+    // Amends whose callback has not run; between its two calls an amend
+    // has none in flight
+    std::atomic<size_t> amends_in_flight_{0};
+    // Set by the destructor before the queues shut down. start() counts
+    // itself in starting_ before reading closing_, so the destructor either
+    // waits for a call to reach its queue or the call sees closing_.
+    std::atomic<bool> closing_{false};
+    std::atomic<size_t> starting_{0};
+    std::unique_ptr<CallPool<order_service::OrderRequest, order_service::OrderResponse>> submit_calls_;
+    std::unique_ptr<CallPool<order_service::CancelRequest, order_service::CancelResponse>> cancel_calls_;
+    std::unique_ptr<CallPool<order_service::OrderStatusRequest, order_service::OrderStatusResponse>> status_calls_;
+    std::unique_ptr<CallPool<order_service::ViewOrderBookRequest, order_service::ViewOrderBookResponse>> view_calls_;
+
+    Connection& nextConnection() noexcept;
+    void drain(Connection& connection);
+    // Takes a call from the pool, lets fill set its request and sends it
+    // on the next connection
+    template<typename Request, typename Response, typename Prepare, typename Fill>
+    void start(CallPool<Request, Response>& pool, Prepare prepare, const Fill& fill, Callback<Response> done);
+};
+
+#endif // ASYNC_ORDER_CLIENT_HPP
@@ -0,0 +1,90 @@
+// include/bounded_mpsc_queue.hpp
+#ifndef BOUNDED_MPSC_QUEUE_HPP
+#define BOUNDED_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Fixed-capacity lock-free queue for many producers and one consumer
+// (Vyukov's bounded queue). Producers never block: tryPush() fails when the
+// queue is full and the caller decides what to drop. T must be trivially
+// copyable so cells can be reused without construction.
+template <typename T>
+class BoundedMpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "BoundedMpscQueue holds trivially copyable records");
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit BoundedMpscQueue(size_t capacity)
+        : capacity_(roundUpToPowerOfTwo(capacity))
+        , mask_(capacity_ - 1)
+        , cells_(std::make_unique<Cell[]>(capacity_)) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    bool tryPush(const T& value) noexcept {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // Full
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer side; must only be called from one thread at a time
+    bool tryPop(T& value) noexcept {
+        Cell& cell = cells_[head_ & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(head_ + 1) < 0) {
+            return false;  // Empty
+        }
+        value = cell.value;
+        cell.sequence.store(head_ + capacity_, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // Producers and the consumer work on separate cache lines
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) size_t head_{0};
+};
+
+#endif // BOUNDED_MPSC_QUEUE_HPP
@@ -0,0 +1,75 @@
+// include/execution_report_hub.hpp
+#ifndef EXECUTION_REPORT_HUB_HPP
+#define EXECUTION_REPORT_HUB_HPP
+
+#include "order_service.pb.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bounded per-subscriber queue of execution reports. Unlike book updates,
+// reports cannot be conflated: a subscriber that falls max_queued reports
+// behind is marked overflowed and stops receiving, so the stream can be ended
+// and the client told to reconcile instead of silently missing a fill.
+class ExecutionSubscription {
+public:
+    ExecutionSubscription(std::string trader_id, size_t max_queued, std::function<void()> on_ready);
+
+    [[nodiscard]] const std::string& traderId() const noexcept { return trader_id_; }
+
+    // Returns false once the subscription has overflowed
+    bool push(const order_service::ExecutionReport& report);
+    std::optional<order_service::ExecutionReport> pop();
+
+    [[nodiscard]] size_t pending() const;
+    [[nodiscard]] bool overflowed() const noexcept { return overflowed_.load(std::memory_order_acquire); }
+
+private:
+    friend class ExecutionReportHub;
+
+    const std::string trader_id_;
+    const size_t max_queued_;
+    // Guarded by the hub's wake mutex so it never runs after unsubscribe()
+    // returns
+    std::function<void()> on_ready_;
+    bool wake_pending_ = false;  // Guarded by the hub's mutex
+
+    mutable std::mutex mutex_;
+    std::deque<order_service::ExecutionReport> queue_;
+    std::atomic<bool> overflowed_{false};
+};
+
+// Routes execution reports from the matcher to the streams of the trader that
+// owns each order. publish() only queues, so it is cheap enough to run under
+// the order lock; deliver() then wakes the streams outside it.
+class ExecutionReportHub {
+public:
+    static constexpr size_t kDefaultQueueDepth = 4096;
+
+    std::shared_ptr<ExecutionSubscription> subscribe(const std::string& trader_id,
+                                                     std::function<void()> on_ready,
+                                                     size_t max_queued = kDefaultQueueDepth);
+    void unsubscribe(const std::shared_ptr<ExecutionSubscription>& subscription);
+
+    // Queues the report for its trader's subscriptions and marks them ready
+    void publish(const order_service::ExecutionReport& report);
+    // Runs on_ready for every subscription marked ready since the last call
+    void deliver();
+
+    [[nodiscard]] bool hasSubscribers(const std::string& trader_id) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<ExecutionSubscription>>> subscribers_;
+    std::vector<std::shared_ptr<ExecutionSubscription>> ready_;  // Guarded by mutex_
+    // Held while on_ready runs, so it is never taken under mutex_
+    std::mutex wake_mutex_;
+};
+
+#endif // EXECUTION_REPORT_HUB_HPP
@@ -0,0 +1,118 @@
+// include/lane_scheduler.hpp
+#ifndef LANE_SCHEDULER_HPP
+#define LANE_SCHEDULER_HPP
+
+#include "admission_controller.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Defaults for a scheduler in use. ServerConfig leaves lanes off by setting
+// order_entry_workers to 0, which makes the server run handlers inline
+// without building a scheduler; a LaneScheduler itself starts at least one
+// worker per lane.
+struct LaneConfig {
+    size_t order_entry_workers = 2;   // Serve cancels, then orders; at least 1
+    size_t query_workers = 1;         // At least 1; paced queries still run one at a time
+    double query_share = 0.25;        // Fraction of one core query work may use
+    size_t max_queued = 4096;         // Per lane; a full lane refuses new work
+};
+
+// Move-only type-erased unit of work. Tasks carry their admission ticket, so
+// std::function (which needs copyable callables) cannot hold them.
+class LaneTask {
+public:
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, LaneTask>>>
+    LaneTask(F&& function) : impl_(std::make_unique<Model<std::decay_t<F>>>(std::forward<F>(function))) {}
+
+    LaneTask(LaneTask&&) noexcept = default;
+    LaneTask& operator=(LaneTask&&) noexcept = default;
+
+    void operator()() { impl_->run(); }
+
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct Model final : Concept {
+        template <typename G>
+        explicit Model(G&& g) : function(std::forward<G>(g)) {}
+        void run() override { function(); }
+        F function;
+    };
+
+    std::unique_ptr<Concept> impl_;
+};
+
+// Runs request handlers on dedicated worker pools, one queue per
+// RequestPriority.
+//
+// Order-entry workers always take a queued cancel before a queued order, so
+// cancels overtake order bursts. Queries have their own pool and never run on
+// an order-entry worker. They are also paced: once a query has run for d, the
+// next one may not start until d / query_share later. Book views therefore
+// use at most query_share of a core however many dashboards are polling, and
+// order entry never waits behind a queue of them.
+class LaneScheduler {
+public:
+    // Time a task spent queued before a worker picked it up
+    using QueueDelayListener = std::function<void(RequestPriority lane, std::chrono::nanoseconds delay)>;
+
+    explicit LaneScheduler(LaneConfig config = {});
+    // Runs every queued task before the workers exit
+    ~LaneScheduler();
+
+    LaneScheduler(const LaneScheduler&) = delete;
+    LaneScheduler& operator=(const LaneScheduler&) = delete;
+
+    // Must be set before start()
+    void setQueueDelayListener(QueueDelayListener listener);
+    void start();
+    void stop();
+
+    // Returns false, without running the task, when the lane is full or the
+    // scheduler is stopped
+    bool submit(RequestPriority lane, LaneTask task);
+
+    [[nodiscard]] size_t queued(RequestPriority lane) const;
+    [[nodiscard]] const LaneConfig& config() const noexcept { return config_; }
+
+private:
+    struct Entry {
+        LaneTask task;
+        int64_t enqueued_ns;
+    };
+
+    static int64_t nowNanos() noexcept;
+    std::deque<Entry>& queue(RequestPriority lane) { return queues_[static_cast<size_t>(lane)]; }
+    void orderEntryWorker();
+    void queryWorker();
+    void run(RequestPriority lane, Entry& entry);
+
+    const LaneConfig config_;
+    QueueDelayListener queue_delay_listener_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable order_entry_ready_;
+    std::condition_variable query_ready_;
+    std::deque<Entry> queues_[3];
+    int64_t query_not_before_ns_{0};  // Pacing for the query pool
+    bool paced_query_running_{false};
+    bool running_{false};
+
+    std::vector<std::thread> workers_;
+};
+
+#endif // LANE_SCHEDULER_HPP
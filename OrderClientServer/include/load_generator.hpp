@@ -0,0 +1,103 @@
+// include/load_generator.hpp
+#ifndef LOAD_GENERATOR_HPP
+#define LOAD_GENERATOR_HPP
+
+#include "latency_histogram.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace grpc {
+    class Channel;
+}
+
+enum class LoadRpc : uint8_t {
+    New,     // SubmitOrder of a resting order
+    Cancel,  // CancelOrder of one of the client's resting orders
+    Amend,   // Cancel/replace: CancelOrder, then SubmitOrder at a new price
+};
+inline constexpr size_t kLoadRpcCount = 3;
+
+const char* loadRpcName(LoadRpc rpc) noexcept;
+
+// Open-loop load against an OrderServer. Each client sends at
+// rate_per_second / clients on a fixed schedule, whatever the server's
+// response times.
+struct LoadConfig {
+    std::string target = "localhost:50051";
+    int clients = 4;
+    double rate_per_second = 10000.0;  // Across all clients
+    double seconds = 10.0;
+    // Relative weights of the operation mix. Cancels and amends fall back
+    // to new orders while a client has nothing resting.
+    std::array<uint32_t, kLoadRpcCount> mix = {60, 30, 10};
+    std::string symbol = "BENCH";
+    // Orders rest within price_levels ticks behind a mid of mid_price, so
+    // the load never crosses and every order stays cancellable
+    double mid_price = 100.0;
+    int price_levels = 50;
+    uint64_t seed = 1;
+    // Timeout of every call, which bounds the wait for outstanding calls
+    // after the last send
+    std::chrono::milliseconds drain_timeout{5000};
+
+    // Parses a mix written as new:cancel:amend, e.g. "60:30:10".
+    // Throws std::invalid_argument on malformed input.
+    static std::array<uint32_t, kLoadRpcCount> parseMix(const std::string& text);
+};
+
+struct LoadRpcStats {
+    uint64_t sent = 0;
+    uint64_t ok = 0;        // Order resting, or cancel/amend applied
+    uint64_t rejected = 0;  // Answered, but not applied
+    uint64_t shed = 0;      // RESOURCE_EXHAUSTED from the server's admission control
+    uint64_t failed = 0;    // Any other non-OK gRPC status, including timeouts
+    // Answered calls, timed from when the schedule said to send them
+    LatencyHistogram latency;
+};
+
+struct LoadReport {
+    std::array<LoadRpcStats, kLoadRpcCount> rpcs;
+    // From the first scheduled send until the last send went out, which is
+    // longer than LoadConfig::seconds when the generator fell behind
+    double send_seconds = 0.0;
+    // How far behind schedule each send went out; large values mean the
+    // generator, not the server, limited the rate
+    LatencyHistogram send_lag;
+
+    [[nodiscard]] const LoadRpcStats& stats(LoadRpc rpc) const noexcept { return rpcs[static_cast<size_t>(rpc)]; }
+    [[nodiscard]] uint64_t sent() const noexcept;
+    [[nodiscard]] uint64_t answered() const noexcept;
+};
+
+// Runs LoadConfig against a server, each client an AsyncOrderClient on one
+// channel with its own sending thread.
+//
+// Latency is measured from each call's intended send time rather than the
+// moment it was actually sent. A stalled server therefore cannot hide
+// the requests that queued up behind the stall, which is the
+// coordinated-omission correction an open-loop load needs.
+class LoadGenerator {
+public:
+    using ChannelFactory = std::function<std::shared_ptr<grpc::Channel>(int client)>;
+
+    // Throws std::invalid_argument for a config that cannot run
+    explicit LoadGenerator(LoadConfig config);
+    // Clients take their channels from the factory instead of dialling
+    // config.target, e.g. for an in-process server; a null factory dials
+    LoadGenerator(LoadConfig config, ChannelFactory channels);
+
+    LoadReport run();
+
+    [[nodiscard]] const LoadConfig& config() const noexcept { return config_; }
+
+private:
+    LoadConfig config_;
+    ChannelFactory channels_;
+};
+
+#endif // LOAD_GENERATOR_HPP
@@ -0,0 +1,37 @@
+// include/mapped_file.hpp
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory map of a whole file. Meant for front-to-back reading:
+// the kernel is told to read ahead, and release() hands back pages the
+// reader has finished with, so resident memory stays flat however large
+// the file is.
+class MappedFile {
+public:
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view data() const noexcept { return {data_, size_}; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+    // Drops the pages wholly before offset from memory. They are re-read
+    // from the file if touched again.
+    void release(size_t offset) noexcept;
+
+private:
+    std::string path_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t released_ = 0;
+};
+
+#endif // MAPPED_FILE_HPP
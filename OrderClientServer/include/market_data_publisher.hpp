@@ -0,0 +1,105 @@
+// include/market_data_publisher.hpp
+#ifndef MARKET_DATA_PUBLISHER_HPP
+#define MARKET_DATA_PUBLISHER_HPP
+
+#include "order_client_server.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A serialized ViewOrderBookResponse, shared by every subscriber of a symbol
+using SerializedBookUpdate = std::shared_ptr<const std::string>;
+
+// Bounded per-subscriber queue. Every update carries the full latest state of
+// the book, so when a slow consumer falls behind the oldest pending updates
+// are dropped instead of blocking the publisher or growing without bound.
+class BookSubscription {
+public:
+    BookSubscription(std::string symbol, size_t max_queued, std::function<void()> on_ready);
+
+    [[nodiscard]] const std::string& symbol() const noexcept { return symbol_; }
+
+    void push(SerializedBookUpdate update);
+    // Returns nullptr when nothing is pending
+    SerializedBookUpdate pop();
+
+    [[nodiscard]] size_t pending() const;
+    [[nodiscard]] uint64_t conflated() const noexcept { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    friend class MarketDataPublisher;
+
+    const std::string symbol_;
+    const size_t max_queued_;
+    // Invoked by the publisher after a push; guarded by the publisher's mutex
+    // so it can never run after unsubscribe() has returned
+    std::function<void()> on_ready_;
+
+    mutable std::mutex mutex_;
+    std::deque<SerializedBookUpdate> queue_;
+    std::atomic<uint64_t> conflated_{0};
+};
+
+// Builds and serializes each book update exactly once per symbol and fans the
+// shared buffer out to every subscriber of that symbol. An empty symbol is the
+// all-symbols topic, matching ViewOrderBookRequest semantics.
+class MarketDataPublisher {
+public:
+    static constexpr size_t kDefaultQueueDepth = 8;
+
+    explicit MarketDataPublisher(std::shared_ptr<OrderClientServer> server,
+                                 std::chrono::milliseconds min_interval = std::chrono::milliseconds(10));
+    ~MarketDataPublisher();
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    // Runs publishPending() on a background thread, at most once per min_interval
+    void start();
+    void stop();
+
+    std::shared_ptr<BookSubscription> subscribe(const std::string& symbol,
+                                                std::function<void()> on_ready,
+                                                size_t max_queued = kDefaultQueueDepth);
+    void unsubscribe(const std::shared_ptr<BookSubscription>& subscription);
+
+    // Book change notification; cheap enough to call from the order path
+    void markDirty(const std::string& symbol);
+
+    // Publishes every dirty topic that has subscribers and returns the number
+    // of updates serialized
+    size_t publishPending();
+
+    [[nodiscard]] uint64_t serializedCount() const noexcept { return serialized_.load(std::memory_order_relaxed); }
+
+private:
+    struct Topic {
+        std::vector<std::shared_ptr<BookSubscription>> subscribers;
+        SerializedBookUpdate latest;
+        bool dirty{true};
+    };
+
+    void run();
+
+    std::shared_ptr<OrderClientServer> server_;
+    const std::chrono::milliseconds min_interval_;
+
+    std::mutex mutex_;
+    std::condition_variable dirty_cv_;
+    std::map<std::string, Topic> topics_;
+    bool has_dirty_{false};
+    bool running_{false};
+    std::thread thread_;
+    std::atomic<uint64_t> serialized_{0};
+};
+
+#endif // MARKET_DATA_PUBLISHER_HPP
@@ -0,0 +1,52 @@
+// include/metrics_http_server.hpp
+#ifndef METRICS_HTTP_SERVER_HPP
+#define METRICS_HTTP_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+
+// Minimal HTTP/1.0 endpoint for metrics scrapers and operators: GET only,
+// one connection at a time on a single thread, connection closed after each
+// response. It is not a general web server and should only be reachable
+// from the monitoring network.
+class MetricsHttpServer {
+public:
+    struct Response {
+        std::string content_type;
+        std::string body;
+    };
+    using Handler = std::function<Response()>;
+
+    // `address` is host:port; port 0 picks a free port (see port())
+    explicit MetricsHttpServer(std::string address);
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    // Serves `path` (without query string). Must be called before start().
+    void handle(const std::string& path, Handler handler);
+    // Binds and starts serving; throws std::runtime_error if the address
+    // cannot be bound
+    void start();
+    void stop();
+
+    [[nodiscard]] uint16_t port() const noexcept { return port_; }
+
+private:
+    void serve();
+    void respond(int client);
+
+    const std::string address_;
+    std::map<std::string, Handler> handlers_;
+    int listen_fd_{-1};
+    uint16_t port_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+#endif // METRICS_HTTP_SERVER_HPP
@@ -0,0 +1,171 @@
+// include/order_capture.hpp
+#ifndef ORDER_CAPTURE_HPP
+#define ORDER_CAPTURE_HPP
+
+#include "mapped_file.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Binary order capture, version 1. All integers are little-endian.
+//
+//   CaptureHeader        64 bytes at offset 0
+//   CaptureRecord[]      record_count fixed-size records at records_offset
+//   string dictionary    string_count entries at dictionary_offset, each a
+//                        uint32 length followed by that many bytes
+//
+// Order ids are stored in the record, NUL-padded to kCaptureOrderIdSize
+// bytes, since nearly every record brings a new one. Trader ids and symbols
+// repeat, so they are interned: a record refers to them by their position
+// in the dictionary. Prices are integers in units of 1 / price_scale.
+//
+// The reader maps the file and hands out the records in place, so the
+// layout below is the in-memory layout and only little-endian hosts are
+// supported.
+static_assert(std::endian::native == std::endian::little, "order captures are read in place");
+
+inline constexpr char kCaptureMagic[4] = {'O', 'C', 'A', 'P'};
+inline constexpr uint16_t kCaptureVersion = 1;
+inline constexpr uint32_t kNoCaptureRef = UINT32_MAX;
+inline constexpr size_t kCaptureOrderIdSize = 24;
+
+struct CaptureHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t header_size;
+    uint16_t record_size;
+    uint16_t flags;  // None defined yet; readers reject any set
+    uint32_t string_count;
+    uint64_t record_count;
+    uint64_t records_offset;
+    uint64_t dictionary_offset;
+    uint64_t dictionary_size;
+    int64_t price_scale;
+    uint8_t reserved[8];
+};
+static_assert(sizeof(CaptureHeader) == 64);
+
+enum class CaptureType : uint8_t {
+    New = 1,
+    Cancel = 2,
+    // Cancel of replaces_order_id, then a new order order_id with the record's
+    // symbol, side, price and quantity
+    Amend = 3,
+};
+
+struct CaptureRecord {
+    int64_t timestamp_ns;  // When the command was captured; 0 if unknown
+    int64_t price;         // In units of 1 / price_scale; 0 for cancels
+    char order_id[kCaptureOrderIdSize];
+    char replaces_order_id[kCaptureOrderIdSize];  // Amend only, else empty
+    uint32_t symbol_ref;    // kNoCaptureRef on a cancel of unknown symbol
+    uint32_t trader_ref;
+    int32_t quantity;       // 0 for cancels
+    CaptureType type;
+    uint8_t is_buy;
+    uint8_t reserved[2];
+
+    [[nodiscard]] std::string_view orderId() const noexcept { return idView(order_id); }
+    [[nodiscard]] std::string_view replacesOrderId() const noexcept { return idView(replaces_order_id); }
+
+private:
+    static std::string_view idView(const char (&id)[kCaptureOrderIdSize]) noexcept {
+        size_t length = 0;
+        while (length < kCaptureOrderIdSize && id[length] != '\0') {
+            ++length;
+        }
+        return {id, length};
+    }
+};
+static_assert(sizeof(CaptureRecord) == 80);
+static_assert(std::is_standard_layout_v<CaptureRecord> && std::is_trivially_copyable_v<CaptureRecord>);
+
+// Writes a capture through a 1 MiB buffer. Records are appended as they
+// come and the dictionary follows them on close(), so memory use is that
+// of the distinct traders and symbols only.
+class CaptureWriter {
+public:
+    static constexpr int64_t kDefaultPriceScale = 10000;
+
+    // Throws std::runtime_error if the file cannot be created
+    explicit CaptureWriter(const std::string& path, int64_t price_scale = kDefaultPriceScale);
+    // Closes the file if close() was not called, ignoring errors
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    // The write functions throw std::invalid_argument for an order id
+    // longer than kCaptureOrderIdSize or a price that does not fit the
+    // scale, and std::runtime_error if the write fails
+    void writeNew(int64_t timestamp_ns, std::string_view order_id, std::string_view trader_id,
+                  std::string_view symbol, double price, int32_t quantity, bool is_buy);
+    // symbol may be empty when the cancel does not name it
+    void writeCancel(int64_t timestamp_ns, std::string_view order_id, std::string_view trader_id,
+                     std::string_view symbol, bool is_buy);
+    void writeAmend(int64_t timestamp_ns, std::string_view order_id, std::string_view new_order_id,
+                    std::string_view trader_id, std::string_view symbol, double price, int32_t quantity,
+                    bool is_buy);
+    // Appends a record whose refs came from intern()
+    void write(const CaptureRecord& record);
+    // Stores order_id in a record field; throws std::invalid_argument if it
+    // is too long
+    static void setOrderId(char (&field)[kCaptureOrderIdSize], std::string_view order_id);
+    uint32_t intern(std::string_view text);
+
+    // Writes the dictionary and the final header. Throws std::runtime_error
+    // if the file cannot be completed.
+    void close();
+
+    [[nodiscard]] uint64_t recordCount() const noexcept { return record_count_; }
+    [[nodiscard]] int64_t priceScale() const noexcept { return price_scale_; }
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::vector<char> buffer_;
+    int64_t price_scale_;
+    uint64_t record_count_ = 0;
+    // A deque, so the map's keys can view the strings without moving
+    std::deque<std::string> strings_;
+    std::unordered_map<std::string_view, uint32_t> string_refs_;
+
+    int64_t toPrice(double price) const;
+    void put(const void* data, size_t size);
+};
+
+// Zero-copy view of a capture file. Opening it validates the header and
+// indexes the dictionary; records() then points straight into the mapping.
+class CaptureReader {
+public:
+    // Throws std::runtime_error if the file cannot be mapped or is not a
+    // well-formed capture of a supported version
+    explicit CaptureReader(const std::string& path);
+
+    [[nodiscard]] const CaptureHeader& header() const noexcept { return header_; }
+    [[nodiscard]] std::span<const CaptureRecord> records() const noexcept { return records_; }
+    [[nodiscard]] size_t stringCount() const noexcept { return strings_.size(); }
+
+    // Empty for kNoCaptureRef; throws std::out_of_range for a ref past the
+    // dictionary
+    [[nodiscard]] std::string_view string(uint32_t ref) const;
+    [[nodiscard]] double price(const CaptureRecord& record) const noexcept {
+        return static_cast<double>(record.price) / static_cast<double>(header_.price_scale);
+    }
+
+private:
+    MappedFile file_;
+    CaptureHeader header_{};
+    std::span<const CaptureRecord> records_;
+    std::vector<std::string_view> strings_;
+};
+
+#endif // ORDER_CAPTURE_HPP
@@ -3,9 +3,16 @@
 #define ORDER_CLIENT_SERVER_HPP
 
 #include "order_service.grpc.pb.h"
+#include "order_status_index.hpp"
+#include "order_event_log.hpp"
+#include "request_tracer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -14,22 +21,130 @@ public:
     explicit OrderError(const std::string& message) : std::runtime_error(message) {}
 };
 
+// Resting orders on one side of a symbol's book
+struct BookSideStats {
+    size_t orders = 0;
+    size_t price_levels = 0;
+    int64_t quantity = 0;
+};
+
+struct SymbolBookStats {
+    std::string symbol;
+    BookSideStats buy;
+    BookSideStats sell;
+    uint64_t fills = 0;             // Resting orders hit, since start
+    uint64_t matched_quantity = 0;  // Since start
+};
+
 class OrderClientServer {
 public:
-    OrderClientServer() = default;
+    // Chunk size used when a snapshot request leaves max_orders_per_chunk unset,
+    // and the cap applied to whatever the client asks for.
+    static constexpr int kDefaultSnapshotChunkOrders = 500;
+    static constexpr int kMaxSnapshotChunkOrders = 5000;
+
+    using BookUpdateListener = std::function<void(const std::string& symbol)>;
+    using ExecutionListener = std::function<void(const order_service::ExecutionReport& report)>;
+    using ExecutionsPublishedListener = std::function<void()>;
+    using LockWaitListener = std::function<void(std::chrono::nanoseconds waited)>;
+
+    explicit OrderClientServer(size_t terminal_status_capacity = OrderStatusIndex::kDefaultTerminalCapacity)
+        : status_index_(terminal_status_capacity) {}
+
+    // Called after every book change, outside the order lock. Must be set
+    // before the server starts taking requests.
+    void setBookUpdateListener(BookUpdateListener listener) { book_update_listener_ = std::move(listener); }
+    // Receives fill and cancel reports for both sides of every execution, in
+    // execution order. It is called under the order lock, so it must be
+    // quick and must not call back into the server. `published`, if set, is
+    // called once the lock is released after a request that reported
+    // executions, to deliver them. Same setup rule as above.
+    void setExecutionListener(ExecutionListener listener, ExecutionsPublishedListener published = nullptr) {
+        execution_listener_ = std::move(listener);
+        executions_published_listener_ = std::move(published);
+    }
+    // Per-order logging; none by default. Same setup rule as above.
+    void setOrderEventLog(std::shared_ptr<OrderEventLog> log) { order_event_log_ = std::move(log); }
+    // Told how long each request waited for the order lock, once the lock
+    // has been released. Same setup rule as above.
+    void setLockWaitListener(LockWaitListener listener) { lock_wait_listener_ = std::move(listener); }
     
+    // Each call has two forms: one returning a new message, and one building
+    // the result in place in a caller-supplied (typically arena-allocated)
+    // empty message. The in-place forms mark the lock, match and response
+    // stages on `trace` when the request is being traced.
     order_service::OrderResponse submitOrder(const order_service::OrderRequest& request);
+    void submitOrder(const order_service::OrderRequest& request, order_service::OrderResponse* response,
+                     RequestTrace* trace = nullptr);
     order_service::CancelResponse cancelOrder(const order_service::CancelRequest& request);
+    void cancelOrder(const order_service::CancelRequest& request, order_service::CancelResponse* response,
+                     RequestTrace* trace = nullptr);
     order_service::ViewOrderBookResponse getOrderBook(const order_service::ViewOrderBookRequest& request);
+    void getOrderBook(const order_service::ViewOrderBookRequest& request,
+                      order_service::ViewOrderBookResponse* response,
+                      RequestTrace* trace = nullptr);
+
+    // Returns the next bounded page of the book after request.cursor(). Only
+    // one chunk worth of entries is copied, whatever the size of the book.
+    // Each side is kept in arrival order, so the cursor is found by binary
+    // search; with a symbol set, other symbols' entries between the cursor
+    // and the end of the page are still stepped over under the order lock.
+    order_service::OrderBookSnapshotChunk getOrderBookChunk(
+        const order_service::OrderBookSnapshotRequest& request);
+    void getOrderBookChunk(const order_service::OrderBookSnapshotRequest& request,
+                           order_service::OrderBookSnapshotChunk* chunk);
+
+    // Answered from the order-id index without taking the order lock
+    order_service::OrderStatusResponse getOrderStatus(const order_service::OrderStatusRequest& request) const;
+    void getOrderStatus(const order_service::OrderStatusRequest& request,
+                        order_service::OrderStatusResponse* response) const;
+
+    // Per-symbol depth and match counts, by symbol. Copies counters kept up
+    // to date by every submit, match and cancel, so the order lock is held
+    // for one step per symbol rather than per resting order.
+    std::vector<SymbolBookStats> bookStats();
 
 private:
     mutable std::mutex order_mutex_;
+    // Each side in sequence (arrival) order; matching never reorders them
     std::vector<order_service::OrderBookEntry> buy_orders_;
     std::vector<order_service::OrderBookEntry> sell_orders_;
+    std::vector<size_t> match_candidates_;  // Reused by matchOrders under order_mutex_
+    uint64_t next_sequence_{1};
+    uint64_t next_execution_id_{1};
+    BookUpdateListener book_update_listener_;
+    ExecutionListener execution_listener_;
+    ExecutionsPublishedListener executions_published_listener_;
+    std::shared_ptr<OrderEventLog> order_event_log_;
+    LockWaitListener lock_wait_listener_;
+    OrderStatusIndex status_index_;  // Written under order_mutex_ only
+    struct SideTally {
+        size_t orders = 0;
+        int64_t quantity = 0;
+        std::unordered_map<double, size_t> orders_at_price;
+    };
+    struct SymbolTally {
+        SideTally buy;
+        SideTally sell;
+        uint64_t fills = 0;
+        uint64_t matched_quantity = 0;
+    };
+    std::unordered_map<std::string, SymbolTally> tallies_;  // Guarded by order_mutex_
     
     // Helper methods
-    int matchOrders(order_service::OrderBookEntry& new_order);
-    std::string getCurrentTimestamp() const;
+    // Reports are only built when `executions` is non-null
+    int matchOrders(order_service::OrderBookEntry& new_order,
+                    double& last_fill_price,
+                    std::vector<order_service::ExecutionReport>* executions);
+    order_service::ExecutionReport makeExecutionReport(const order_service::OrderBookEntry& entry,
+                                                       order_service::OrderStatus status,
+                                                       double price,
+                                                       int quantity,
+                                                       bool is_aggressor);
+    // Keep tallies_ in step with the book: an entry starts resting, or
+    // `quantity` of it fills or is cancelled, leaving the book if it is gone
+    void addResting(const order_service::OrderBookEntry& entry);
+    void takeResting(const order_service::OrderBookEntry& entry, int quantity, bool leaves_book);
 };
 
 #endif // ORDER_CLIENT_SERVER_HPP
@@ -0,0 +1,92 @@
+// include/order_event_log.hpp
+#ifndef ORDER_EVENT_LOG_HPP
+#define ORDER_EVENT_LOG_HPP
+
+#include "bounded_mpsc_queue.hpp"
+#include "order_service.pb.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class OrderLogMode {
+    Off,      // No per-order logging
+    Sampled,  // One order or cancel in sample_every is logged as text
+    Audit     // Every order, fill and cancel goes to a binary audit file
+};
+
+struct OrderLogConfig {
+    OrderLogMode mode = OrderLogMode::Sampled;
+    uint32_t sample_every = 1000;
+    std::string audit_path = "order_audit.bin";
+    size_t audit_queue_records = 65536;
+};
+
+// Fixed-size audit record, written in host byte order. Strings are truncated
+// to their field width and zero-padded.
+struct OrderAuditRecord {
+    enum class Type : uint8_t { Order = 1, Fill = 2, Cancel = 3 };
+
+    Type type;
+    uint8_t is_buy_order;
+    uint8_t status;                  // order_service::OrderStatus
+    uint8_t reserved;
+    int32_t quantity;                // Order, fill or cancelled quantity
+    int64_t timestamp_ns;
+    double price;                    // Limit price, or fill price for fills
+    char order_id[32];               // Aggressor for fills
+    char trader_id[16];
+    char symbol[8];
+    char counterparty_order_id[32];  // Resting order for fills
+};
+static_assert(sizeof(OrderAuditRecord) == 112, "Audit record layout is part of the file format");
+
+// Per-order logging for the request path. Callers ask shouldLog() before
+// taking the order lock and log after releasing it, so nothing is formatted
+// or queued inside the matching critical section. Text goes through spdlog;
+// audit records go through a lock-free queue to a writer thread, and are
+// dropped (and counted) rather than ever blocking a request when the queue
+// is full.
+class OrderEventLog {
+public:
+    explicit OrderEventLog(OrderLogConfig config);
+    ~OrderEventLog();
+
+    OrderEventLog(const OrderEventLog&) = delete;
+    OrderEventLog& operator=(const OrderEventLog&) = delete;
+
+    // Whether the next order or cancel on this thread should be logged
+    bool shouldLog() noexcept;
+
+    // `executions` holds the fill reports of the order in match order, each
+    // fill as a resting-side report followed by the aggressor's
+    void logOrder(const order_service::OrderDetails& details,
+                  const order_service::OrderResponse& response,
+                  const std::vector<order_service::ExecutionReport>& executions);
+    // `symbol` and `cancelled_quantity` describe the order taken off the
+    // book; they are empty and 0 when the cancel found nothing
+    void logCancel(const order_service::CancelRequest& request,
+                   const order_service::CancelResponse& response,
+                   const std::string& symbol,
+                   int cancelled_quantity);
+
+    [[nodiscard]] OrderLogMode mode() const noexcept { return config_.mode; }
+    [[nodiscard]] uint64_t droppedRecords() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void enqueue(const OrderAuditRecord& record) noexcept;
+    void runAuditWriter();
+
+    const OrderLogConfig config_;
+
+    std::unique_ptr<BoundedMpscQueue<OrderAuditRecord>> audit_queue_;
+    std::FILE* audit_file_{nullptr};
+    std::thread audit_writer_;
+    std::atomic<bool> running_{true};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+#endif // ORDER_EVENT_LOG_HPP
@@ -0,0 +1,78 @@
+// include/order_file_reader.hpp
+#ifndef ORDER_FILE_READER_HPP
+#define ORDER_FILE_READER_HPP
+
+#include "mapped_file.hpp"
+#include "order_service.pb.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+enum class OrderFileFormat {
+    Json,    // {"orders": [...]}, parsed as a whole
+    NdJson,  // One order object per line
+    Csv,     // Header row naming the columns, then one order per line
+    Capture, // Binary capture, read with CaptureReader (order_capture.hpp)
+};
+
+// By extension: .ndjson and .jsonl are NdJson, .csv is Csv, .ocap is
+// Capture, anything else Json
+OrderFileFormat orderFileFormatFor(const std::string& path);
+
+enum class ReadResult {
+    Order,      // The request holds the next order
+    Malformed,  // The line was skipped; error() says why
+    End,
+};
+
+// Streams orders out of a memory-mapped NDJSON or CSV file, one line at a
+// time, so the first order is ready as soon as its line is parsed and
+// memory use does not grow with the file. Both formats carry the fields of
+// the JSON layout:
+//   order_id, trader_id, symbol, price, quantity, is_buy
+// NDJSON lines are flat objects; unknown keys are ignored. CSV columns may
+// come in any order and may be double-quoted; is_buy accepts true/false,
+// 1/0 or buy/sell. Blank lines are skipped in both.
+class OrderFileReader {
+public:
+    // Throws std::runtime_error if the file cannot be mapped, or if a CSV
+    // header is missing a column
+    OrderFileReader(const std::string& path, OrderFileFormat format);
+
+    // Parses the next line into request, which should arrive cleared
+    ReadResult next(order_service::OrderRequest& request);
+
+    // Line of the last record returned, from 1
+    [[nodiscard]] uint64_t lineNumber() const noexcept { return line_number_; }
+    // Why the last Malformed line was rejected
+    [[nodiscard]] const std::string& error() const noexcept { return error_; }
+
+private:
+    enum Field : size_t { OrderId, TraderId, Symbol, Price, Quantity, IsBuy, kFieldCount };
+    static constexpr size_t kNoColumn = SIZE_MAX;
+    // Pages behind the cursor are handed back in steps of this many bytes
+    static constexpr size_t kReleaseStep = 16 << 20;
+
+    OrderFileFormat format_;
+    MappedFile file_;
+    size_t offset_ = 0;
+    size_t released_ = 0;
+    uint64_t line_number_ = 0;
+    std::string error_;
+    // Escaped JSON strings are decoded here rather than into a new string
+    std::string scratch_;
+    // CSV column of each field
+    std::array<size_t, kFieldCount> columns_{};
+    size_t column_count_ = 0;
+
+    bool nextLine(std::string_view& line);
+    void readCsvHeader();
+    bool parseNdJson(std::string_view line, order_service::OrderRequest& request);
+    bool parseCsv(std::string_view line, order_service::OrderRequest& request);
+    bool setField(Field field, std::string_view value, bool quoted, order_service::OrderRequest& request);
+    bool fail(std::string message);
+};
+
+#endif // ORDER_FILE_READER_HPP
@@ -0,0 +1,139 @@
+// include/order_replayer.hpp
+#ifndef ORDER_REPLAYER_HPP
+#define ORDER_REPLAYER_HPP
+
+#include "async_order_client.hpp"
+#include "latency_histogram.hpp"
+#include "order_service.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ReplayConfig {
+    size_t window = 256;           // Orders in flight at once
+    double rate_per_second = 0.0;  // 0 sends as fast as the window allows
+    bool log_each_order = false;   // Log every response, not just errors
+    // Errors kept in ReplayReport::errors; the counts include the rest
+    size_t max_errors = 1000;
+};
+
+enum class ReplayKind : uint8_t {
+    New,     // SubmitOrder
+    Cancel,  // CancelOrder
+    Amend,   // CancelOrder, then SubmitOrder of the replacement once the cancel succeeds
+};
+
+// One entry of a replay source. New uses order, Cancel uses cancel, and
+// Amend uses both: the cancel of the old order and its replacement.
+struct ReplayRequest {
+    ReplayKind kind = ReplayKind::New;
+    order_service::OrderRequest order;
+    order_service::CancelRequest cancel;
+
+    void clear() {
+        kind = ReplayKind::New;
+        order.Clear();
+        cancel.Clear();
+    }
+};
+
+struct ReplayError {
+    uint64_t index = 0;  // Position of the request in the source, from 0
+    std::string order_id;
+    std::string message;
+};
+
+struct ReplayReport {
+    uint64_t submitted = 0;
+    uint64_t accepted = 0;  // Order resting or (partially) filled, or cancel/amend applied
+    uint64_t rejected = 0;  // Answered, but not applied
+    uint64_t failed = 0;    // Non-OK gRPC status
+    uint64_t cancels = 0;   // Of submitted, how many were cancels
+    uint64_t amends = 0;    // and amends
+    double seconds = 0.0;
+    // Send to final response, per request
+    LatencyHistogram latency;
+    // The first ReplayConfig::max_errors rejected or failed requests, in
+    // completion order
+    std::vector<ReplayError> errors;
+
+    [[nodiscard]] double ordersPerSecond() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(submitted) / seconds : 0.0;
+    }
+};
+
+// Submits a stream of orders, cancels and amends through an
+// AsyncOrderClient, keeping up to `window` requests in flight instead of
+// waiting for each response. Requests live in a fixed pool of window slots
+// and are reused, as the client reuses its calls, so a long replay does not
+// build up per-order state.
+//
+// Requests in flight together may reach the server in any order, so a
+// request is held back while an earlier one for the same order id is in
+// flight: a cancel or amend goes out once the submit of its order has been
+// answered. Requests for other ids keep flowing past it.
+//
+// The calling thread reads the source and sends; the client's completion
+// threads record the responses.
+class OrderReplayer {
+public:
+    // Fills request with the next entry and returns true, or returns false
+    // at the end of the source. The request arrives cleared, with its
+    // storage reused from an earlier entry.
+    using OrderSource = std::function<bool(ReplayRequest& request)>;
+
+    // The client must outlive the replayer; its call timeout applies to
+    // every request
+    OrderReplayer(AsyncOrderClient& client, ReplayConfig config);
+
+    // Returns once every request sent has been answered, also when next
+    // throws
+    ReplayReport replay(const OrderSource& next);
+
+private:
+    struct Slot {
+        uint64_t index = 0;
+        std::chrono::steady_clock::time_point sent;
+        ReplayRequest request;
+        // The order ids the request touches, sorted, and how many of them
+        // it holds. It is sent once it holds them all.
+        std::array<std::string, 2> ids;
+        size_t id_count = 0;
+        size_t held_ids = 0;
+    };
+
+    AsyncOrderClient& client_;
+    ReplayConfig config_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Guards the free slots and the report, which the completion threads
+    // update
+    std::mutex mutex_;
+    std::condition_variable slot_freed_;
+    std::vector<Slot*> free_slots_;
+    // Ids held by a request, each with the requests waiting for it in
+    // source order
+    std::unordered_map<std::string, std::deque<Slot*>> busy_ids_;
+    ReplayReport report_;
+
+    // Takes the slot's ids in order; false if it is now queued on one
+    bool acquireIds(Slot& slot);
+    // Hands each id to its next waiter, adding those now ready to ready
+    void releaseIds(Slot& slot, std::vector<Slot*>& ready);
+    void start(Slot& slot);
+    void complete(Slot& slot, const grpc::Status& rpc, bool submit, order_service::OrderStatus status,
+                  const std::string& message);
+    void waitForAllSlots();
+};
+
+#endif // ORDER_REPLAYER_HPP
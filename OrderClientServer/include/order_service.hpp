@@ -4,31 +4,124 @@
 
 #include "order_service.grpc.pb.h"
 #include "order_client_server.hpp"
+#include "market_data_publisher.hpp"
+#include "execution_report_hub.hpp"
+#include "arena_message_allocator.hpp"
+#include "admission_controller.hpp"
+#include "rate_limiter.hpp"
+#include "lane_scheduler.hpp"
+#include "request_tracer.hpp"
+#include "server_metrics.hpp"
 #include <grpcpp/grpcpp.h>
 #include <memory>
+#include <utility>
 
-class OrderServiceImpl final : public order_service::OrderService::Service {
+// Unary RPCs and the push streams are served through the callback API. Unary
+// calls get their request and response from a per-call arena (see
+// ArenaMessageAllocator) and build the response in place. Push streams do not
+// each pin a sync server thread, and StreamOrderBook is raw so that the
+// publisher's pre-serialized buffers go out without being re-encoded per
+// subscriber. StreamOrderBookSnapshot uses the sync API.
+//
+// With a LaneScheduler, gRPC threads only throttle, admit and enqueue: orders,
+// cancels, book views and snapshot chunks run on the scheduler's lanes.
+// GetOrderStatus never takes the order lock and is still answered inline.
+using OrderServiceBase = order_service::OrderService::WithCallbackMethod_SubmitOrder<
+    order_service::OrderService::WithCallbackMethod_CancelOrder<
+    order_service::OrderService::WithCallbackMethod_ViewOrderBook<
+    order_service::OrderService::WithCallbackMethod_GetOrderStatus<
+    order_service::OrderService::WithCallbackMethod_StreamExecutions<
+    order_service::OrderService::WithRawCallbackMethod_StreamOrderBook<
+        order_service::OrderService::Service>>>>>>;
+
+class OrderServiceImpl final : public OrderServiceBase {
 public:
-    explicit OrderServiceImpl(std::shared_ptr<OrderClientServer> server);
+    // Creates and starts a MarketDataPublisher wired to the server when none
+    // is supplied. Without an AdmissionController every request is admitted;
+    // without a RateLimiter no trader or connection is throttled; without a
+    // LaneScheduler handlers run on gRPC's threads. A supplied scheduler is
+    // started here. With a RequestTracer, sampled unary calls are traced;
+    // with ServerMetrics, every unary call and order lock wait is counted.
+    explicit OrderServiceImpl(std::shared_ptr<OrderClientServer> server,
+                              std::shared_ptr<MarketDataPublisher> publisher = nullptr,
+                              std::shared_ptr<AdmissionController> admission = nullptr,
+                              std::shared_ptr<RateLimiter> rate_limiter = nullptr,
+                              std::shared_ptr<LaneScheduler> lanes = nullptr,
+                              std::shared_ptr<RequestTracer> tracer = nullptr,
+                              std::shared_ptr<ServerMetrics> metrics = nullptr);
     
-    grpc::Status SubmitOrder(grpc::ServerContext* context,
-                            const order_service::OrderRequest* request,
-                            order_service::OrderResponse* response) override;
+    grpc::ServerUnaryReactor* SubmitOrder(grpc::CallbackServerContext* context,
+                                          const order_service::OrderRequest* request,
+                                          order_service::OrderResponse* response) override;
                              
-    grpc::Status CancelOrder(grpc::ServerContext* context,
-                            const order_service::CancelRequest* request,
-                            order_service::CancelResponse* response) override;
+    grpc::ServerUnaryReactor* CancelOrder(grpc::CallbackServerContext* context,
+                                          const order_service::CancelRequest* request,
+                                          order_service::CancelResponse* response) override;
+
+    grpc::ServerUnaryReactor* ViewOrderBook(grpc::CallbackServerContext* context,
+                                            const order_service::ViewOrderBookRequest* request,
+                                            order_service::ViewOrderBookResponse* response) override;
+
+    grpc::ServerWriteReactor<grpc::ByteBuffer>* StreamOrderBook(grpc::CallbackServerContext* context,
+                                                               const grpc::ByteBuffer* request) override;
+
+    grpc::Status StreamOrderBookSnapshot(grpc::ServerContext* context,
+                                       const order_service::OrderBookSnapshotRequest* request,
+                                       grpc::ServerWriter<order_service::OrderBookSnapshotChunk>* writer) override;
+
+    grpc::ServerWriteReactor<order_service::ExecutionReport>* StreamExecutions(
+        grpc::CallbackServerContext* context,
+        const order_service::ExecutionStreamRequest* request) override;
 
-    grpc::Status ViewOrderBook(grpc::ServerContext* context,
-                             const order_service::ViewOrderBookRequest* request,
-                             order_service::ViewOrderBookResponse* response) override;
+    grpc::ServerUnaryReactor* GetOrderStatus(grpc::CallbackServerContext* context,
+                                             const order_service::OrderStatusRequest* request,
+                                             order_service::OrderStatusResponse* response) override;
 
-    grpc::Status StreamOrderBook(grpc::ServerContext* context,
-                               const order_service::ViewOrderBookRequest* request,
-                               grpc::ServerWriter<order_service::ViewOrderBookResponse>* writer) override;
+    // Prometheus text for the metrics endpoint; empty without ServerMetrics
+    std::string renderMetrics() const;
+
+    // Feeds StreamExecutions; the server publishes every execution to it
+    [[nodiscard]] ExecutionReportHub& executionHub() const noexcept { return *executions_; }
 
 private:
+    struct UnaryCall {
+        grpc::ServerUnaryReactor* reactor;
+        RequestTrace* trace;       // Null unless the call is sampled
+        TracedRpc rpc;
+        uint64_t started_ticks;    // TscClock ticks at entry; 0 without metrics
+    };
+
+    // The call's reactor is gRPC's default one, or for a sampled call one
+    // that records the trace when the call is done
+    UnaryCall startCall(grpc::CallbackServerContext* context, TracedRpc rpc);
+    // Finishes the call and counts it. The outcome is taken from `status`
+    // unless given.
+    void finish(const UnaryCall& call, const grpc::Status& status);
+    void finish(const UnaryCall& call, const grpc::Status& status, CallOutcome outcome);
+    AdmissionController::Ticket admit(RequestPriority priority);
+    // Charges an order or cancel to its trader and connection
+    bool withinRate(const grpc::CallbackServerContext* context, const std::string& trader_id);
+    // Runs `handle` (which finishes `reactor`) on its lane, or inline without
+    // lanes. The ticket is held until the handler has run.
+    template <typename Handler>
+    void dispatch(RequestPriority lane, const UnaryCall& call, AdmissionController::Ticket ticket,
+                  Handler&& handle);
+    // Runs `work` on a lane and waits for it; false if the lane is full
+    bool runOnLane(RequestPriority lane, const std::function<void()>& work);
+
     std::shared_ptr<OrderClientServer> server_;
+    std::shared_ptr<MarketDataPublisher> publisher_;
+    std::shared_ptr<ExecutionReportHub> executions_;
+    std::shared_ptr<AdmissionController> admission_;
+    std::shared_ptr<RateLimiter> rate_limiter_;
+    std::shared_ptr<LaneScheduler> lanes_;
+    std::shared_ptr<RequestTracer> tracer_;
+    std::shared_ptr<ServerMetrics> metrics_;
+
+    ArenaMessageAllocator<order_service::OrderRequest, order_service::OrderResponse> submit_allocator_;
+    ArenaMessageAllocator<order_service::CancelRequest, order_service::CancelResponse> cancel_allocator_;
+    ArenaMessageAllocator<order_service::ViewOrderBookRequest, order_service::ViewOrderBookResponse> view_allocator_;
+    ArenaMessageAllocator<order_service::OrderStatusRequest, order_service::OrderStatusResponse> status_allocator_;
 };
 
 #endif // ORDER_SERVICE_HPP
@@ -0,0 +1,77 @@
+// include/order_status_index.hpp
+#ifndef ORDER_STATUS_INDEX_HPP
+#define ORDER_STATUS_INDEX_HPP
+
+#include "order_service.pb.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Order-id index answering status lookups without the order lock.
+//
+// There is a single writer (the matcher, under OrderClientServer's order
+// lock). Each order has a slot whose mutable fields are published through a
+// seqlock, so readers never block matching and never see a torn update. The
+// shared mutex only guards the id map itself: it is taken exclusively when an
+// order is first indexed or evicted, never for fills.
+//
+// Orders that reach a terminal state (fully filled or cancelled) stay
+// resolvable until terminal_capacity newer terminal orders have displaced
+// them.
+class OrderStatusIndex {
+public:
+    static constexpr size_t kDefaultTerminalCapacity = 100000;
+
+    explicit OrderStatusIndex(size_t terminal_capacity = kDefaultTerminalCapacity);
+
+    OrderStatusIndex(const OrderStatusIndex&) = delete;
+    OrderStatusIndex& operator=(const OrderStatusIndex&) = delete;
+
+    // Writer side. Indexes the order on first sight, then updates it in place.
+    void record(const order_service::OrderDetails& details,
+                order_service::OrderStatus status,
+                int filled_quantity,
+                int remaining_quantity,
+                double last_fill_price = 0.0);
+    // Marks an indexed order cancelled, keeping its fill history
+    void cancel(const std::string& order_id);
+
+    // Reader side; safe concurrently with record(). Returns false when the
+    // order is unknown or has been evicted from the terminal cache.
+    bool lookup(const std::string& order_id, order_service::OrderStatusResponse* response) const;
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Slot {
+        order_service::OrderDetails details;  // Immutable while the slot is mapped
+
+        std::atomic<uint32_t> sequence{0};    // Odd while a write is in progress
+        std::atomic<int32_t> status{0};
+        std::atomic<int32_t> filled_quantity{0};
+        std::atomic<int32_t> remaining_quantity{0};
+        std::atomic<double> last_fill_price{0.0};
+    };
+
+    static bool isTerminal(order_service::OrderStatus status) noexcept;
+    void publish(Slot& slot, order_service::OrderStatus status, int filled_quantity,
+                 int remaining_quantity, double last_fill_price) noexcept;
+    Slot* allocateSlot();
+    void evictTerminal();
+
+    const size_t terminal_capacity_;
+
+    mutable std::shared_mutex map_mutex_;
+    std::unordered_map<std::string, Slot*> slots_;
+
+    // Writer-only state
+    std::deque<Slot> storage_;      // Stable addresses; slots are recycled, never freed
+    std::vector<Slot*> free_slots_;
+    std::deque<Slot*> terminal_;    // Oldest terminal order first
+};
+
+#endif // ORDER_STATUS_INDEX_HPP
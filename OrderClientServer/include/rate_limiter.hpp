@@ -0,0 +1,90 @@
+// include/rate_limiter.hpp
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP
+
+#include "token_bucket.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct RateLimitConfig {
+    double trader_rate = 0;               // Messages per second per trader_id; 0 disables
+    uint32_t trader_burst = 100;
+    double connection_rate = 0;           // Messages per second per client connection; 0 disables
+    uint32_t connection_burst = 500;
+    size_t max_tracked_traders = 65536;    // Traders with a bucket of their own
+    size_t max_tracked_connections = 4096; // Connections with a bucket of their own
+
+    [[nodiscard]] bool enabled() const noexcept { return trader_rate > 0 || connection_rate > 0; }
+};
+
+// Message-rate limits per trader and per connection, checked before a request
+// reaches the order lock. Each key owns a TokenBucket; the maps are guarded
+// by a shared mutex taken exclusively only to add a key, so steady-state
+// checks are a shared lock and one CAS per bucket.
+//
+// trader_id is whatever the client sends, so neither map may grow past
+// max_tracked_traders (or max_tracked_connections) keys. Keys are kept in
+// insertion order; adding one to a full map looks at the oldest key only,
+// dropping it if its bucket has fully refilled and otherwise moving it to the
+// back. When nothing could be dropped, the new key is not tracked and shares
+// one overflow bucket, with the same rate and burst, with every other
+// untracked key until a later message finds room. A returning trader or peer
+// simply starts with a full bucket and a zero throttle count.
+class RateLimiter {
+public:
+    explicit RateLimiter(RateLimitConfig config);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Charges one message to both the trader and the connection (a peer
+    // string as reported by gRPC). Returns false, charging neither, if
+    // either is over its rate.
+    bool allow(const std::string& trader_id, const std::string& peer);
+    bool allow(const std::string& trader_id, const std::string& peer, int64_t now_ns);
+
+    [[nodiscard]] uint64_t throttled(const std::string& trader_id) const;
+    [[nodiscard]] uint64_t throttledTotal() const noexcept { return throttled_total_.load(std::memory_order_relaxed); }
+    // At most `limit` of the tracked traders that have been throttled, most
+    // throttled first, with their counts
+    [[nodiscard]] std::vector<std::pair<std::string, uint64_t>> mostThrottledTraders(size_t limit) const;
+    [[nodiscard]] const RateLimitConfig& config() const noexcept { return config_; }
+    [[nodiscard]] size_t trackedTraders() const;
+
+private:
+    struct TraderState {
+        TraderState(double rate, uint32_t burst) : bucket(rate, burst) {}
+        TokenBucket bucket;
+        std::atomic<uint64_t> throttled{0};
+    };
+
+    // Runs f on the trader's state, adding it if needed, under the traders
+    // lock so the state cannot be evicted while f uses it
+    template <typename F>
+    auto withTrader(const std::string& trader_id, int64_t now_ns, F f);
+    bool allowConnection(const std::string& peer, int64_t now_ns);
+    void countThrottled(const std::string& trader_id, int64_t now_ns);
+
+    const RateLimitConfig config_;
+    std::atomic<uint64_t> throttled_total_{0};
+
+    mutable std::shared_mutex traders_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<TraderState>> traders_;
+    std::deque<const std::string*> trader_order_;  // Keys of traders_, oldest first
+    TraderState overflow_trader_;
+
+    std::shared_mutex connections_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<TokenBucket>> connections_;
+    std::deque<const std::string*> connection_order_;  // Keys of connections_, oldest first
+    TokenBucket overflow_connection_;
+};
+
+#endif // RATE_LIMITER_HPP
@@ -0,0 +1,94 @@
+// include/request_tracer.hpp
+#ifndef REQUEST_TRACER_HPP
+#define REQUEST_TRACER_HPP
+
+#include "tsc_clock.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Points in a request's life, in order. Not every RPC reaches every stage:
+// GetOrderStatus never takes the order lock, and views have no match step.
+enum class TraceStage : uint8_t {
+    Received,       // Handler entered on a gRPC thread
+    Started,        // Work began (after the lane queue, when lanes are used)
+    LockAcquired,   // Order lock held
+    Matched,        // Matching or book mutation done
+    ResponseBuilt,  // Response complete; the order lock is released next
+    Sent,           // gRPC reported the call finished
+};
+inline constexpr size_t kTraceStageCount = 6;
+
+enum class TracedRpc : uint8_t { SubmitOrder, CancelOrder, ViewOrderBook, GetOrderStatus };
+
+const char* traceStageName(TraceStage stage) noexcept;
+const char* tracedRpcName(TracedRpc rpc) noexcept;
+
+// One sampled request: TSC ticks per stage, 0 where a stage was not reached
+struct RequestTrace {
+    uint64_t ticks[kTraceStageCount] = {};
+    uint64_t request_id = 0;
+    uint32_t thread_id = 0;    // Small id of the receiving thread
+    TracedRpc rpc = TracedRpc::SubmitOrder;
+
+    void mark(TraceStage stage) noexcept { ticks[static_cast<size_t>(stage)] = TscClock::now(); }
+    [[nodiscard]] uint64_t at(TraceStage stage) const noexcept { return ticks[static_cast<size_t>(stage)]; }
+};
+
+// Sampled per-request stage timestamps, kept in a fixed ring that always
+// holds the most recent traces.
+//
+// Any thread may record. A writer takes a ticket with one fetch_add, holds
+// the ticket's slot while copying, and publishes through the slot's
+// sequence number (seqlock); a reader that races a writer simply skips that
+// slot. A writer that finds the slot still held drops its trace. Recording
+// never blocks or allocates, so an idle tracer costs one thread-local
+// countdown per request.
+class RequestTracer {
+public:
+    static constexpr size_t kDefaultCapacity = 16384;
+
+    // Traces one request in `sample_every` per thread. Capacity is rounded
+    // up to a power of two.
+    explicit RequestTracer(uint32_t sample_every = 100, size_t capacity = kDefaultCapacity);
+
+    RequestTracer(const RequestTracer&) = delete;
+    RequestTracer& operator=(const RequestTracer&) = delete;
+
+    bool shouldSample() noexcept;
+    // Starts a trace at TraceStage::Received
+    RequestTrace begin(TracedRpc rpc) noexcept;
+    void record(const RequestTrace& trace) noexcept;
+
+    // Traces currently in the ring, oldest first
+    [[nodiscard]] std::vector<RequestTrace> snapshot() const;
+    [[nodiscard]] uint64_t recorded() const noexcept { return next_.load(std::memory_order_relaxed); }
+
+    // Chrome trace-event JSON (chrome://tracing, Perfetto): one slice per
+    // request with a child slice per stage interval
+    [[nodiscard]] std::string chromeTraceJson() const;
+    bool writeChromeTrace(const std::string& path) const;
+    // Per-RPC p50/p90/p99/max of each stage interval, in microseconds
+    [[nodiscard]] std::string stageSummary() const;
+
+private:
+    static constexpr size_t kWords = sizeof(RequestTrace) / sizeof(uint64_t);
+    static_assert(sizeof(RequestTrace) % sizeof(uint64_t) == 0, "RequestTrace is copied as whole words");
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 2 * index + 1 while writing, 2 * index + 2 once written
+        std::atomic<bool> writing{false};   // Held by the one writer allowed in the slot
+        std::atomic<uint64_t> words[kWords];
+    };
+
+    const uint32_t sample_every_;
+    const size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> next_{0};
+    std::atomic<uint64_t> next_request_id_{1};
+};
+
+#endif // REQUEST_TRACER_HPP
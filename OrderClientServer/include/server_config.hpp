@@ -0,0 +1,52 @@
+// include/server_config.hpp
+#ifndef SERVER_CONFIG_HPP
+#define SERVER_CONFIG_HPP
+
+#include "admission_controller.hpp"
+#include "lane_scheduler.hpp"
+#include "order_event_log.hpp"
+#include "rate_limiter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// OrderServer settings. Defaults match the server's historical behaviour
+// except for per-order logging, which is sampled rather than every order.
+struct ServerConfig {
+    std::string listen_address = "0.0.0.0:50051";
+    std::string unix_socket_path;     // Also listen on this unix socket; empty disables it
+    std::string log_level = "info";
+    size_t log_queue_size = 8192;     // Async logger queue, in messages
+    OrderLogConfig order_log;
+    AdmissionConfig admission{.max_in_flight = 0};  // Off unless a budget is set
+    RateLimitConfig rate_limit;       // Off unless a rate is set
+    LaneConfig lanes{.order_entry_workers = 0};     // Off unless workers are set
+    uint32_t trace_sample_every = 0;  // Trace one request in N per thread; 0 disables tracing
+    std::string trace_path = "request_trace.json";
+    std::string metrics_address;      // host:port of the /metrics endpoint; empty disables it
+
+    // Reads overrides from the environment:
+    //   ORDER_SERVER_ADDRESS         listen address
+    //   ORDER_SERVER_UNIX_SOCKET     unix socket path to listen on as well
+    //   ORDER_SERVER_LOG_LEVEL       trace, debug, info, warn, error, critical, off
+    //   ORDER_SERVER_LOG_QUEUE       async logger queue size
+    //   ORDER_LOG_MODE               off, sampled or audit
+    //   ORDER_LOG_SAMPLE_EVERY       log one order in N when sampled
+    //   ORDER_AUDIT_PATH             audit file, appended to
+    //   ORDER_SERVER_MAX_IN_FLIGHT   order/cancel budget, 0 disables admission control
+    //   ORDER_SERVER_TARGET_DELAY_US lock queueing delay above which load is shed
+    //   ORDER_SERVER_TRADER_RATE     orders + cancels per second per trader, 0 disables
+    //   ORDER_SERVER_TRADER_BURST    messages a trader may send at once
+    //   ORDER_SERVER_CONNECTION_RATE orders + cancels per second per connection, 0 disables
+    //   ORDER_SERVER_CONNECTION_BURST
+    //   ORDER_SERVER_ORDER_WORKERS   order-entry lane threads, 0 disables lanes
+    //   ORDER_SERVER_QUERY_WORKERS   query lane threads
+    //   ORDER_SERVER_QUERY_SHARE_PCT percent of one core book queries may use
+    //   ORDER_TRACE_SAMPLE_EVERY     trace one request in N, 0 disables
+    //   ORDER_TRACE_PATH             Chrome trace written on SIGUSR1 and at shutdown
+    //   ORDER_METRICS_ADDRESS        host:port serving Prometheus /metrics
+    // Throws std::invalid_argument on malformed values.
+    static ServerConfig fromEnvironment();
+};
+
+#endif // SERVER_CONFIG_HPP
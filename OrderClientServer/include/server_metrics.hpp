@@ -0,0 +1,107 @@
+// include/server_metrics.hpp
+#ifndef SERVER_METRICS_HPP
+#define SERVER_METRICS_HPP
+
+#include "request_tracer.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class OrderClientServer;
+class AdmissionController;
+class LaneScheduler;
+class RateLimiter;
+
+// Counters are striped across cache-line-sized shards. Each thread always
+// writes the same shard, so concurrent handlers rarely share a line and an
+// update is one uncontended relaxed add; shards are only summed on scrape.
+inline constexpr size_t kMetricShards = 16;
+
+// The calling thread's shard, assigned round-robin on first use
+size_t metricShard() noexcept;
+
+class ShardedCounter {
+public:
+    void add(uint64_t amount = 1) noexcept {
+        shards_[metricShard()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t value() const noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, kMetricShards> shards_;
+};
+
+// Latency histogram with fixed Prometheus-style buckets, from 10 us to 1 s
+class ShardedHistogram {
+public:
+    static constexpr std::array<double, 16> kBoundsSeconds = {
+        0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025,
+        0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+    // The last bucket is +Inf
+    static constexpr size_t kBucketCount = kBoundsSeconds.size() + 1;
+
+    struct Snapshot {
+        std::array<uint64_t, kBucketCount> buckets{};  // Per bucket, not cumulative
+        uint64_t count = 0;
+        double sum_seconds = 0.0;
+    };
+
+    void observe(std::chrono::nanoseconds value) noexcept;
+    [[nodiscard]] Snapshot snapshot() const noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+        std::atomic<uint64_t> sum_ns{0};
+    };
+    std::array<Shard, kMetricShards> shards_;
+};
+
+// How a unary call ended, as far as metrics are concerned
+enum class CallOutcome : uint8_t {
+    Ok,         // Answered, including in-band order rejections
+    Throttled,  // Rejected by the rate limiter
+    Shed,       // RESOURCE_EXHAUSTED from admission control or a full lane
+    Failed,     // Any other non-OK status
+};
+inline constexpr size_t kCallOutcomeCount = 4;
+inline constexpr size_t kTracedRpcCount = 4;
+
+const char* callOutcomeName(CallOutcome outcome) noexcept;
+
+// Components whose state is read at scrape time; any may be null
+struct MetricsSources {
+    OrderClientServer* server = nullptr;
+    const AdmissionController* admission = nullptr;
+    const LaneScheduler* lanes = nullptr;
+    const RateLimiter* rate_limiter = nullptr;
+    const RequestTracer* tracer = nullptr;
+};
+
+// OrderServer metrics. Call counts, call latency and order lock waits are
+// recorded on the request path; book depth, queue depths and the other
+// gauges are read from their owners only when render() is called.
+class ServerMetrics {
+public:
+    void recordCall(TracedRpc rpc, CallOutcome outcome, std::chrono::nanoseconds latency) noexcept;
+    void recordLockWait(std::chrono::nanoseconds waited) noexcept { lock_wait_.observe(waited); }
+
+    [[nodiscard]] uint64_t calls(TracedRpc rpc, CallOutcome outcome) const noexcept;
+
+    // Prometheus text exposition format, version 0.0.4. Takes the order lock
+    // once to read per-symbol book statistics.
+    [[nodiscard]] std::string render(const MetricsSources& sources) const;
+
+private:
+    std::array<std::array<ShardedCounter, kCallOutcomeCount>, kTracedRpcCount> calls_;
+    std::array<ShardedHistogram, kTracedRpcCount> call_latency_;
+    ShardedHistogram lock_wait_;
+};
+
+#endif // SERVER_METRICS_HPP
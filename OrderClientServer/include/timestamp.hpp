@@ -0,0 +1,22 @@
+// include/timestamp.hpp
+#ifndef TIMESTAMP_HPP
+#define TIMESTAMP_HPP
+
+#include <cstdint>
+#include <string>
+
+// Wall-clock time in nanoseconds since the Unix epoch, as carried by the
+// *_ns / timestamp_ns fields of the wire protocol
+using TimestampNanos = int64_t;
+
+// One clock read. Handlers take it once per request, before any lock, and
+// stamp every message the request produces with the same value.
+TimestampNanos currentTimestampNanos();
+
+// Formats `nanos` as local "YYYY-MM-DD HH:MM:SS" for the human-readable
+// timestamp fields. The text is cached per thread and only rebuilt when the
+// second changes; the reference stays valid until the next call on the same
+// thread.
+const std::string& formatTimestamp(TimestampNanos nanos);
+
+#endif // TIMESTAMP_HPP
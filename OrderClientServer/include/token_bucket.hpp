@@ -0,0 +1,52 @@
+// include/token_bucket.hpp
+#ifndef TOKEN_BUCKET_HPP
+#define TOKEN_BUCKET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free token bucket, kept in its GCRA form: instead of a token count and
+// a refill timestamp, the bucket stores the time at which it would be full
+// again. A message is allowed when that time is no more than `burst`
+// messages ahead of now, and pushes it forward by one emission interval.
+// The whole state is one atomic, so tryAcquire() is a single CAS loop.
+class TokenBucket {
+public:
+    // rate is in messages per second; burst is the bucket depth
+    TokenBucket(double rate, uint32_t burst)
+        : interval_ns_(rate > 0 ? static_cast<int64_t>(1e9 / rate) : 0)
+        , tolerance_ns_(interval_ns_ * static_cast<int64_t>(std::max<uint32_t>(burst, 1))) {}
+
+    TokenBucket(const TokenBucket&) = delete;
+    TokenBucket& operator=(const TokenBucket&) = delete;
+
+    // now_ns is any monotonic clock reading in nanoseconds
+    bool tryAcquire(int64_t now_ns) noexcept {
+        int64_t full_at = full_at_.load(std::memory_order_relaxed);
+        for (;;) {
+            int64_t next = std::max(full_at, now_ns) + interval_ns_;
+            if (next - now_ns > tolerance_ns_) {
+                return false;
+            }
+            if (full_at_.compare_exchange_weak(full_at, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Gives back a message taken by tryAcquire() that was not sent after all
+    void refund() noexcept { full_at_.fetch_sub(interval_ns_, std::memory_order_relaxed); }
+
+    // A bucket that has refilled completely holds no state worth keeping
+    [[nodiscard]] bool idle(int64_t now_ns) const noexcept {
+        return full_at_.load(std::memory_order_relaxed) <= now_ns;
+    }
+
+private:
+    const int64_t interval_ns_;
+    const int64_t tolerance_ns_;
+    std::atomic<int64_t> full_at_{0};
+};
+
+#endif // TOKEN_BUCKET_HPP
@@ -0,0 +1,110 @@
+// src/admission_controller.cpp
+#include "admission_controller.hpp"
+#include <spdlog/spdlog.h>
+#include <limits>
+#include <utility>
+
+namespace {
+    constexpr int64_t kNoSample = std::numeric_limits<int64_t>::max();
+}
+
+AdmissionController::Ticket::Ticket(Ticket&& other) noexcept
+    : owner_(std::exchange(other.owner_, nullptr))
+    , admitted_(other.admitted_)
+    , retry_after_(other.retry_after_) {}
+
+AdmissionController::Ticket& AdmissionController::Ticket::operator=(Ticket&& other) noexcept {
+    if (this != &other) {
+        if (owner_) {
+            owner_->release();
+        }
+        owner_ = std::exchange(other.owner_, nullptr);
+        admitted_ = other.admitted_;
+        retry_after_ = other.retry_after_;
+    }
+    return *this;
+}
+
+AdmissionController::Ticket::~Ticket() {
+    if (owner_) {
+        owner_->release();
+    }
+}
+
+AdmissionController::AdmissionController(AdmissionConfig config)
+    : config_(config)
+    , window_end_(nowNanos() + std::chrono::nanoseconds(config.interval).count())
+    , window_min_(kNoSample) {}
+
+int64_t AdmissionController::nowNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AdmissionController::Ticket AdmissionController::tryAdmit(RequestPriority priority) {
+    if (priority != RequestPriority::Cancel && overloaded_.load(std::memory_order_relaxed)) {
+        // Shedding starves the detector of samples, so an interval without
+        // any is taken as the queue having drained
+        rollWindow(nowNanos());
+        if (overloaded_.load(std::memory_order_relaxed)) {
+            return reject(config_.interval);
+        }
+    }
+
+    size_t limit = config_.max_in_flight;
+    if (priority == RequestPriority::Cancel) {
+        limit += config_.cancel_reserve;
+    } else if (priority == RequestPriority::Query) {
+        limit = config_.max_queries_in_flight;
+    }
+
+    if (in_flight_.fetch_add(1, std::memory_order_acq_rel) >= limit) {
+        in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        return reject(config_.retry_after);
+    }
+    return Ticket(this, true, std::chrono::milliseconds(0));
+}
+
+void AdmissionController::observeQueueDelay(std::chrono::nanoseconds delay) {
+    // The sample counts towards the window it completed in, which may be the
+    // one being closed
+    int64_t sample = delay.count();
+    int64_t current = window_min_.load(std::memory_order_relaxed);
+    while (sample < current &&
+           !window_min_.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {
+    }
+
+    rollWindow(nowNanos());
+}
+
+void AdmissionController::rollWindow(int64_t now) {
+    int64_t end = window_end_.load(std::memory_order_acquire);
+    if (now < end) {
+        return;
+    }
+    int64_t next_end = now + std::chrono::nanoseconds(config_.interval).count();
+    if (!window_end_.compare_exchange_strong(end, next_end, std::memory_order_acq_rel)) {
+        return;  // Another thread closed this window
+    }
+
+    int64_t window_min = window_min_.exchange(kNoSample, std::memory_order_relaxed);
+    bool overloaded = window_min != kNoSample &&
+                      window_min > std::chrono::nanoseconds(config_.target_delay).count();
+    if (overloaded_.exchange(overloaded, std::memory_order_relaxed) != overloaded) {
+        if (overloaded) {
+            spdlog::warn("Queueing delay above target for {} ms (minimum {} us); shedding orders and queries",
+                         config_.interval.count(), window_min / 1000);
+        } else {
+            spdlog::info("Queueing delay back under target; admitting all requests");
+        }
+    }
+}
+
+AdmissionController::Ticket AdmissionController::reject(std::chrono::milliseconds retry_after) {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return Ticket(nullptr, false, retry_after);
+}
+
+void AdmissionController::release() noexcept {
+    in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,404 @@
+// src/async_order_client.cpp
+#include "async_order_client.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+    std::shared_ptr<grpc::Channel> openChannel(const OrderClientConfig& config) {
+        if (config.transport == OrderTransport::InProcess) {
+            return config.in_process_server->InProcessChannel(grpc::ChannelArguments());
+        }
+        // A private subchannel pool gives every channel its own connection;
+        // channels with equal arguments would otherwise share one
+        grpc::ChannelArguments args;
+        args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+        return grpc::CreateCustomChannel(config.channelTarget(), grpc::InsecureChannelCredentials(), args);
+    }
+
+    const OrderClientConfig& checkedTransport(const OrderClientConfig& config) {
+        if (config.transport == OrderTransport::UnixSocket && config.unix_socket_path.empty()) {
+            throw std::invalid_argument("unix socket transport needs a socket path");
+        }
+        if (config.transport == OrderTransport::InProcess && !config.in_process_server) {
+            throw std::invalid_argument("in-process transport needs a server");
+        }
+        return config;
+    }
+
+    // Completes a batch once every entry is answered
+    template<typename Response>
+    struct Batch {
+        using Result = AsyncOrderClient::Result<Response>;
+
+        explicit Batch(size_t size) : results(size), remaining(size) {}
+
+        std::vector<Result> results;
+        std::atomic<size_t> remaining;
+        std::promise<std::vector<Result>> promise;
+
+        void complete(size_t index, const grpc::Status& status, Response& response) {
+            results[index].status = status;
+            results[index].response.Swap(&response);
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                promise.set_value(std::move(results));
+            }
+        }
+    };
+
+    template<typename Response>
+    std::pair<std::future<AsyncOrderClient::Result<Response>>, AsyncOrderClient::Callback<Response>> promised() {
+        auto promise = std::make_shared<std::promise<AsyncOrderClient::Result<Response>>>();
+        auto future = promise->get_future();
+        return {std::move(future), [promise](const grpc::Status& status, Response& response) {
+            AsyncOrderClient::Result<Response> result;
+            result.status = status;
+            // Swapping hands over the response and leaves the pooled call
+            // an empty message to reuse
+            result.response.Swap(&response);
+            promise->set_value(std::move(result));
+        }};
+    }
+}
+
+struct AsyncOrderClient::CallBase {
+    virtual ~CallBase() = default;
+    // Runs the callback and returns the call to its pool
+    virtual void finish() = 0;
+
+    grpc::Status status;
+    std::optional<grpc::ClientContext> context;  // Not reusable, so rebuilt per call
+};
+
+template<typename Request, typename Response>
+struct AsyncOrderClient::Call final : CallBase {
+    explicit Call(CallPool<Request, Response>& owner) : pool(owner) {}
+
+    void finish() override;
+
+    CallPool<Request, Response>& pool;
+    Request request;
+    Response response;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader;
+    Callback<Response> done;
+};
+
+template<typename Request, typename Response>
+class AsyncOrderClient::CallPool {
+public:
+    explicit CallPool(size_t limit) : limit_(limit) {}
+
+    std::unique_ptr<Call<Request, Response>> acquire() {
+        {
+            std::lock_guard lock(mutex_);
+            if (!free_.empty()) {
+                auto call = std::move(free_.back());
+                free_.pop_back();
+                return call;
+            }
+        }
+        return std::make_unique<Call<Request, Response>>(*this);
+    }
+
+    void release(std::unique_ptr<Call<Request, Response>> call) {
+        call->request.Clear();
+        call->response.Clear();
+        call->reader.reset();
+        call->context.reset();
+        call->done = nullptr;
+        std::lock_guard lock(mutex_);
+        if (free_.size() < limit_) {
+            free_.push_back(std::move(call));
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Call<Request, Response>>> free_;
+    size_t limit_;
+};
+
+template<typename Request, typename Response>
+void AsyncOrderClient::Call<Request, Response>::finish() {
+    std::unique_ptr<Call> self(this);
+    try {
+        done(status, response);
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Order client callback threw: {}", e.what());
+    }
+    pool.release(std::move(self));
+}
+
+std::string OrderClientConfig::channelTarget() const {
+    switch (transport) {
+        case OrderTransport::Tcp:
+            return target;
+        case OrderTransport::UnixSocket:
+            return "unix:" + unix_socket_path;
+        case OrderTransport::InProcess:
+            break;
+    }
+    throw std::logic_error("an in-process client has no target");
+}
+
+OrderClientConfig OrderClientConfig::fromEnvironment() {
+    OrderClientConfig config;
+    if (const char* socket = std::getenv("SERVER_SOCKET"); socket && *socket) {
+        config.transport = OrderTransport::UnixSocket;
+        config.unix_socket_path = socket;
+        return config;
+    }
+    const char* host = std::getenv("SERVER_HOST");
+    const char* port = std::getenv("SERVER_PORT");
+    if (host) {
+        config.target = std::string(host) + ":" + (port ? port : "50051");
+    }
+    return config;
+}
+
+AsyncOrderClient::AsyncOrderClient(OrderClientConfig config)
+    : AsyncOrderClient(checkedTransport(config), [config](size_t) { return openChannel(config); })
+{
+}
+
+AsyncOrderClient::AsyncOrderClient(OrderClientConfig config, ChannelFactory channels)
+    : config_(std::move(config))
+    , submit_calls_(std::make_unique<CallPool<order_service::OrderRequest, order_service::OrderResponse>>(config_.pooled_calls))
+    , cancel_calls_(std::make_unique<CallPool<order_service::CancelRequest, order_service::CancelResponse>>(config_.pooled_calls))
+    , status_calls_(std::make_unique<CallPool<order_service::OrderStatusRequest, order_service::OrderStatusResponse>>(config_.pooled_calls))
+    , view_calls_(std::make_unique<CallPool<order_service::ViewOrderBookRequest, order_service::ViewOrderBookResponse>>(config_.pooled_calls))
+{
+    if (config_.channels == 0) {
+        throw std::invalid_argument("order client needs at least one channel");
+    }
+    connections_.reserve(config_.channels);
+    for (size_t i = 0; i < config_.channels; ++i) {
+        auto connection = std::make_unique<Connection>();
+        connection->channel = channels(i);
+        connection->stub = order_service::OrderService::NewStub(connection->channel);
+        connections_.push_back(std::move(connection));
+    }
+    // Threads start once nothing else can throw before the wait below
+    for (auto& connection : connections_) {
+        connection->completions = std::thread([this, raw = connection.get()] { drain(*raw); });
+    }
+    if (config_.connect_timeout.count() > 0 && !waitForConnected(config_.connect_timeout)) {
+        // Stop the completion threads before the members go
+        for (auto& connection : connections_) {
+            connection->cq.Shutdown();
+            connection->completions.join();
+        }
+        throw std::runtime_error("Failed to connect to server at " + config_.channelTarget());
+    }
+}
+
+AsyncOrderClient::~AsyncOrderClient() {
+    // An amend starts its second call from a completion thread, which must
+    // happen before the queues shut down
+    while (amends_in_flight_.load(std::memory_order_acquire) > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // Callbacks that start calls from here on are refused
+    closing_.store(true);
+    while (starting_.load() > 0) {
+        std::this_thread::yield();
+    }
+    // Shutdown lets the queue deliver what is in flight before Next fails
+    for (auto& connection : connections_) {
+        connection->cq.Shutdown();
+    }
+    for (auto& connection : connections_) {
+        connection->completions.join();
+    }
+}
+
+void AsyncOrderClient::drain(Connection& connection) {
+    void* tag = nullptr;
+    bool ok = false;
+    while (connection.cq.Next(&tag, &ok)) {
+        // Counted as answered before the callback runs, so a caller woken
+        // by it sees the call finished
+        in_flight_.fetch_sub(1, std::memory_order_relaxed);
+        static_cast<CallBase*>(tag)->finish();
+    }
+}
+
+AsyncOrderClient::Connection& AsyncOrderClient::nextConnection() noexcept {
+    size_t index = next_connection_.fetch_add(1, std::memory_order_relaxed);
+    return *connections_[index % connections_.size()];
+}
+
+template<typename Request, typename Response, typename Prepare, typename Fill>
+void AsyncOrderClient::start(CallPool<Request, Response>& pool, Prepare prepare, const Fill& fill,
+                             Callback<Response> done) {
+    starting_.fetch_add(1);
+    if (closing_.load()) {
+        starting_.fetch_sub(1);
+        Response response;
+        try {
+            done(grpc::Status(grpc::StatusCode::CANCELLED, "Order client is shutting down"), response);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Order client callback threw: {}", e.what());
+        }
+        return;
+    }
+    auto call = pool.acquire();
+    fill(call->request);
+    call->done = std::move(done);
+    call->context.emplace();
+    call->context->set_deadline(std::chrono::system_clock::now() + config_.call_timeout);
+
+    Connection& connection = nextConnection();
+    call->reader = ((*connection.stub).*prepare)(&*call->context, call->request, &connection.cq);
+    call->reader->StartCall();
+    in_flight_.fetch_add(1, std::memory_order_relaxed);
+    // The completion queue owns the call until finish()
+    Call<Request, Response>* raw = call.release();
+    raw->reader->Finish(&raw->response, &raw->status, static_cast<CallBase*>(raw));
+    starting_.fetch_sub(1, std::memory_order_release);
+}
+
+void AsyncOrderClient::submitOrder(const order_service::OrderDetails& details,
+                                   Callback<order_service::OrderResponse> done) {
+    start(*submit_calls_, &order_service::OrderService::Stub::PrepareAsyncSubmitOrder,
+          [&](order_service::OrderRequest& request) { *request.mutable_details() = details; }, std::move(done));
+}
+
+void AsyncOrderClient::cancelOrder(const order_service::CancelRequest& cancel,
+                                   Callback<order_service::CancelResponse> done) {
+    start(*cancel_calls_, &order_service::OrderService::Stub::PrepareAsyncCancelOrder,
+          [&](order_service::CancelRequest& request) { request = cancel; }, std::move(done));
+}
+
+void AsyncOrderClient::getOrderStatus(const std::string& order_id,
+                                      Callback<order_service::OrderStatusResponse> done) {
+    start(*status_calls_, &order_service::OrderService::Stub::PrepareAsyncGetOrderStatus,
+          [&](order_service::OrderStatusRequest& request) { request.set_order_id(order_id); }, std::move(done));
+}
+
+void AsyncOrderClient::viewOrderBook(const std::string& symbol,
+                                     Callback<order_service::ViewOrderBookResponse> done) {
+    start(*view_calls_, &order_service::OrderService::Stub::PrepareAsyncViewOrderBook,
+          [&](order_service::ViewOrderBookRequest& request) { request.set_symbol(symbol); }, std::move(done));
+}
+
+void AsyncOrderClient::amendOrder(const order_service::CancelRequest& cancel,
+                                  const order_service::OrderDetails& replacement, AmendCallback done) {
+    struct Amend {
+        order_service::OrderDetails replacement;
+        AmendCallback done;
+        AmendResult result;
+    };
+    auto amend = std::make_shared<Amend>();
+    amend->replacement = replacement;
+    amend->done = std::move(done);
+    auto finish = [this](Amend& amend) {
+        try {
+            amend.done(amend.result);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Order client callback threw: {}", e.what());
+        }
+        amends_in_flight_.fetch_sub(1, std::memory_order_release);
+    };
+
+    amends_in_flight_.fetch_add(1, std::memory_order_relaxed);
+    cancelOrder(cancel, [this, amend, finish](const grpc::Status& status, order_service::CancelResponse& response) {
+        amend->result.status = status;
+        amend->result.cancel.Swap(&response);
+        if (!status.ok() || amend->result.cancel.status() != order_service::OrderStatus::CANCELLED) {
+            finish(*amend);
+            return;
+        }
+        submitOrder(amend->replacement, [amend, finish](const grpc::Status& status,
+                                                        order_service::OrderResponse& response) {
+            amend->result.status = status;
+            amend->result.replaced = true;
+            amend->result.replacement.Swap(&response);
+            finish(*amend);
+        });
+    });
+}
+
+std::future<AsyncOrderClient::AmendResult>
+AsyncOrderClient::amendOrder(const order_service::CancelRequest& cancel, const order_service::OrderDetails& replacement) {
+    auto promise = std::make_shared<std::promise<AmendResult>>();
+    auto future = promise->get_future();
+    amendOrder(cancel, replacement, [promise](AmendResult& result) { promise->set_value(std::move(result)); });
+    return future;
+}
+
+std::future<AsyncOrderClient::Result<order_service::OrderResponse>>
+AsyncOrderClient::submitOrder(const order_service::OrderDetails& details) {
+    auto [future, done] = promised<order_service::OrderResponse>();
+    submitOrder(details, std::move(done));
+    return std::move(future);
+}
+
+std::future<AsyncOrderClient::Result<order_service::CancelResponse>>
+AsyncOrderClient::cancelOrder(const order_service::CancelRequest& request) {
+    auto [future, done] = promised<order_service::CancelResponse>();
+    cancelOrder(request, std::move(done));
+    return std::move(future);
+}
+
+std::future<AsyncOrderClient::Result<order_service::OrderStatusResponse>>
+AsyncOrderClient::getOrderStatus(const std::string& order_id) {
+    auto [future, done] = promised<order_service::OrderStatusResponse>();
+    getOrderStatus(order_id, std::move(done));
+    return std::move(future);
+}
+
+std::future<AsyncOrderClient::Result<order_service::ViewOrderBookResponse>>
+AsyncOrderClient::viewOrderBook(const std::string& symbol) {
+    auto [future, done] = promised<order_service::ViewOrderBookResponse>();
+    viewOrderBook(symbol, std::move(done));
+    return std::move(future);
+}
+
+std::future<std::vector<AsyncOrderClient::Result<order_service::OrderResponse>>>
+AsyncOrderClient::submitOrders(std::span<const order_service::OrderDetails> orders) {
+    auto batch = std::make_shared<Batch<order_service::OrderResponse>>(orders.size());
+    auto future = batch->promise.get_future();
+    if (orders.empty()) {
+        batch->promise.set_value({});
+    }
+    for (size_t i = 0; i < orders.size(); ++i) {
+        submitOrder(orders[i], [batch, i](const grpc::Status& status, order_service::OrderResponse& response) {
+            batch->complete(i, status, response);
+        });
+    }
+    return future;
+}
+
+std::future<std::vector<AsyncOrderClient::Result<order_service::CancelResponse>>>
+AsyncOrderClient::cancelOrders(std::span<const order_service::CancelRequest> requests) {
+    auto batch = std::make_shared<Batch<order_service::CancelResponse>>(requests.size());
+    auto future = batch->promise.get_future();
+    if (requests.empty()) {
+        batch->promise.set_value({});
+    }
+    for (size_t i = 0; i < requests.size(); ++i) {
+        cancelOrder(requests[i], [batch, i](const grpc::Status& status, order_service::CancelResponse& response) {
+            batch->complete(i, status, response);
+        });
+    }
+    return future;
+}
+
+bool AsyncOrderClient::waitForConnected(std::chrono::milliseconds timeout) {
+    if (config_.transport == OrderTransport::InProcess) {
+        return true;
+    }
+    auto deadline = std::chrono::system_clock::now() + timeout;
+    for (auto& connection : connections_) {
+        if (!connection->channel->WaitForConnected(deadline)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,107 @@
+// src/execution_report_hub.cpp
+#include "execution_report_hub.hpp"
+#include <algorithm>
+
+ExecutionSubscription::ExecutionSubscription(std::string trader_id,
+                                             size_t max_queued,
+                                             std::function<void()> on_ready)
+    : trader_id_(std::move(trader_id))
+    , max_queued_(std::max<size_t>(max_queued, 1))
+    , on_ready_(std::move(on_ready)) {}
+
+bool ExecutionSubscription::push(const order_service::ExecutionReport& report) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (overflowed_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (queue_.size() >= max_queued_) {
+        overflowed_.store(true, std::memory_order_release);
+        return false;
+    }
+    queue_.push_back(report);
+    return true;
+}
+
+std::optional<order_service::ExecutionReport> ExecutionSubscription::pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return std::nullopt;
+    }
+    auto report = std::move(queue_.front());
+    queue_.pop_front();
+    return report;
+}
+
+size_t ExecutionSubscription::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+std::shared_ptr<ExecutionSubscription> ExecutionReportHub::subscribe(const std::string& trader_id,
+                                                                     std::function<void()> on_ready,
+                                                                     size_t max_queued) {
+    auto subscription = std::make_shared<ExecutionSubscription>(trader_id, max_queued, std::move(on_ready));
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_[trader_id].push_back(subscription);
+    return subscription;
+}
+
+void ExecutionReportHub::unsubscribe(const std::shared_ptr<ExecutionSubscription>& subscription) {
+    {
+        std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+        subscription->on_ready_ = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = subscribers_.find(subscription->traderId());
+    if (it == subscribers_.end()) {
+        return;
+    }
+    auto& subscriptions = it->second;
+    subscriptions.erase(std::remove(subscriptions.begin(), subscriptions.end(), subscription),
+                        subscriptions.end());
+    if (subscriptions.empty()) {
+        subscribers_.erase(it);
+    }
+}
+
+void ExecutionReportHub::publish(const order_service::ExecutionReport& report) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(report.trader_id());
+    if (it == subscribers_.end()) {
+        return;
+    }
+    for (const auto& subscription : it->second) {
+        // Overflowed subscriptions are still woken so their stream can end
+        subscription->push(report);
+        if (!subscription->wake_pending_) {
+            subscription->wake_pending_ = true;
+            ready_.push_back(subscription);
+        }
+    }
+}
+
+void ExecutionReportHub::deliver() {
+    std::vector<std::shared_ptr<ExecutionSubscription>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ready_.empty()) {
+            return;
+        }
+        ready.swap(ready_);
+        for (const auto& subscription : ready) {
+            subscription->wake_pending_ = false;
+        }
+    }
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    for (const auto& subscription : ready) {
+        if (subscription->on_ready_) {
+            subscription->on_ready_();
+        }
+    }
+}
+
+bool ExecutionReportHub::hasSubscribers(const std::string& trader_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_.contains(trader_id);
+}
@@ -0,0 +1,149 @@
+// src/lane_scheduler.cpp
+#include "lane_scheduler.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+LaneScheduler::LaneScheduler(LaneConfig config) : config_(config) {}
+
+LaneScheduler::~LaneScheduler() {
+    stop();
+}
+
+int64_t LaneScheduler::nowNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LaneScheduler::setQueueDelayListener(QueueDelayListener listener) {
+    queue_delay_listener_ = std::move(listener);
+}
+
+void LaneScheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    for (size_t i = 0; i < std::max<size_t>(config_.order_entry_workers, 1); ++i) {
+        workers_.emplace_back(&LaneScheduler::orderEntryWorker, this);
+    }
+    for (size_t i = 0; i < std::max<size_t>(config_.query_workers, 1); ++i) {
+        workers_.emplace_back(&LaneScheduler::queryWorker, this);
+    }
+    spdlog::info("Lane scheduler started with {} order-entry and {} query workers ({}% query share)",
+                 std::max<size_t>(config_.order_entry_workers, 1), std::max<size_t>(config_.query_workers, 1),
+                 static_cast<int>(config_.query_share * 100));
+}
+
+void LaneScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    order_entry_ready_.notify_all();
+    query_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+bool LaneScheduler::submit(RequestPriority lane, LaneTask task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& lane_queue = queue(lane);
+        if (!running_ || lane_queue.size() >= config_.max_queued) {
+            return false;
+        }
+        lane_queue.push_back(Entry{std::move(task), nowNanos()});
+    }
+    if (lane == RequestPriority::Query) {
+        query_ready_.notify_one();
+    } else {
+        order_entry_ready_.notify_one();
+    }
+    return true;
+}
+
+size_t LaneScheduler::queued(RequestPriority lane) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queues_[static_cast<size_t>(lane)].size();
+}
+
+void LaneScheduler::run(RequestPriority lane, Entry& entry) {
+    if (queue_delay_listener_) {
+        queue_delay_listener_(lane, std::chrono::nanoseconds(nowNanos() - entry.enqueued_ns));
+    }
+    try {
+        entry.task();
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Lane task failed: {}", e.what());
+    }
+}
+
+void LaneScheduler::orderEntryWorker() {
+    auto& cancels = queue(RequestPriority::Cancel);
+    auto& orders = queue(RequestPriority::Order);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        order_entry_ready_.wait(lock, [&] { return !running_ || !cancels.empty() || !orders.empty(); });
+        if (cancels.empty() && orders.empty()) {
+            return;  // Stopped and drained
+        }
+
+        RequestPriority lane = cancels.empty() ? RequestPriority::Order : RequestPriority::Cancel;
+        auto& lane_queue = queue(lane);
+        Entry entry = std::move(lane_queue.front());
+        lane_queue.pop_front();
+
+        lock.unlock();
+        run(lane, entry);
+        lock.lock();
+    }
+}
+
+void LaneScheduler::queryWorker() {
+    auto& queries = queue(RequestPriority::Query);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        query_ready_.wait(lock, [&] { return !running_ || !queries.empty(); });
+        if (queries.empty()) {
+            return;  // Stopped and drained
+        }
+
+        // Pacing is skipped while draining on shutdown. A paced query's cost
+        // is only known once it has run, so the worker running one holds the
+        // pacing slot and the other query workers wait for it.
+        bool paced = running_ && config_.query_share > 0 && config_.query_share < 1;
+        if (paced && paced_query_running_) {
+            query_ready_.wait(lock);
+            continue;
+        }
+        int64_t now = nowNanos();
+        if (paced && now < query_not_before_ns_) {
+            query_ready_.wait_for(lock, std::chrono::nanoseconds(query_not_before_ns_ - now));
+            continue;
+        }
+
+        Entry entry = std::move(queries.front());
+        queries.pop_front();
+        paced_query_running_ = paced;
+
+        lock.unlock();
+        int64_t started = nowNanos();
+        run(RequestPriority::Query, entry);
+        int64_t busy = nowNanos() - started;
+        lock.lock();
+
+        if (paced) {
+            query_not_before_ns_ = std::max(query_not_before_ns_, started) +
+                                   static_cast<int64_t>(static_cast<double>(busy) / config_.query_share);
+            paced_query_running_ = false;
+            query_ready_.notify_all();
+        }
+    }
+}
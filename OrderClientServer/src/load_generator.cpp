@@ -0,0 +1,308 @@
+// src/load_generator.cpp
+#include "load_generator.hpp"
+#include "async_order_client.hpp"
+#include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double kTickSize = 0.01;
+
+    struct RestingOrder {
+        std::string order_id;
+        bool is_buy = false;
+    };
+
+    bool applied(order_service::OrderStatus status) {
+        return status != order_service::OrderStatus::REJECTED &&
+               status != order_service::OrderStatus::ERROR &&
+               status != order_service::OrderStatus::UNKNOWN;
+    }
+
+    class LoadClient {
+    public:
+        // The client's one channel comes from the factory when there is one
+        LoadClient(const LoadConfig& config, int index, const LoadGenerator::ChannelFactory& channels,
+                   const std::string& run_tag)
+            : config_(config)
+            , client_(channels ? std::make_unique<AsyncOrderClient>(
+                                     clientConfig(config), [&channels, index](size_t) { return channels(index); })
+                               : std::make_unique<AsyncOrderClient>(clientConfig(config)))
+            , id_prefix_("lg" + run_tag + "-" + std::to_string(index) + "-")
+            , trader_id_("loadgen" + std::to_string(index))
+            , rng_(config.seed + static_cast<uint64_t>(index))
+            , mix_(config.mix.begin(), config.mix.end())
+        {
+        }
+
+        // Sends on the schedule first, first + interval, ... until end
+        void send(Clock::time_point first, Clock::duration interval, Clock::time_point end) {
+            for (int64_t i = 0;; ++i) {
+                Clock::time_point intended = first + interval * i;
+                if (intended >= end) {
+                    break;
+                }
+                std::this_thread::sleep_until(intended);
+                send_lag_.record(Clock::now() - intended);
+                issue(intended);
+            }
+        }
+
+        // Blocks until every call has completed
+        void finish() {
+            while (outstanding_.load(std::memory_order_acquire) > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // Only valid after finish()
+        void addTo(LoadReport& report) const {
+            for (size_t i = 0; i < kLoadRpcCount; ++i) {
+                report.rpcs[i].sent += sent_[i];
+                report.rpcs[i].ok += stats_[i].ok;
+                report.rpcs[i].rejected += stats_[i].rejected;
+                report.rpcs[i].shed += stats_[i].shed;
+                report.rpcs[i].failed += stats_[i].failed;
+                report.rpcs[i].latency.merge(stats_[i].latency);
+            }
+            report.send_lag.merge(send_lag_);
+        }
+
+    private:
+        const LoadConfig& config_;
+        std::unique_ptr<AsyncOrderClient> client_;
+        std::string id_prefix_;
+        std::string trader_id_;
+        uint64_t next_order_ = 0;
+        std::atomic<uint64_t> outstanding_{0};
+
+        // Sending thread only
+        std::mt19937_64 rng_;
+        std::discrete_distribution<size_t> mix_;
+        std::array<uint64_t, kLoadRpcCount> sent_{};
+        LatencyHistogram send_lag_;
+        // Reused for every call; the client copies them into its own
+        order_service::OrderDetails order_;
+        order_service::CancelRequest cancel_;
+
+        // Completion thread only: the client has one channel, so its
+        // callbacks all run on that channel's thread
+        std::array<LoadRpcStats, kLoadRpcCount> stats_;
+
+        // Orders acknowledged as resting and not yet picked for a cancel or
+        // amend. Filled by the completion thread, drained by the sender.
+        std::mutex resting_mutex_;
+        std::vector<RestingOrder> resting_;
+
+        // Calls time out after the drain timeout, so finish() cannot hang
+        static OrderClientConfig clientConfig(const LoadConfig& config) {
+            OrderClientConfig client;
+            client.target = config.target;
+            client.channels = 1;
+            client.call_timeout = config.drain_timeout;
+            return client;
+        }
+
+        double restingPrice(bool is_buy) {
+            std::uniform_int_distribution<int> level(0, config_.price_levels - 1);
+            double ticks = 1.0 + level(rng_);
+            double price = config_.mid_price + (is_buy ? -ticks : ticks) * kTickSize;
+            return std::round(price / kTickSize) * kTickSize;
+        }
+
+        bool takeResting(RestingOrder& order) {
+            std::lock_guard<std::mutex> lock(resting_mutex_);
+            if (resting_.empty()) {
+                return false;
+            }
+            std::uniform_int_distribution<size_t> pick(0, resting_.size() - 1);
+            size_t index = pick(rng_);
+            order = std::move(resting_[index]);
+            resting_[index] = std::move(resting_.back());
+            resting_.pop_back();
+            return true;
+        }
+
+        void fillOrder(bool is_buy) {
+            order_.set_order_id(id_prefix_ + std::to_string(next_order_++));
+            order_.set_trader_id(trader_id_);
+            order_.set_stock_symbol(config_.symbol);
+            order_.set_price(restingPrice(is_buy));
+            order_.set_quantity(100);
+            order_.set_is_buy_order(is_buy);
+        }
+
+        void issue(Clock::time_point intended) {
+            auto rpc = static_cast<LoadRpc>(mix_(rng_));
+            RestingOrder target;
+            if (rpc != LoadRpc::New && !takeResting(target)) {
+                rpc = LoadRpc::New;
+            }
+            ++sent_[static_cast<size_t>(rpc)];
+            outstanding_.fetch_add(1, std::memory_order_relaxed);
+
+            if (rpc == LoadRpc::New) {
+                fillOrder(std::uniform_int_distribution<int>(0, 1)(rng_) == 0);
+                client_->submitOrder(order_, [this, intended, resting = RestingOrder{order_.order_id(), order_.is_buy_order()}](
+                                                const grpc::Status& status, order_service::OrderResponse& response) mutable {
+                    bool success = status.ok() && applied(response.status());
+                    if (success) {
+                        rest(std::move(resting));
+                    }
+                    record(LoadRpc::New, intended, status, success);
+                });
+                return;
+            }
+            cancel_.set_order_id(target.order_id);
+            cancel_.set_is_buy_order(target.is_buy);
+            cancel_.set_trader_id(trader_id_);
+            if (rpc == LoadRpc::Cancel) {
+                client_->cancelOrder(cancel_, [this, intended](const grpc::Status& status,
+                                                              order_service::CancelResponse& response) {
+                    record(LoadRpc::Cancel, intended, status,
+                           response.status() == order_service::OrderStatus::CANCELLED);
+                });
+                return;
+            }
+            // Drawn now, on the sending thread that owns the generator
+            fillOrder(target.is_buy);
+            client_->amendOrder(cancel_, order_, [this, intended, resting = RestingOrder{order_.order_id(), target.is_buy}](
+                                                    AsyncOrderClient::AmendResult& result) mutable {
+                // The amend completes when its replacement is answered
+                bool success = result.ok() && result.replaced && applied(result.replacement.status());
+                if (success) {
+                    rest(std::move(resting));
+                }
+                record(LoadRpc::Amend, intended, result.status, success);
+            });
+        }
+
+        void rest(RestingOrder order) {
+            std::lock_guard<std::mutex> lock(resting_mutex_);
+            resting_.push_back(std::move(order));
+        }
+
+        void record(LoadRpc rpc, Clock::time_point intended, const grpc::Status& status, bool success) {
+            LoadRpcStats& stats = stats_[static_cast<size_t>(rpc)];
+            if (!status.ok()) {
+                ++(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED ? stats.shed : stats.failed);
+            } else {
+                stats.latency.record(Clock::now() - intended);
+                ++(success ? stats.ok : stats.rejected);
+            }
+            outstanding_.fetch_sub(1, std::memory_order_release);
+        }
+    };
+}
+
+const char* loadRpcName(LoadRpc rpc) noexcept {
+    switch (rpc) {
+        case LoadRpc::New: return "new";
+        case LoadRpc::Cancel: return "cancel";
+        case LoadRpc::Amend: return "amend";
+    }
+    return "unknown";
+}
+
+std::array<uint32_t, kLoadRpcCount> LoadConfig::parseMix(const std::string& text) {
+    std::array<uint32_t, kLoadRpcCount> mix{};
+    std::istringstream in(text);
+    std::string field;
+    size_t count = 0;
+    while (std::getline(in, field, ':')) {
+        if (count == kLoadRpcCount || field.empty() ||
+            field.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("mix must be new:cancel:amend weights, got '" + text + "'");
+        }
+        mix[count++] = static_cast<uint32_t>(std::stoul(field));
+    }
+    if (count != kLoadRpcCount || mix[0] + mix[1] + mix[2] == 0) {
+        throw std::invalid_argument("mix must be new:cancel:amend weights, got '" + text + "'");
+    }
+    return mix;
+}
+
+uint64_t LoadReport::sent() const noexcept {
+    uint64_t total = 0;
+    for (const auto& rpc : rpcs) {
+        total += rpc.sent;
+    }
+    return total;
+}
+
+uint64_t LoadReport::answered() const noexcept {
+    uint64_t total = 0;
+    for (const auto& rpc : rpcs) {
+        total += rpc.ok + rpc.rejected;
+    }
+    return total;
+}
+
+LoadGenerator::LoadGenerator(LoadConfig config)
+    : LoadGenerator(std::move(config), nullptr)
+{
+}
+
+LoadGenerator::LoadGenerator(LoadConfig config, ChannelFactory channels)
+    : config_(std::move(config))
+    , channels_(std::move(channels))
+{
+    if (config_.clients < 1) {
+        throw std::invalid_argument("load needs at least one client");
+    }
+    if (!(config_.rate_per_second > 0.0) || !(config_.seconds > 0.0)) {
+        throw std::invalid_argument("load needs a positive rate and duration");
+    }
+    if (config_.mix[0] + config_.mix[1] + config_.mix[2] == 0) {
+        throw std::invalid_argument("load mix has no weight");
+    }
+    if (config_.price_levels < 1) {
+        throw std::invalid_argument("load needs at least one price level");
+    }
+}
+
+LoadReport LoadGenerator::run() {
+    // Order ids stay unique across runs against the same server
+    std::string run_tag = std::to_string(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() % 100'000'000);
+    auto duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config_.seconds));
+
+    std::vector<std::unique_ptr<LoadClient>> clients;
+    for (int i = 0; i < config_.clients; ++i) {
+        clients.push_back(std::make_unique<LoadClient>(config_, i, channels_, run_tag));
+    }
+
+    // Clients share one schedule, each offset into the interval, so the
+    // combined load arrives evenly at the target rate
+    auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config_.clients / config_.rate_per_second));
+    Clock::time_point start = Clock::now() + std::chrono::milliseconds(10);
+    Clock::time_point end = start + duration;
+    std::vector<std::thread> senders;
+    for (int i = 0; i < config_.clients; ++i) {
+        senders.emplace_back([&, i] {
+            clients[static_cast<size_t>(i)]->send(start + interval * i / config_.clients, interval, end);
+        });
+    }
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    LoadReport report;
+    report.send_seconds = std::chrono::duration<double>(std::max(Clock::now(), end) - start).count();
+    for (auto& client : clients) {
+        client->finish();
+        client->addTo(report);
+    }
+    return report;
+}
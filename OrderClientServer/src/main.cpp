@@ -4,12 +4,43 @@
 #include <grpcpp/grpcpp.h>
 #include "order_service.hpp"
 #include "order_client_server.hpp"
+#include "server_config.hpp"
+#include "metrics_http_server.hpp"
 #include <spdlog/spdlog.h>
-// Instead of specific sink headers, we'll just use the basic functionality
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <csignal>
+#include <thread>
+
+namespace {
+    // Log calls only enqueue; a single spdlog worker formats and writes, and
+    // the periodic flusher thread flushes. When the queue is full the oldest
+    // message is overwritten rather than blocking the caller.
+    void initLogging(const ServerConfig& config) {
+        spdlog::init_thread_pool(config.log_queue_size, 1);
+        auto logger = spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>("server");
+        spdlog::set_default_logger(logger);
+        spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [thread %t] %v");
+        spdlog::set_level(spdlog::level::from_str(config.log_level));
+        spdlog::flush_every(std::chrono::seconds(1));
+    }
+
+    // The signals the server handles are blocked in every thread, so that
+    // only the thread calling sigwait() sees them. Must run before any other
+    // thread is started, as new threads inherit the mask.
+    sigset_t handledSignals() {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGUSR1);
+        return signals;
+    }
+}
 
 class TradingServer {
 public:
-    TradingServer() {
+    explicit TradingServer(ServerConfig config) : config_(std::move(config)) {
         try {
             spdlog::info("Initializing TradingServer...");
             
@@ -20,7 +51,44 @@ public:
             }
             spdlog::info("OrderClientServer created successfully");
 
-            order_service_ = std::make_unique<OrderServiceImpl>(order_client_server_);
+            if (config_.order_log.mode != OrderLogMode::Off) {
+                order_client_server_->setOrderEventLog(std::make_shared<OrderEventLog>(config_.order_log));
+            }
+
+            std::shared_ptr<AdmissionController> admission;
+            if (config_.admission.max_in_flight > 0) {
+                admission = std::make_shared<AdmissionController>(config_.admission);
+                spdlog::info("Admission control: {} requests in flight, {} us target delay",
+                             config_.admission.max_in_flight, config_.admission.target_delay.count());
+            }
+
+            std::shared_ptr<RateLimiter> rate_limiter;
+            if (config_.rate_limit.enabled()) {
+                rate_limiter = std::make_shared<RateLimiter>(config_.rate_limit);
+                spdlog::info("Rate limits: {} msg/s per trader (burst {}), {} msg/s per connection (burst {})",
+                             config_.rate_limit.trader_rate, config_.rate_limit.trader_burst,
+                             config_.rate_limit.connection_rate, config_.rate_limit.connection_burst);
+            }
+
+            std::shared_ptr<LaneScheduler> lanes;
+            if (config_.lanes.order_entry_workers > 0) {
+                lanes = std::make_shared<LaneScheduler>(config_.lanes);
+            }
+
+            if (config_.trace_sample_every > 0) {
+                tracer_ = std::make_shared<RequestTracer>(config_.trace_sample_every);
+                spdlog::info("Tracing one request in {}; SIGUSR1 writes {}",
+                             config_.trace_sample_every, config_.trace_path);
+            }
+
+            std::shared_ptr<ServerMetrics> metrics;
+            if (!config_.metrics_address.empty()) {
+                metrics = std::make_shared<ServerMetrics>();
+            }
+
+            order_service_ = std::make_unique<OrderServiceImpl>(order_client_server_, nullptr,
+                                                                std::move(admission), std::move(rate_limiter),
+                                                                std::move(lanes), tracer_, std::move(metrics));
             if (!order_service_) {
                 throw std::runtime_error("Failed to create OrderServiceImpl");
             }
@@ -34,11 +102,16 @@ public:
 
     void Run() {
         try {
-            std::string server_address("0.0.0.0:50051");
+            const std::string& server_address = config_.listen_address;
             grpc::ServerBuilder builder;
             
             // Configure server
             builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
+            // Clients on this machine can skip the TCP stack. gRPC replaces a
+            // stale socket file left by an earlier run.
+            if (!config_.unix_socket_path.empty()) {
+                builder.AddListeningPort("unix:" + config_.unix_socket_path, grpc::InsecureServerCredentials());
+            }
             builder.RegisterService(order_service_.get());
             
             // Set server options
@@ -52,7 +125,30 @@ public:
             }
             
             spdlog::info("Server listening on {}", server_address);
+            if (!config_.unix_socket_path.empty()) {
+                spdlog::info("Server listening on unix socket {}", config_.unix_socket_path);
+            }
+            startMetricsEndpoint();
+
+            // SIGUSR1 dumps the request trace; SIGINT and SIGTERM also dump
+            // it and then shut the server down gracefully
+            std::thread signal_thread([this] {
+                sigset_t signals = handledSignals();
+                for (;;) {
+                    int signal = 0;
+                    if (sigwait(&signals, &signal) != 0) {
+                        continue;
+                    }
+                    dumpTrace();
+                    if (signal != SIGUSR1) {
+                        spdlog::info("Received signal {}, shutting down", signal);
+                        server_->Shutdown();
+                        return;
+                    }
+                }
+            });
             server_->Wait();
+            signal_thread.join();
         }
         catch (const std::exception& e) {
             spdlog::critical("Server error: {}", e.what());
@@ -74,26 +170,63 @@ public:
     }
 
 private:
+    // /metrics in Prometheus text format, and /trace with the sampled
+    // request traces when tracing is on
+    void startMetricsEndpoint() {
+        if (config_.metrics_address.empty()) {
+            return;
+        }
+        metrics_endpoint_ = std::make_unique<MetricsHttpServer>(config_.metrics_address);
+        metrics_endpoint_->handle("/metrics", [this] {
+            return MetricsHttpServer::Response{"text/plain; version=0.0.4", order_service_->renderMetrics()};
+        });
+        if (tracer_) {
+            metrics_endpoint_->handle("/trace", [this] {
+                return MetricsHttpServer::Response{"application/json", tracer_->chromeTraceJson()};
+            });
+        }
+        metrics_endpoint_->start();
+        spdlog::info("Metrics endpoint listening on {}", config_.metrics_address);
+    }
+
+    void dumpTrace() {
+        if (!tracer_) {
+            return;
+        }
+        if (tracer_->writeChromeTrace(config_.trace_path)) {
+            spdlog::info("Wrote request trace to {} ({} requests traced so far)",
+                         config_.trace_path, tracer_->recorded());
+        }
+        spdlog::info("Request stage latencies:\n{}", tracer_->stageSummary());
+    }
+
+    ServerConfig config_;
+    std::shared_ptr<RequestTracer> tracer_;
     std::shared_ptr<OrderClientServer> order_client_server_;
     std::unique_ptr<OrderServiceImpl> order_service_;
     std::unique_ptr<grpc::Server> server_;
+    std::unique_ptr<MetricsHttpServer> metrics_endpoint_;
 };
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     try {
-        // Initialize logging with more detailed pattern
-        spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [thread %t] %v");
-        spdlog::set_level(spdlog::level::debug);
+        sigset_t signals = handledSignals();
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        ServerConfig config = ServerConfig::fromEnvironment();
+        initLogging(config);
         
         spdlog::info("Starting trading server...");
         
-        TradingServer server;
+        TradingServer server(std::move(config));
         server.Run();
         
+        spdlog::shutdown();
         return 0;
     }
     catch (const std::exception& e) {
         spdlog::critical("Fatal error: {}", e.what());
+        spdlog::shutdown();
         return 1;
     }
 }
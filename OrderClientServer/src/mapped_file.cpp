@@ -0,0 +1,61 @@
+// src/mapped_file.cpp
+#include "mapped_file.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    std::runtime_error fileError(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+}
+
+MappedFile::MappedFile(const std::string& path)
+    : path_(path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw fileError("cannot open", path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        auto error = fileError("cannot stat", path);
+        ::close(fd);
+        throw error;
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    // An empty file has nothing to map
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            auto error = fileError("cannot map", path);
+            ::close(fd);
+            throw error;
+        }
+        data_ = static_cast<const char*>(mapped);
+        ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    }
+    // The mapping keeps the file alive
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+void MappedFile::release(size_t offset) noexcept {
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t end = std::min(offset, size_) / page * page;
+    if (!data_ || end <= released_) {
+        return;
+    }
+    ::madvise(const_cast<char*>(data_) + released_, end - released_, MADV_DONTNEED);
+    released_ = end;
+}
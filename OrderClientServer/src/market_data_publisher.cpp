@@ -0,0 +1,196 @@
+// src/market_data_publisher.cpp
+#include "market_data_publisher.hpp"
+#include <google/protobuf/arena.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace {
+    // Topic key for subscribers that asked for every symbol
+    const std::string kAllSymbols;
+}
+
+BookSubscription::BookSubscription(std::string symbol, size_t max_queued, std::function<void()> on_ready)
+    : symbol_(std::move(symbol))
+    , max_queued_(std::max<size_t>(max_queued, 1))
+    , on_ready_(std::move(on_ready)) {}
+
+void BookSubscription::push(SerializedBookUpdate update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (queue_.size() >= max_queued_) {
+        queue_.pop_front();
+        conflated_.fetch_add(1, std::memory_order_relaxed);
+    }
+    queue_.push_back(std::move(update));
+}
+
+SerializedBookUpdate BookSubscription::pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return nullptr;
+    }
+    auto update = std::move(queue_.front());
+    queue_.pop_front();
+    return update;
+}
+
+size_t BookSubscription::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+MarketDataPublisher::MarketDataPublisher(std::shared_ptr<OrderClientServer> server,
+                                         std::chrono::milliseconds min_interval)
+    : server_(std::move(server))
+    , min_interval_(min_interval) {
+    if (!server_) {
+        throw std::invalid_argument("Server cannot be null");
+    }
+}
+
+MarketDataPublisher::~MarketDataPublisher() {
+    stop();
+}
+
+void MarketDataPublisher::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&MarketDataPublisher::run, this);
+}
+
+void MarketDataPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    dirty_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::shared_ptr<BookSubscription> MarketDataPublisher::subscribe(const std::string& symbol,
+                                                                 std::function<void()> on_ready,
+                                                                 size_t max_queued) {
+    auto subscription = std::make_shared<BookSubscription>(symbol, max_queued, std::move(on_ready));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& topic = topics_[symbol];
+        topic.subscribers.push_back(subscription);
+
+        // Late joiners start from the last published state; a topic that has
+        // never been published gets built on the next pass
+        if (topic.latest) {
+            subscription->push(topic.latest);
+            if (subscription->on_ready_) {
+                subscription->on_ready_();
+            }
+        } else {
+            topic.dirty = true;
+            has_dirty_ = true;
+        }
+    }
+    dirty_cv_.notify_one();
+    return subscription;
+}
+
+void MarketDataPublisher::unsubscribe(const std::shared_ptr<BookSubscription>& subscription) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscription->on_ready_ = nullptr;
+
+    auto it = topics_.find(subscription->symbol());
+    if (it == topics_.end()) {
+        return;
+    }
+    auto& subscribers = it->second.subscribers;
+    subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), subscription),
+                      subscribers.end());
+    if (subscribers.empty()) {
+        topics_.erase(it);
+    }
+}
+
+void MarketDataPublisher::markDirty(const std::string& symbol) {
+    bool marked = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto* key : {&symbol, &kAllSymbols}) {
+            auto it = topics_.find(*key);
+            if (it != topics_.end()) {
+                it->second.dirty = true;
+                marked = true;
+            }
+        }
+        has_dirty_ = has_dirty_ || marked;
+    }
+    if (marked) {
+        dirty_cv_.notify_one();
+    }
+}
+
+size_t MarketDataPublisher::publishPending() {
+    std::vector<std::string> symbols;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [symbol, topic] : topics_) {
+            if (topic.dirty) {
+                topic.dirty = false;
+                symbols.push_back(symbol);
+            }
+        }
+        has_dirty_ = false;
+    }
+
+    google::protobuf::Arena arena;
+    for (const auto& symbol : symbols) {
+        // One book copy and one serialization per topic, however many
+        // subscribers are attached. The copy lives on the arena, which is
+        // reset once the bytes are out.
+        order_service::ViewOrderBookRequest request;
+        request.set_symbol(symbol);
+        auto* book = google::protobuf::Arena::CreateMessage<order_service::ViewOrderBookResponse>(&arena);
+        server_->getOrderBook(request, book);
+        auto update = std::make_shared<const std::string>(book->SerializeAsString());
+        arena.Reset();
+        serialized_.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = topics_.find(symbol);
+        if (it == topics_.end()) {
+            continue;  // Last subscriber left while the update was built
+        }
+        it->second.latest = update;
+        for (const auto& subscription : it->second.subscribers) {
+            subscription->push(update);
+            if (subscription->on_ready_) {
+                subscription->on_ready_();
+            }
+        }
+    }
+    return symbols.size();
+}
+
+void MarketDataPublisher::run() {
+    spdlog::info("Market data publisher started");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        dirty_cv_.wait(lock, [this] { return !running_ || has_dirty_; });
+        if (!running_) {
+            break;
+        }
+
+        lock.unlock();
+        try {
+            publishPending();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to publish order book update: {}", e.what());
+        }
+        // Coalesce bursts of book changes into one update per interval
+        std::this_thread::sleep_for(min_interval_);
+        lock.lock();
+    }
+    spdlog::info("Market data publisher stopped");
+}
@@ -0,0 +1,175 @@
+// src/metrics_http_server.cpp
+#include "metrics_http_server.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t kMaxRequestBytes = 8192;
+    constexpr int kPollIntervalMs = 200;    // How quickly stop() is noticed
+    constexpr int kSocketTimeoutSeconds = 2;
+
+    const char* statusText(int status) {
+        switch (status) {
+            case 200: return "OK";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 400: return "Bad Request";
+            default: return "Internal Server Error";
+        }
+    }
+
+    void sendAll(int socket, const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (result <= 0) {
+                if (result < 0 && errno == EINTR) {
+                    continue;
+                }
+                return;  // Scraper went away or timed out; nothing to recover
+            }
+            sent += static_cast<size_t>(result);
+        }
+    }
+
+    void sendResponse(int socket, int status, const std::string& content_type, const std::string& body) {
+        sendAll(socket, fmt::format("HTTP/1.0 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\n"
+                                    "Connection: close\r\n\r\n",
+                                    status, statusText(status), content_type, body.size()));
+        sendAll(socket, body);
+    }
+}
+
+MetricsHttpServer::MetricsHttpServer(std::string address) : address_(std::move(address)) {}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop();
+}
+
+void MetricsHttpServer::handle(const std::string& path, Handler handler) {
+    handlers_[path] = std::move(handler);
+}
+
+void MetricsHttpServer::start() {
+    if (running_) {
+        return;
+    }
+    auto colon = address_.rfind(':');
+    if (colon == std::string::npos) {
+        throw std::runtime_error("Metrics address must be host:port, got '" + address_ + "'");
+    }
+    std::string host = address_.substr(0, colon);
+    std::string service = address_.substr(colon + 1);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* addresses = nullptr;
+    if (int error = getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &addresses)) {
+        throw std::runtime_error("Cannot resolve metrics address " + address_ + ": " + gai_strerror(error));
+    }
+    for (addrinfo* candidate = addresses; candidate; candidate = candidate->ai_next) {
+        int fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(fd, candidate->ai_addr, candidate->ai_addrlen) == 0 && ::listen(fd, 16) == 0) {
+            listen_fd_ = fd;
+            break;
+        }
+        ::close(fd);
+    }
+    freeaddrinfo(addresses);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error("Cannot listen on metrics address " + address_ + ": " + std::strerror(errno));
+    }
+
+    sockaddr_storage bound{};
+    socklen_t length = sizeof(bound);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&bound), &length);
+    port_ = ntohs(bound.ss_family == AF_INET6 ? reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port
+                                              : reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+
+    running_ = true;
+    thread_ = std::thread(&MetricsHttpServer::serve, this);
+}
+
+void MetricsHttpServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    thread_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+}
+
+void MetricsHttpServer::serve() {
+    pollfd listener{listen_fd_, POLLIN, 0};
+    while (running_.load(std::memory_order_relaxed)) {
+        if (poll(&listener, 1, kPollIntervalMs) <= 0) {
+            continue;
+        }
+        int client = ::accept(listen_fd_, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        timeval timeout{kSocketTimeoutSeconds, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        respond(client);
+        ::close(client);
+    }
+}
+
+void MetricsHttpServer::respond(int client) {
+    // Only the request line matters; headers are read and ignored
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes) {
+        ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    auto line_end = request.find("\r\n");
+    auto first_space = request.find(' ');
+    auto second_space = first_space == std::string::npos ? std::string::npos : request.find(' ', first_space + 1);
+    if (line_end == std::string::npos || second_space == std::string::npos || second_space > line_end) {
+        sendResponse(client, 400, "text/plain", "Bad request\n");
+        return;
+    }
+    if (request.compare(0, first_space, "GET") != 0) {
+        sendResponse(client, 405, "text/plain", "Only GET is supported\n");
+        return;
+    }
+    std::string path = request.substr(first_space + 1, second_space - first_space - 1);
+    path = path.substr(0, path.find('?'));
+
+    auto handler = handlers_.find(path);
+    if (handler == handlers_.end()) {
+        sendResponse(client, 404, "text/plain", "Not found\n");
+        return;
+    }
+    try {
+        auto response = handler->second();
+        sendResponse(client, 200, response.content_type, response.body);
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Metrics handler for {} failed: {}", path, e.what());
+        sendResponse(client, 500, "text/plain", "Internal error\n");
+    }
+}
@@ -0,0 +1,233 @@
+// src/order_capture.cpp
+#include "order_capture.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t kWriteBuffer = 1 << 20;
+
+    std::runtime_error captureError(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    std::runtime_error malformed(const std::string& path, const std::string& why) {
+        return std::runtime_error("malformed order capture " + path + ": " + why);
+    }
+
+    CaptureHeader makeHeader(int64_t price_scale) {
+        CaptureHeader header{};
+        std::memcpy(header.magic, kCaptureMagic, sizeof(header.magic));
+        header.version = kCaptureVersion;
+        header.header_size = sizeof(CaptureHeader);
+        header.record_size = sizeof(CaptureRecord);
+        header.records_offset = sizeof(CaptureHeader);
+        header.price_scale = price_scale;
+        return header;
+    }
+}
+
+CaptureWriter::CaptureWriter(const std::string& path, int64_t price_scale)
+    : path_(path)
+    , buffer_(kWriteBuffer)
+    , price_scale_(price_scale)
+{
+    if (price_scale_ <= 0) {
+        throw std::invalid_argument("capture price scale must be positive");
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw captureError("cannot create", path);
+    }
+    std::setvbuf(file_, buffer_.data(), _IOFBF, buffer_.size());
+    // Rewritten with the counts and offsets on close()
+    CaptureHeader header = makeHeader(price_scale_);
+    put(&header, sizeof(header));
+}
+
+CaptureWriter::~CaptureWriter() {
+    if (file_) {
+        try {
+            close();
+        }
+        catch (const std::exception&) {
+        }
+    }
+}
+
+void CaptureWriter::writeNew(int64_t timestamp_ns, std::string_view order_id, std::string_view trader_id,
+                             std::string_view symbol, double price, int32_t quantity, bool is_buy) {
+    CaptureRecord record{};
+    record.timestamp_ns = timestamp_ns;
+    record.price = toPrice(price);
+    setOrderId(record.order_id, order_id);
+    record.symbol_ref = intern(symbol);
+    record.trader_ref = intern(trader_id);
+    record.quantity = quantity;
+    record.type = CaptureType::New;
+    record.is_buy = is_buy;
+    write(record);
+}
+
+void CaptureWriter::writeCancel(int64_t timestamp_ns, std::string_view order_id, std::string_view trader_id,
+                                std::string_view symbol, bool is_buy) {
+    CaptureRecord record{};
+    record.timestamp_ns = timestamp_ns;
+    setOrderId(record.order_id, order_id);
+    record.symbol_ref = symbol.empty() ? kNoCaptureRef : intern(symbol);
+    record.trader_ref = intern(trader_id);
+    record.type = CaptureType::Cancel;
+    record.is_buy = is_buy;
+    write(record);
+}
+
+void CaptureWriter::writeAmend(int64_t timestamp_ns, std::string_view order_id, std::string_view new_order_id,
+                               std::string_view trader_id, std::string_view symbol, double price,
+                               int32_t quantity, bool is_buy) {
+    CaptureRecord record{};
+    record.timestamp_ns = timestamp_ns;
+    record.price = toPrice(price);
+    setOrderId(record.order_id, new_order_id);
+    setOrderId(record.replaces_order_id, order_id);
+    record.symbol_ref = intern(symbol);
+    record.trader_ref = intern(trader_id);
+    record.quantity = quantity;
+    record.type = CaptureType::Amend;
+    record.is_buy = is_buy;
+    write(record);
+}
+
+void CaptureWriter::write(const CaptureRecord& record) {
+    if (!file_) {
+        throw std::runtime_error("capture " + path_ + " is closed");
+    }
+    put(&record, sizeof(record));
+    ++record_count_;
+}
+
+void CaptureWriter::setOrderId(char (&field)[kCaptureOrderIdSize], std::string_view order_id) {
+    if (order_id.size() > kCaptureOrderIdSize) {
+        throw std::invalid_argument("order id " + std::string(order_id) + " is longer than " +
+                                    std::to_string(kCaptureOrderIdSize) + " bytes");
+    }
+    std::memset(field, 0, kCaptureOrderIdSize);
+    std::memcpy(field, order_id.data(), order_id.size());
+}
+
+uint32_t CaptureWriter::intern(std::string_view text) {
+    if (auto it = string_refs_.find(text); it != string_refs_.end()) {
+        return it->second;
+    }
+    if (strings_.size() >= kNoCaptureRef) {
+        throw std::runtime_error("capture " + path_ + " has too many distinct strings");
+    }
+    auto ref = static_cast<uint32_t>(strings_.size());
+    const std::string& stored = strings_.emplace_back(text);
+    string_refs_.emplace(stored, ref);
+    return ref;
+}
+
+void CaptureWriter::close() {
+    if (!file_) {
+        return;
+    }
+    CaptureHeader header = makeHeader(price_scale_);
+    header.record_count = record_count_;
+    header.string_count = static_cast<uint32_t>(strings_.size());
+    header.dictionary_offset = header.records_offset + record_count_ * sizeof(CaptureRecord);
+    for (const std::string& text : strings_) {
+        auto length = static_cast<uint32_t>(text.size());
+        put(&length, sizeof(length));
+        put(text.data(), text.size());
+        header.dictionary_size += sizeof(length) + text.size();
+    }
+
+    bool ok = std::fseek(file_, 0, SEEK_SET) == 0;
+    ok = ok && std::fwrite(&header, sizeof(header), 1, file_) == 1;
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    if (!ok) {
+        throw captureError("cannot finish", path_);
+    }
+}
+
+int64_t CaptureWriter::toPrice(double price) const {
+    double scaled = std::round(price * static_cast<double>(price_scale_));
+    // 2^63 is exactly representable, so the comparison is exact
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= 9223372036854775808.0) {
+        throw std::invalid_argument("price " + std::to_string(price) + " does not fit the capture's price scale");
+    }
+    return static_cast<int64_t>(scaled);
+}
+
+void CaptureWriter::put(const void* data, size_t size) {
+    if (size > 0 && std::fwrite(data, size, 1, file_) != 1) {
+        throw captureError("cannot write", path_);
+    }
+}
+
+CaptureReader::CaptureReader(const std::string& path)
+    : file_(path)
+{
+    std::string_view data = file_.data();
+    if (data.size() < sizeof(CaptureHeader)) {
+        throw malformed(path, "shorter than its header");
+    }
+    std::memcpy(&header_, data.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, kCaptureMagic, sizeof(header_.magic)) != 0) {
+        throw malformed(path, "bad magic");
+    }
+    if (header_.version != kCaptureVersion) {
+        throw malformed(path, "unsupported version " + std::to_string(header_.version));
+    }
+    if (header_.header_size < sizeof(CaptureHeader) || header_.record_size != sizeof(CaptureRecord) ||
+        header_.flags != 0 || header_.price_scale <= 0) {
+        throw malformed(path, "unsupported header fields");
+    }
+    // Records are read in place, so they must be aligned within the
+    // page-aligned mapping
+    if (header_.records_offset < header_.header_size || header_.records_offset % alignof(CaptureRecord) != 0 ||
+        header_.records_offset > data.size() ||
+        header_.record_count > (data.size() - header_.records_offset) / sizeof(CaptureRecord)) {
+        throw malformed(path, "records run past the end of the file");
+    }
+    if (header_.dictionary_offset < header_.records_offset + header_.record_count * sizeof(CaptureRecord) ||
+        header_.dictionary_offset > data.size() ||
+        header_.dictionary_size > data.size() - header_.dictionary_offset) {
+        throw malformed(path, "dictionary runs past the end of the file");
+    }
+    records_ = {reinterpret_cast<const CaptureRecord*>(data.data() + header_.records_offset),
+                static_cast<size_t>(header_.record_count)};
+
+    // Every entry takes at least its length, so a count the dictionary
+    // cannot hold is rejected before anything is allocated for it
+    if (header_.string_count > header_.dictionary_size / sizeof(uint32_t)) {
+        throw malformed(path, "more strings than the dictionary can hold");
+    }
+    std::string_view dictionary = data.substr(header_.dictionary_offset, header_.dictionary_size);
+    strings_.reserve(header_.string_count);
+    for (uint32_t i = 0; i < header_.string_count; ++i) {
+        uint32_t length = 0;
+        if (dictionary.size() < sizeof(length)) {
+            throw malformed(path, "dictionary is truncated");
+        }
+        std::memcpy(&length, dictionary.data(), sizeof(length));
+        dictionary.remove_prefix(sizeof(length));
+        if (dictionary.size() < length) {
+            throw malformed(path, "dictionary is truncated");
+        }
+        strings_.push_back(dictionary.substr(0, length));
+        dictionary.remove_prefix(length);
+    }
+}
+
+std::string_view CaptureReader::string(uint32_t ref) const {
+    if (ref == kNoCaptureRef) {
+        return {};
+    }
+    if (ref >= strings_.size()) {
+        throw std::out_of_range("capture string " + std::to_string(ref) + " is past the dictionary");
+    }
+    return strings_[ref];
+}
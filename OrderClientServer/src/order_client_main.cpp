@@ -4,11 +4,16 @@
 #include <string>
 #include <vector>
 #include <chrono>
-#include <thread>
 #include <filesystem>
 #include <iomanip>
+#include <optional>
 #include <grpcpp/grpcpp.h>
 #include "order_service.grpc.pb.h"
+#include "async_order_client.hpp"
+#include "load_generator.hpp"
+#include "order_capture.hpp"
+#include "order_file_reader.hpp"
+#include "order_replayer.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -20,37 +25,198 @@ using grpc::Status;
 using namespace order_service;
 namespace fs = std::filesystem;
 
-std::string getServerAddress() {
-    // Check environment variables first
-    const char* host = std::getenv("SERVER_HOST");
-    const char* port = std::getenv("SERVER_PORT");
-    
-    if (host && port) {
-        return std::string(host) + ":" + std::string(port);
-    } else if (host) {
-        return std::string(host) + ":50051";
+fs::path findOrderFile(const std::string& filename) {
+    fs::path path = filename;
+    if (!fs::exists(path)) {
+        path = fs::current_path() / "data" / filename;
     }
-    
-    // Fallback to default
-    return "localhost:50051";
+    spdlog::info("Attempting to read orders from: {}", path.string());
+    return path;
 }
 
-class OrderClient {
+// The entries of an order file, one at a time, in any format
+// orderFileFormatFor() knows. NDJSON and CSV files are streamed and binary
+// captures read in place, so the first entry is ready at once; a JSON
+// document is parsed whole first. Only captures hold cancels and amends.
+// Unparseable entries are logged, counted and skipped.
+class OrderFileSource {
 public:
-    OrderClient(const std::string& server_address) {
-        spdlog::info("Connecting to server at {}", server_address);
+    // Throws std::runtime_error if the file cannot be read
+    explicit OrderFileSource(const fs::path& path)
+        : format_(orderFileFormatFor(path.string()))
+    {
+        if (format_ == OrderFileFormat::Capture) {
+            capture_.emplace(path.string());
+        } else if (format_ != OrderFileFormat::Json) {
+            reader_.emplace(path.string(), format_);
+        } else {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open file: " + path.string());
+            }
+            file >> orders_;
+            if (!orders_.contains("orders")) {
+                throw std::runtime_error("JSON file does not contain 'orders' array");
+            }
+        }
+    }
+
+    // Fills request, which should arrive cleared, with the next entry
+    bool next(ReplayRequest& request) {
+        switch (format_) {
+            case OrderFileFormat::Capture:
+                return nextCaptured(request);
+            case OrderFileFormat::Json:
+                return nextJson(request);
+            default:
+                return nextLine(request);
+        }
+    }
+
+    [[nodiscard]] uint64_t skipped() const noexcept { return skipped_; }
+
+private:
+    OrderFileFormat format_;
+    std::optional<OrderFileReader> reader_;
+    std::optional<CaptureReader> capture_;
+    json orders_;
+    size_t position_ = 0;
+    uint64_t skipped_ = 0;
+
+    bool nextLine(ReplayRequest& request) {
+        for (;;) {
+            switch (reader_->next(request.order)) {
+                case ReadResult::Order:
+                    return true;
+                case ReadResult::End:
+                    return false;
+                case ReadResult::Malformed:
+                    spdlog::error("Error parsing line {}: {}", reader_->lineNumber(), reader_->error());
+                    request.clear();
+                    ++skipped_;
+                    break;
+            }
+        }
+    }
 
-        auto channel = grpc::CreateChannel(
-            server_address,
-            grpc::InsecureChannelCredentials()
-        );
+    bool nextJson(ReplayRequest& request) {
+        const json& entries = orders_["orders"];
+        while (position_ < entries.size()) {
+            const json& order = entries[position_++];
+            try {
+                auto* details = request.order.mutable_details();
+                details->set_order_id(order.at("order_id").get<std::string>());
+                details->set_trader_id(order.at("trader_id").get<std::string>());
+                details->set_stock_symbol(order.at("symbol").get<std::string>());
+                details->set_price(order.at("price").get<double>());
+                details->set_quantity(order.at("quantity").get<int>());
+                details->set_is_buy_order(order.at("is_buy").get<bool>());
+                return true;
+            }
+            catch (const json::exception& e) {
+                spdlog::error("Error parsing order {}: {}", position_ - 1, e.what());
+                request.clear();
+                ++skipped_;
+            }
+        }
+        return false;
+    }
+
+    bool nextCaptured(ReplayRequest& request) {
+        auto records = capture_->records();
+        while (position_ < records.size()) {
+            const CaptureRecord& record = records[position_++];
+            try {
+                fromCapture(record, request);
+                return true;
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Error reading record {}: {}", position_ - 1, e.what());
+                request.clear();
+                ++skipped_;
+            }
+        }
+        return false;
+    }
+
+    void fromCapture(const CaptureRecord& record, ReplayRequest& request) const {
+        const CaptureReader& capture = *capture_;
+        if (record.type == CaptureType::Cancel || record.type == CaptureType::Amend) {
+            auto& cancel = request.cancel;
+            cancel.set_order_id(std::string(record.type == CaptureType::Cancel ? record.orderId()
+                                                                                : record.replacesOrderId()));
+            cancel.set_trader_id(std::string(capture.string(record.trader_ref)));
+            cancel.set_is_buy_order(record.is_buy != 0);
+        }
+        if (record.type == CaptureType::New || record.type == CaptureType::Amend) {
+            auto* details = request.order.mutable_details();
+            details->set_order_id(std::string(record.orderId()));
+            details->set_trader_id(std::string(capture.string(record.trader_ref)));
+            details->set_stock_symbol(std::string(capture.string(record.symbol_ref)));
+            details->set_price(capture.price(record));
+            details->set_quantity(record.quantity);
+            details->set_is_buy_order(record.is_buy != 0);
+        }
+        switch (record.type) {
+            case CaptureType::New: request.kind = ReplayKind::New; break;
+            case CaptureType::Cancel: request.kind = ReplayKind::Cancel; break;
+            case CaptureType::Amend: request.kind = ReplayKind::Amend; break;
+            default:
+                throw std::runtime_error("unknown record type " + std::to_string(static_cast<int>(record.type)));
+        }
+    }
+};
 
-        // Wait for connection
-        if (!channel->WaitForConnected(std::chrono::system_clock::now() + 5s)) {
-            throw std::runtime_error("Failed to connect to server");
+// Rewrites any order file as a binary capture. Entries carry no timestamps
+// outside captures, so converted ones are written with 0.
+int convertOrderFile(const std::string& input, const std::string& output) {
+    OrderFileSource source(findOrderFile(input));
+    CaptureWriter writer(output);
+    ReplayRequest request;
+    size_t unwritable = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (;;) {
+        request.clear();
+        if (!source.next(request)) {
+            break;
+        }
+        const auto& order = request.order.details();
+        const auto& cancel = request.cancel;
+        try {
+            switch (request.kind) {
+                case ReplayKind::New:
+                    writer.writeNew(0, order.order_id(), order.trader_id(), order.stock_symbol(),
+                                    order.price(), order.quantity(), order.is_buy_order());
+                    break;
+                case ReplayKind::Cancel:
+                    writer.writeCancel(0, cancel.order_id(), cancel.trader_id(), {}, cancel.is_buy_order());
+                    break;
+                case ReplayKind::Amend:
+                    writer.writeAmend(0, cancel.order_id(), order.order_id(), order.trader_id(),
+                                      order.stock_symbol(), order.price(), order.quantity(), order.is_buy_order());
+                    break;
+            }
+        }
+        catch (const std::invalid_argument& e) {
+            spdlog::error("Cannot capture entry: {}", e.what());
+            ++unwritable;
         }
+    }
+    writer.close();
+    spdlog::info("Wrote {} records to {} in {:.3f} s ({} unparseable and {} uncapturable entries skipped)",
+                 writer.recordCount(), output,
+                 std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count(),
+                 source.skipped(), unwritable);
+    return 0;
+}
 
-        stub_ = OrderService::NewStub(channel);
+class OrderClient {
+public:
+    // One connection is plenty for a command line client
+    explicit OrderClient(OrderClientConfig config)
+        : client_(connectionConfig(std::move(config)))
+        , stub_(OrderService::NewStub(client_.channel()))
+    {
         spdlog::info("Connected to server successfully");
     }
 
@@ -60,22 +226,18 @@ public:
                     double price,
                     int quantity,
                     bool is_buy) {
-        OrderRequest request;
-        auto* details = request.mutable_details();
-        details->set_order_id(order_id);
-        details->set_trader_id(trader_id);
-        details->set_stock_symbol(stock_symbol);
-        details->set_price(price);
-        details->set_quantity(quantity);
-        details->set_is_buy_order(is_buy);
-
-        OrderResponse response;
-        ClientContext context;
+        OrderDetails details;
+        details.set_order_id(order_id);
+        details.set_trader_id(trader_id);
+        details.set_stock_symbol(stock_symbol);
+        details.set_price(price);
+        details.set_quantity(quantity);
+        details.set_is_buy_order(is_buy);
 
         spdlog::info("Submitting order: ID={}, Symbol={}, Price={}, Qty={}, Side={}",
                     order_id, stock_symbol, price, quantity, is_buy ? "BUY" : "SELL");
 
-        Status status = stub_->SubmitOrder(&context, request, &response);
+        auto [status, response] = client_.submitOrder(details).get();
 
         if (status.ok()) {
             spdlog::info("Order submitted successfully:");
@@ -83,6 +245,9 @@ public:
             if (response.status() == OrderStatus::FULLY_FILLED) {
                 spdlog::info("Matched Price: {}", response.matched_price());
                 spdlog::info("Matched Quantity: {}", response.matched_quantity());
+            } else if (response.status() == OrderStatus::REJECTED) {
+                spdlog::warn("Rejected ({}): {}", RejectReason_Name(response.reject_reason()), response.message());
+                return false;
             }
             return true;
         }
@@ -97,12 +262,9 @@ public:
         request.set_is_buy_order(is_buy);
         request.set_trader_id("system");  // You might want to make this configurable
 
-        CancelResponse response;
-        ClientContext context;
-
         spdlog::info("Cancelling order: ID={}", order_id);
 
-        Status status = stub_->CancelOrder(&context, request, &response);
+        auto [status, response] = client_.cancelOrder(request).get();
 
         if (status.ok()) {
             spdlog::info("Cancel request result: {}", OrderStatus_Name(response.status()));
@@ -113,17 +275,37 @@ public:
         return false;
     }
 
-    bool viewOrderBook(const std::string& symbol = "") {
-        ViewOrderBookRequest request;
-        request.set_symbol(symbol);
+    bool getOrderStatus(const std::string& order_id) {
+        auto [status, response] = client_.getOrderStatus(order_id).get();
 
-        ViewOrderBookResponse response;
-        ClientContext context;
+        if (status.ok()) {
+            if (response.status() == OrderStatus::UNKNOWN) {
+                spdlog::info("Order {} not found", order_id);
+                return false;
+            }
+            spdlog::info("Order {}: {} {} {} @ {}",
+                         order_id,
+                         OrderStatus_Name(response.status()),
+                         response.details().is_buy_order() ? "BUY" : "SELL",
+                         response.details().stock_symbol(),
+                         response.details().price());
+            spdlog::info("Filled {} of {}, remaining {}, last fill price {}",
+                         response.filled_quantity(),
+                         response.details().quantity(),
+                         response.remaining_quantity(),
+                         response.last_fill_price());
+            return true;
+        }
 
+        spdlog::error("RPC failed: {}", status.error_message());
+        return false;
+    }
+
+    bool viewOrderBook(const std::string& symbol = "") {
         spdlog::info("Requesting order book{}...",
                      symbol.empty() ? "" : " for symbol " + symbol);
 
-        Status status = stub_->ViewOrderBook(&context, request, &response);
+        auto [status, response] = client_.viewOrderBook(symbol).get();
 
         if (status.ok()) {
             // Print buy orders
@@ -183,53 +365,91 @@ public:
         return false;
     }
 
-    bool processOrdersFromFile(const std::string& filename) {
-        try {
-            // Construct path to data directory
-            fs::path dataPath = fs::current_path() / "data" / filename;
+    bool streamSnapshot(const std::string& symbol = "", int chunk_size = 0) {
+        OrderBookSnapshotRequest request;
+        request.set_symbol(symbol);
+        request.set_max_orders_per_chunk(chunk_size);
+
+        ClientContext context;
+        spdlog::info("Requesting chunked order book snapshot{}...",
+                     symbol.empty() ? "" : " for symbol " + symbol);
 
-            spdlog::info("Attempting to read orders from: {}", dataPath.string());
+        auto reader = stub_->StreamOrderBookSnapshot(&context, request);
 
-            std::ifstream file(dataPath);
-            if (!file.is_open()) {
-                spdlog::error("Failed to open file: {}", dataPath.string());
-                return false;
+        OrderBookSnapshotChunk chunk;
+        int chunks = 0;
+        int buy_orders = 0;
+        int sell_orders = 0;
+        while (reader->Read(&chunk)) {
+            ++chunks;
+            for (const auto& entry : chunk.buy_orders()) {
+                printSnapshotRow("BUY", entry);
             }
+            for (const auto& entry : chunk.sell_orders()) {
+                printSnapshotRow("SELL", entry);
+            }
+            buy_orders += chunk.buy_orders_size();
+            sell_orders += chunk.sell_orders_size();
+        }
 
-            json orders;
-            file >> orders;
+        Status status = reader->Finish();
+        if (status.ok()) {
+            std::cout << "\nChunks: " << chunks
+                      << "\nTotal Buy Orders: " << buy_orders
+                      << "\nTotal Sell Orders: " << sell_orders << "\n";
+            return true;
+        }
 
-            if (!orders.contains("orders")) {
-                spdlog::error("JSON file does not contain 'orders' array");
-                return false;
-            }
+        // A dropped stream can be resumed from the last received cursor
+        spdlog::error("Snapshot stream failed after {} chunks (resume at {} side, sequence {}): {}",
+                      chunks,
+                      chunk.next_cursor().sell_side() ? "sell" : "buy",
+                      chunk.next_cursor().after_sequence(),
+                      status.error_message());
+        return false;
+    }
 
-            int orderCount = 0;
-            for (const auto& order : orders["orders"]) {
-                try {
-                    bool success = submitOrder(
-                        order["order_id"].get<std::string>(),
-                        order["trader_id"].get<std::string>(),
-                        order["symbol"].get<std::string>(),
-                        order["price"].get<double>(),
-                        order["quantity"].get<int>(),
-                        order["is_buy"].get<bool>()
-                    );
-                    if (success) {
-                        orderCount++;
-                    }
-                    // Add small delay between orders
-                    std::this_thread::sleep_for(100ms);
-                }
-                catch (const json::exception& e) {
-                    spdlog::error("Error parsing order: {}", e.what());
-                    continue;
-                }
-            }
+    bool streamExecutions(const std::string& trader_id) {
+        ExecutionStreamRequest request;
+        request.set_trader_id(trader_id);
+
+        ClientContext context;
+        spdlog::info("Streaming executions for trader {}...", trader_id);
+
+        auto reader = stub_->StreamExecutions(&context, request);
+
+        ExecutionReport report;
+        while (reader->Read(&report)) {
+            spdlog::info("Execution {}: {} {} {} {} @ {} (remaining {})",
+                         report.execution_id(),
+                         OrderStatus_Name(report.status()),
+                         report.order_id(),
+                         report.is_buy_order() ? "BUY" : "SELL",
+                         report.quantity(),
+                         report.price(),
+                         report.remaining_quantity());
+        }
 
-            spdlog::info("Successfully processed {} orders from file", orderCount);
+        Status status = reader->Finish();
+        if (status.ok()) {
             return true;
         }
+
+        spdlog::error("Execution stream ended: {}", status.error_message());
+        return false;
+    }
+
+    // Submits every entry in the file through an OrderReplayer. A file
+    // path that does not exist is looked up under data/.
+    bool processOrdersFromFile(const std::string& filename, const ReplayConfig& config) {
+        try {
+            OrderFileSource source(findOrderFile(filename));
+            OrderReplayer replayer(client_, config);
+            ReplayReport report = replayer.replay([&](ReplayRequest& request) { return source.next(request); });
+
+            printReplayReport(report, source.skipped());
+            return report.failed == 0;
+        }
         catch (const fs::filesystem_error& e) {
             spdlog::error("Filesystem error: {}", e.what());
             return false;
@@ -245,21 +465,144 @@ public:
     }
 
 private:
+    static constexpr size_t kMaxPrintedErrors = 100;
+
+    static void printReplayReport(const ReplayReport& report, uint64_t skipped) {
+        auto micros = [](uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+        spdlog::info("Submitted {} orders in {:.3f} s ({:.0f} orders/s): {} accepted, {} rejected, {} failed, {} unparseable",
+                     report.submitted, report.seconds, report.ordersPerSecond(),
+                     report.accepted, report.rejected, report.failed, skipped);
+        if (report.cancels > 0 || report.amends > 0) {
+            spdlog::info("Of those, {} were cancels and {} amends", report.cancels, report.amends);
+        }
+        if (report.submitted > 0) {
+            spdlog::info("Response latency p50 {:.1f} us, p99 {:.1f} us, p99.9 {:.1f} us, max {:.1f} us",
+                         micros(report.latency.valueAtPercentile(50.0)), micros(report.latency.valueAtPercentile(99.0)),
+                         micros(report.latency.valueAtPercentile(99.9)), micros(report.latency.max()));
+        }
+        for (size_t i = 0; i < report.errors.size() && i < kMaxPrintedErrors; ++i) {
+            const ReplayError& error = report.errors[i];
+            spdlog::warn("Order #{} ({}): {}", error.index, error.order_id, error.message);
+        }
+        uint64_t errors = report.rejected + report.failed;
+        if (errors > kMaxPrintedErrors) {
+            spdlog::warn("... and {} more errors", errors - kMaxPrintedErrors);
+        }
+    }
+
+    static void printSnapshotRow(const char* side, const OrderBookEntry& entry) {
+        const auto& details = entry.details();
+        std::cout << std::setw(6) << side
+                  << std::setw(12) << details.order_id()
+                  << std::setw(12) << details.trader_id()
+                  << std::setw(10) << details.stock_symbol()
+                  << std::setw(12) << std::fixed << std::setprecision(2) << details.price()
+                  << std::setw(12) << entry.remaining_quantity()
+                  << "\n";
+    }
+
+    static OrderClientConfig connectionConfig(OrderClientConfig config) {
+        spdlog::info("Connecting to server at {}", config.channelTarget());
+        config.channels = 1;
+        config.connect_timeout = 5s;
+        return config;
+    }
+
+    AsyncOrderClient client_;
+    // For the streaming RPCs, which AsyncOrderClient does not wrap
     std::unique_ptr<OrderService::Stub> stub_;
 };
 
+double toMicros(uint64_t nanos) {
+    return static_cast<double>(nanos) / 1000.0;
+}
+
+int runLoad(const LoadConfig& config) {
+    spdlog::info("Open-loop load: {} orders/s from {} clients for {} s, mix new:cancel:amend {}:{}:{}",
+                 config.rate_per_second, config.clients, config.seconds,
+                 config.mix[0], config.mix[1], config.mix[2]);
+    LoadReport report = LoadGenerator(config).run();
+
+    double target = config.rate_per_second;
+    double achieved = static_cast<double>(report.sent()) / report.send_seconds;
+    std::cout << std::fixed << std::setprecision(0)
+              << "\nTarget rate: " << target << "/s, sent: " << achieved << "/s, answered: "
+              << static_cast<double>(report.answered()) / report.send_seconds << "/s\n"
+              << std::setprecision(1)
+              << "Send lag p50/p99/max: " << toMicros(report.send_lag.valueAtPercentile(50.0)) << " / "
+              << toMicros(report.send_lag.valueAtPercentile(99.0)) << " / "
+              << toMicros(report.send_lag.max()) << " us\n"
+              << "Latencies are from the scheduled send time, in microseconds\n\n";
+
+    std::cout << std::setw(8) << "RPC"
+              << std::setw(10) << "Sent"
+              << std::setw(10) << "OK"
+              << std::setw(10) << "Rejected"
+              << std::setw(8) << "Shed"
+              << std::setw(8) << "Failed"
+              << std::setw(10) << "Rate/s"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p90"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9"
+              << std::setw(10) << "p99.99"
+              << std::setw(10) << "Max"
+              << "\n";
+    std::cout << std::string(124, '-') << "\n";
+    for (size_t i = 0; i < kLoadRpcCount; ++i) {
+        const LoadRpcStats& stats = report.rpcs[i];
+        const LatencyHistogram& latency = stats.latency;
+        std::cout << std::setw(8) << loadRpcName(static_cast<LoadRpc>(i))
+                  << std::setw(10) << stats.sent
+                  << std::setw(10) << stats.ok
+                  << std::setw(10) << stats.rejected
+                  << std::setw(8) << stats.shed
+                  << std::setw(8) << stats.failed
+                  << std::setw(10) << std::setprecision(0)
+                  << static_cast<double>(stats.ok + stats.rejected) / report.send_seconds
+                  << std::setprecision(1)
+                  << std::setw(10) << toMicros(latency.valueAtPercentile(50.0))
+                  << std::setw(10) << toMicros(latency.valueAtPercentile(90.0))
+                  << std::setw(10) << toMicros(latency.valueAtPercentile(99.0))
+                  << std::setw(10) << toMicros(latency.valueAtPercentile(99.9))
+                  << std::setw(10) << toMicros(latency.valueAtPercentile(99.99))
+                  << std::setw(10) << toMicros(latency.max())
+                  << "\n";
+    }
+
+    // Shedding is the server protecting itself; anything else is an error
+    uint64_t failed = 0;
+    for (const auto& stats : report.rpcs) {
+        failed += stats.failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
 void printUsage() {
     std::cout << "Usage:\n"
               << "  OrderClient submit <order_id> <trader_id> <symbol> <price> <quantity> <buy/sell>\n"
               << "  OrderClient cancel <order_id> <buy/sell>\n"
               << "  OrderClient file <filename>\n"
+              << "  OrderClient replay <filename> [window] [rate]\n"
+              << "  OrderClient convert <filename> <capture.ocap>\n"
               << "  OrderClient view [symbol]\n"
+              << "  OrderClient status <order_id>\n"
+              << "  OrderClient snapshot [symbol] [chunk_size]\n"
+              << "  OrderClient executions <trader_id>\n"
+              << "  OrderClient bench [rate] [seconds] [clients] [new:cancel:amend]\n"
               << "\nExamples:\n"
               << "  OrderClient submit order1 trader1 AAPL 150.50 100 buy\n"
               << "  OrderClient cancel order1 buy\n"
               << "  OrderClient file orders.json    # reads from data/orders.json\n"
+              << "  OrderClient replay capture.json 512    # 512 orders in flight, no rate limit\n"
+              << "  OrderClient replay capture.json 64 5000 # at most 5000 orders/s\n"
+              << "  OrderClient replay capture.ndjson      # streamed; .jsonl and .csv too\n"
+              << "  OrderClient convert orders.json orders.ocap  # binary capture for replay\n"
               << "  OrderClient view               # view all orders\n"
-              << "  OrderClient view AAPL          # view orders for AAPL\n";
+              << "  OrderClient view AAPL          # view orders for AAPL\n"
+              << "  OrderClient status order1      # fills and remaining quantity\n"
+              << "  OrderClient snapshot AAPL 1000 # stream AAPL orders 1000 per chunk\n"
+              << "  OrderClient bench 20000 10 4 60:30:10  # 20k orders/s for 10 s from 4 clients\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -271,11 +614,36 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        // Get server address from environment or use default
-        std::string server_address = getServerAddress();
+        // Conversion is offline
+        if (std::string(argv[1]) == "convert" && argc == 4) {
+            return convertOrderFile(argv[2], argv[3]);
+        }
+
+        // Server from SERVER_SOCKET, or SERVER_HOST and SERVER_PORT
+        OrderClientConfig client_config = OrderClientConfig::fromEnvironment();
+        std::string server_address = client_config.channelTarget();
         spdlog::info("Using server address: {}", server_address);
 
-        OrderClient client(server_address);
+        // The load generator opens its own channels, one per client
+        if (std::string(argv[1]) == "bench" && argc <= 6) {
+            LoadConfig config;
+            config.target = server_address;
+            if (argc > 2) {
+                config.rate_per_second = std::stod(argv[2]);
+            }
+            if (argc > 3) {
+                config.seconds = std::stod(argv[3]);
+            }
+            if (argc > 4) {
+                config.clients = std::stoi(argv[4]);
+            }
+            if (argc > 5) {
+                config.mix = LoadConfig::parseMix(argv[5]);
+            }
+            return runLoad(config);
+        }
+
+        OrderClient client(client_config);
         std::string command = argv[1];
 
         if (command == "submit" && argc == 8) {
@@ -297,7 +665,23 @@ int main(int argc, char* argv[]) {
             return result ? 0 : 1;
         }
         else if (command == "file" && argc == 3) {
-            bool result = client.processOrdersFromFile(argv[2]);
+            // One order at a time, ten per second, each response logged
+            ReplayConfig config;
+            config.window = 1;
+            config.rate_per_second = 10.0;
+            config.log_each_order = true;
+            bool result = client.processOrdersFromFile(argv[2], config);
+            return result ? 0 : 1;
+        }
+        else if (command == "replay" && argc >= 3 && argc <= 5) {
+            ReplayConfig config;
+            if (argc >= 4) {
+                config.window = static_cast<size_t>(std::stoul(argv[3]));
+            }
+            if (argc == 5) {
+                config.rate_per_second = std::stod(argv[4]);
+            }
+            bool result = client.processOrdersFromFile(argv[2], config);
             return result ? 0 : 1;
         }
         else if (command == "view" && (argc == 2 || argc == 3)) {
@@ -305,6 +689,20 @@ int main(int argc, char* argv[]) {
             bool result = client.viewOrderBook(symbol);
             return result ? 0 : 1;
         }
+        else if (command == "status" && argc == 3) {
+            bool result = client.getOrderStatus(argv[2]);
+            return result ? 0 : 1;
+        }
+        else if (command == "snapshot" && argc >= 2 && argc <= 4) {
+            std::string symbol = (argc >= 3) ? argv[2] : "";
+            int chunk_size = (argc == 4) ? std::stoi(argv[3]) : 0;
+            bool result = client.streamSnapshot(symbol, chunk_size);
+            return result ? 0 : 1;
+        }
+        else if (command == "executions" && argc == 3) {
+            bool result = client.streamExecutions(argv[2]);
+            return result ? 0 : 1;
+        }
         else {
             printUsage();
             return 1;
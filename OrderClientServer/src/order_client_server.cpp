@@ -1,72 +1,176 @@
 // src/order_client_server.cpp
 #include "order_client_server.hpp"
+#include "timestamp.hpp"
 #include <spdlog/spdlog.h>
 #include <algorithm>
-#include <chrono>
-#include <iomanip>
+#include <optional>
+#include <queue>
 
-std::string OrderClientServer::getCurrentTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto now_c = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+namespace {
+    // Holds the order lock for one request. With a wait listener set, the
+    // time spent acquiring it is reported once the lock has been released,
+    // including zero waits, so the listener also sees when contention ends.
+    // A traced request gets its LockAcquired and ResponseBuilt stages marked.
+    class OrderLock {
+    public:
+        OrderLock(std::mutex& mutex, const OrderClientServer::LockWaitListener& listener, RequestTrace* trace)
+            : lock_(mutex, std::defer_lock)
+            , listener_(listener)
+            , trace_(trace) {
+            if (listener_ && !lock_.try_lock()) {
+                auto start = std::chrono::steady_clock::now();
+                lock_.lock();
+                waited_ = std::chrono::steady_clock::now() - start;
+            } else if (!lock_.owns_lock()) {
+                lock_.lock();
+            }
+            if (trace_) {
+                trace_->mark(TraceStage::LockAcquired);
+            }
+        }
+
+        ~OrderLock() { unlock(); }
+
+        void unlock() {
+            if (lock_.owns_lock()) {
+                if (trace_) {
+                    trace_->mark(TraceStage::ResponseBuilt);
+                }
+                lock_.unlock();
+                if (listener_) {
+                    listener_(waited_);
+                }
+            }
+        }
+
+    private:
+        std::unique_lock<std::mutex> lock_;
+        const OrderClientServer::LockWaitListener& listener_;
+        RequestTrace* trace_;
+        std::chrono::nanoseconds waited_{0};
+    };
+
+    // Copies up to `limit` entries after `after_sequence`, and of `symbol`
+    // if one is set, into `out`. A side is kept in sequence order, so the
+    // cursor is found by binary search and the copy stops at the first
+    // matching entry past the page; entries of other symbols in between are
+    // still stepped over one by one. Returns whether that entry exists.
+    bool appendSnapshotPage(const std::vector<order_service::OrderBookEntry>& orders,
+                            const std::string& symbol,
+                            uint64_t after_sequence,
+                            int limit,
+                            google::protobuf::RepeatedPtrField<order_service::OrderBookEntry>* out) {
+        auto it = std::upper_bound(orders.begin(), orders.end(), after_sequence,
+                                   [](uint64_t sequence, const order_service::OrderBookEntry& entry) {
+                                       return sequence < entry.sequence();
+                                   });
+        int copied = 0;
+        for (; it != orders.end(); ++it) {
+            if (!symbol.empty() && it->details().stock_symbol() != symbol) {
+                continue;
+            }
+            if (copied == limit) {
+                return true;
+            }
+            *out->Add() = *it;
+            ++copied;
+        }
+        return false;
+    }
+
+    template <typename Message>
+    void setTimestamp(Message* message, TimestampNanos now) {
+        message->set_timestamp_ns(now);
+        message->set_timestamp(formatTimestamp(now));
+    }
+
+    void recordStatus(OrderStatusIndex& index,
+                      const order_service::OrderBookEntry& entry,
+                      order_service::OrderStatus status,
+                      double last_fill_price) {
+        index.record(entry.details(), status,
+                     entry.details().quantity() - entry.remaining_quantity(),
+                     entry.remaining_quantity(), last_fill_price);
+    }
 }
 
 order_service::OrderResponse OrderClientServer::submitOrder(const order_service::OrderRequest& request) {
+    order_service::OrderResponse response;
+    submitOrder(request, &response);
+    return response;
+}
+
+void OrderClientServer::submitOrder(const order_service::OrderRequest& request,
+                                    order_service::OrderResponse* response,
+                                    RequestTrace* trace) {
     try {
-        std::lock_guard<std::mutex> lock(order_mutex_);
-        order_service::OrderResponse response;
-        
-        spdlog::info("Processing order: ID={}, Symbol={}, Price={}, Qty={}, Side={}", 
-                     request.details().order_id(),
-                     request.details().stock_symbol(),
-                     request.details().price(),
-                     request.details().quantity(),
-                     request.details().is_buy_order() ? "BUY" : "SELL");
-
-        // Create initial order book entry
+        // One clock read stamps the entry, the response and the executions
+        TimestampNanos now = currentTimestampNanos();
+        bool log_order = order_event_log_ && order_event_log_->shouldLog();
+        OrderLock lock(order_mutex_, lock_wait_listener_, trace);
+        const auto& details = request.details();
+
+        // Create initial order book entry. This is the only copy of the order
+        // details; it is moved into the book if the order rests.
         order_service::OrderBookEntry new_order;
-        *new_order.mutable_details() = request.details();
-        new_order.set_remaining_quantity(request.details().quantity());
-        new_order.set_timestamp(getCurrentTimestamp());
+        *new_order.mutable_details() = details;
+        new_order.set_remaining_quantity(details.quantity());
+        setTimestamp(&new_order, now);
+        new_order.set_sequence(next_sequence_++);
 
         // Try to match the order
-        int matched_quantity = matchOrders(new_order);
-        int remaining_quantity = request.details().quantity() - matched_quantity;
+        std::vector<order_service::ExecutionReport> executions;
+        double last_fill_price = 0.0;
+        bool want_executions = execution_listener_ || log_order;
+        int matched_quantity = matchOrders(new_order, last_fill_price,
+                                           want_executions ? &executions : nullptr);
+        if (trace) {
+            trace->mark(TraceStage::Matched);
+        }
+        int remaining_quantity = details.quantity() - matched_quantity;
 
         // Set response based on matching results
-        if (matched_quantity == request.details().quantity()) {
-            response.set_status(order_service::OrderStatus::FULLY_FILLED);
-            response.set_message("Order fully matched");
+        if (matched_quantity == details.quantity()) {
+            response->set_status(order_service::OrderStatus::FULLY_FILLED);
+            response->set_message("Order fully matched");
         } else if (matched_quantity > 0) {
-            response.set_status(order_service::OrderStatus::PARTIAL_FILL);
-            response.set_message("Order partially matched");
-            
-            // Add remaining quantity to book
-            new_order.set_remaining_quantity(remaining_quantity);
-            if (request.details().is_buy_order()) {
-                buy_orders_.push_back(new_order);
-            } else {
-                sell_orders_.push_back(new_order);
-            }
+            response->set_status(order_service::OrderStatus::PARTIAL_FILL);
+            response->set_message("Order partially matched");
         } else {
-            response.set_status(order_service::OrderStatus::SUCCESS);
-            response.set_message("Order added to book");
-            
-            // No matches, add to book
-            if (request.details().is_buy_order()) {
-                buy_orders_.push_back(new_order);
-            } else {
-                sell_orders_.push_back(new_order);
+            response->set_status(order_service::OrderStatus::SUCCESS);
+            response->set_message("Order added to book");
+        }
+
+        recordStatus(status_index_, new_order, response->status(), last_fill_price);
+
+        // Add any remaining quantity to the book
+        if (remaining_quantity > 0) {
+            addResting(new_order);
+            auto& orders = details.is_buy_order() ? buy_orders_ : sell_orders_;
+            orders.push_back(std::move(new_order));
+        }
+
+        response->set_matched_price(details.price());
+        response->set_matched_quantity(matched_quantity);
+        setTimestamp(response, now);
+        // Published before the lock is released, so no later execution can
+        // overtake these
+        if (execution_listener_) {
+            for (const auto& execution : executions) {
+                execution_listener_(execution);
             }
         }
+        lock.unlock();
 
-        response.set_matched_price(request.details().price());
-        response.set_matched_quantity(matched_quantity);
-        response.set_timestamp(getCurrentTimestamp());
-        
-        return response;
+        if (executions_published_listener_ && !executions.empty()) {
+            executions_published_listener_();
+        }
+        if (log_order) {
+            order_event_log_->logOrder(details, *response, executions);
+        }
+        if (book_update_listener_) {
+            book_update_listener_(details.stock_symbol());
+        }
     }
     catch (const std::exception& e) {
         spdlog::error("Error processing order {}: {}", 
@@ -75,62 +179,127 @@ order_service::OrderResponse OrderClientServer::submitOrder(const order_service:
     }
 }
 
-int OrderClientServer::matchOrders(order_service::OrderBookEntry& new_order) {
-    auto& opposite_orders = new_order.details().is_buy_order() ? sell_orders_ : buy_orders_;
+order_service::ExecutionReport OrderClientServer::makeExecutionReport(
+    const order_service::OrderBookEntry& entry,
+    order_service::OrderStatus status,
+    double price,
+    int quantity,
+    bool is_aggressor) {
+    order_service::ExecutionReport report;
+    report.set_execution_id(next_execution_id_++);
+    report.set_status(status);
+    report.set_order_id(entry.details().order_id());
+    report.set_trader_id(entry.details().trader_id());
+    report.set_stock_symbol(entry.details().stock_symbol());
+    report.set_is_buy_order(entry.details().is_buy_order());
+    report.set_price(price);
+    report.set_quantity(quantity);
+    report.set_remaining_quantity(entry.remaining_quantity());
+    report.set_is_aggressor(is_aggressor);
+    return report;
+}
+
+int OrderClientServer::matchOrders(order_service::OrderBookEntry& new_order,
+                                   double& last_fill_price,
+                                   std::vector<order_service::ExecutionReport>* executions) {
+    bool is_buy = new_order.details().is_buy_order();
+    double limit_price = new_order.details().price();
+    auto& opposite_orders = is_buy ? sell_orders_ : buy_orders_;
+    auto crosses = [is_buy, limit_price](double price) {
+        return is_buy ? limit_price >= price : limit_price <= price;
+    };
+
+    // The side stays in sequence order for snapshot cursors, so only the
+    // orders this one crosses are put in price-time priority: best price
+    // first, and at one price the lower index, which is the earlier order
+    auto& candidates = match_candidates_;
+    candidates.clear();
+    for (size_t i = 0; i < opposite_orders.size(); ++i) {
+        if (crosses(opposite_orders[i].details().price())) {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [&opposite_orders, is_buy](size_t a, size_t b) {
+        double price_a = opposite_orders[a].details().price();
+        double price_b = opposite_orders[b].details().price();
+        if (price_a != price_b) {
+            return is_buy ? price_a < price_b : price_a > price_b;
+        }
+        return a < b;
+    });
+
     int total_matched = 0;
-    
-    // Sort opposite orders by price
-    std::sort(opposite_orders.begin(), opposite_orders.end(),
-        [&new_order](const auto& a, const auto& b) {
-            if (new_order.details().is_buy_order()) {
-                return a.details().price() < b.details().price(); // For buy orders, lowest sell first
-            } else {
-                return a.details().price() > b.details().price(); // For sell orders, highest buy first
-            }
-        });
-    
-    // Try to match orders
-    auto it = opposite_orders.begin();
     int remaining_to_match = new_order.remaining_quantity(); // Track remaining quantity
+    uint64_t fills = 0;
+    bool resting_filled = false;
 
-    while (it != opposite_orders.end() && remaining_to_match > 0) {
-        // Check if prices cross
-        if ((new_order.details().is_buy_order() && 
-             new_order.details().price() >= it->details().price()) ||
-            (!new_order.details().is_buy_order() && 
-             new_order.details().price() <= it->details().price())) {
-            
-            int match_quantity = std::min(remaining_to_match, 
-                                        it->remaining_quantity());
-            
-            spdlog::info("Match found: Order {} matches with {} for quantity {}", 
-                        new_order.details().order_id(), 
-                        it->details().order_id(),
-                        match_quantity);
-            
-            total_matched += match_quantity;
-            remaining_to_match -= match_quantity;
-            new_order.set_remaining_quantity(remaining_to_match); // Update remaining quantity
-            it->set_remaining_quantity(it->remaining_quantity() - match_quantity);
-            
-            if (it->remaining_quantity() == 0) {
-                it = opposite_orders.erase(it);
-            } else {
-                ++it;
-            }
-        } else {
-            // No more possible matches due to price
+    for (size_t index : candidates) {
+        if (remaining_to_match == 0) {
             break;
         }
+        auto& resting = opposite_orders[index];
+        int match_quantity = std::min(remaining_to_match, resting.remaining_quantity());
+
+        total_matched += match_quantity;
+        ++fills;
+        remaining_to_match -= match_quantity;
+        new_order.set_remaining_quantity(remaining_to_match); // Update remaining quantity
+        resting.set_remaining_quantity(resting.remaining_quantity() - match_quantity);
+        takeResting(resting, match_quantity, resting.remaining_quantity() == 0);
+        resting_filled = resting_filled || resting.remaining_quantity() == 0;
+
+        // Both sides fill at the resting order's price
+        double fill_price = resting.details().price();
+        auto fill_status = [](const order_service::OrderBookEntry& entry) {
+            return entry.remaining_quantity() == 0
+                ? order_service::OrderStatus::FULLY_FILLED
+                : order_service::OrderStatus::PARTIAL_FILL;
+        };
+        last_fill_price = fill_price;
+        recordStatus(status_index_, resting, fill_status(resting), fill_price);
+
+        if (executions) {
+            executions->push_back(makeExecutionReport(
+                resting, fill_status(resting), fill_price, match_quantity, false));
+            setTimestamp(&executions->back(), new_order.timestamp_ns());
+            executions->push_back(makeExecutionReport(
+                new_order, fill_status(new_order), fill_price, match_quantity, true));
+            setTimestamp(&executions->back(), new_order.timestamp_ns());
+        }
+    }
+
+    // One pass removes every filled order and keeps the rest in order
+    if (resting_filled) {
+        std::erase_if(opposite_orders, [](const order_service::OrderBookEntry& entry) {
+            return entry.remaining_quantity() == 0;
+        });
+    }
+
+    if (fills > 0) {
+        auto& tally = tallies_[new_order.details().stock_symbol()];
+        tally.fills += fills;
+        tally.matched_quantity += static_cast<uint64_t>(total_matched);
     }
     
     return total_matched;
 }
 
 order_service::CancelResponse OrderClientServer::cancelOrder(const order_service::CancelRequest& request) {
+    order_service::CancelResponse response;
+    cancelOrder(request, &response);
+    return response;
+}
+
+void OrderClientServer::cancelOrder(const order_service::CancelRequest& request,
+                                    order_service::CancelResponse* response,
+                                    RequestTrace* trace) {
     try {
-        std::lock_guard<std::mutex> lock(order_mutex_);
-        order_service::CancelResponse response;
+        TimestampNanos now = currentTimestampNanos();
+        bool log_cancel = order_event_log_ && order_event_log_->shouldLog();
+        OrderLock lock(order_mutex_, lock_wait_listener_, trace);
+        std::string cancelled_symbol;
+        int cancelled_quantity = 0;
+        std::optional<order_service::ExecutionReport> execution;
         
         auto& orders = request.is_buy_order() ? buy_orders_ : sell_orders_;
         auto it = std::find_if(orders.begin(), orders.end(),
@@ -139,16 +308,42 @@ order_service::CancelResponse OrderClientServer::cancelOrder(const order_service
             });
             
         if (it != orders.end()) {
+            cancelled_symbol = it->details().stock_symbol();
+            cancelled_quantity = it->remaining_quantity();
+            takeResting(*it, cancelled_quantity, true);
+            if (execution_listener_) {
+                it->set_remaining_quantity(0);
+                execution = makeExecutionReport(*it, order_service::OrderStatus::CANCELLED,
+                                                it->details().price(), cancelled_quantity, false);
+            }
+            status_index_.cancel(request.order_id());
             orders.erase(it);
-            response.set_status(order_service::OrderStatus::CANCELLED);
-            response.set_message("Order cancelled successfully");
+            if (trace) {
+                trace->mark(TraceStage::Matched);
+            }
+            response->set_status(order_service::OrderStatus::CANCELLED);
+            response->set_message("Order cancelled successfully");
         } else {
-            response.set_status(order_service::OrderStatus::ERROR);
-            response.set_message("Order not found");
+            response->set_status(order_service::OrderStatus::ERROR);
+            response->set_message("Order not found");
         }
         
-        response.set_timestamp(getCurrentTimestamp());
-        return response;
+        setTimestamp(response, now);
+        if (execution) {
+            setTimestamp(&*execution, now);
+            execution_listener_(*execution);
+        }
+        lock.unlock();
+
+        if (execution && executions_published_listener_) {
+            executions_published_listener_();
+        }
+        if (log_cancel) {
+            order_event_log_->logCancel(request, *response, cancelled_symbol, cancelled_quantity);
+        }
+        if (response->status() == order_service::OrderStatus::CANCELLED && book_update_listener_) {
+            book_update_listener_(cancelled_symbol);
+        }
     }
     catch (const std::exception& e) {
         spdlog::error("Failed to cancel order: {}", e.what());
@@ -158,34 +353,162 @@ order_service::CancelResponse OrderClientServer::cancelOrder(const order_service
 
 order_service::ViewOrderBookResponse OrderClientServer::getOrderBook(
     const order_service::ViewOrderBookRequest& request) {
+    order_service::ViewOrderBookResponse response;
+    getOrderBook(request, &response);
+    return response;
+}
+
+void OrderClientServer::getOrderBook(const order_service::ViewOrderBookRequest& request,
+                                     order_service::ViewOrderBookResponse* response,
+                                     RequestTrace* trace) {
     try {
-        std::lock_guard<std::mutex> lock(order_mutex_);
-        order_service::ViewOrderBookResponse response;
+        TimestampNanos now = currentTimestampNanos();
+        OrderLock lock(order_mutex_, lock_wait_listener_, trace);
         
         // Copy relevant orders to response
         for (const auto& order : buy_orders_) {
             if (request.symbol().empty() || 
                 order.details().stock_symbol() == request.symbol()) {
-                *response.add_buy_orders() = order;
+                *response->add_buy_orders() = order;
             }
         }
         
         for (const auto& order : sell_orders_) {
             if (request.symbol().empty() || 
                 order.details().stock_symbol() == request.symbol()) {
-                *response.add_sell_orders() = order;
+                *response->add_sell_orders() = order;
             }
         }
         
-        response.set_total_buy_orders(response.buy_orders_size());
-        response.set_total_sell_orders(response.sell_orders_size());
-        response.set_timestamp(getCurrentTimestamp());
-        response.set_symbol(request.symbol());
-        
-        return response;
+        response->set_total_buy_orders(response->buy_orders_size());
+        response->set_total_sell_orders(response->sell_orders_size());
+        setTimestamp(response, now);
+        response->set_symbol(request.symbol());
     }
     catch (const std::exception& e) {
         spdlog::error("Failed to get order book: {}", e.what());
         throw OrderError("Failed to get order book: " + std::string(e.what()));
     }
 }
+
+order_service::OrderBookSnapshotChunk OrderClientServer::getOrderBookChunk(
+    const order_service::OrderBookSnapshotRequest& request) {
+    order_service::OrderBookSnapshotChunk chunk;
+    getOrderBookChunk(request, &chunk);
+    return chunk;
+}
+
+void OrderClientServer::getOrderBookChunk(const order_service::OrderBookSnapshotRequest& request,
+                                          order_service::OrderBookSnapshotChunk* chunk) {
+    try {
+        int limit = request.max_orders_per_chunk() > 0
+            ? std::min(request.max_orders_per_chunk(), kMaxSnapshotChunkOrders)
+            : kDefaultSnapshotChunkOrders;
+
+        setTimestamp(chunk, currentTimestampNanos());
+        OrderLock lock(order_mutex_, lock_wait_listener_, nullptr);
+        chunk->set_symbol(request.symbol());
+
+        uint64_t after_sequence = request.cursor().after_sequence();
+
+        if (!request.cursor().sell_side()) {
+            bool more = appendSnapshotPage(buy_orders_, request.symbol(),
+                                           after_sequence, limit,
+                                           chunk->mutable_buy_orders());
+            if (more) {
+                chunk->mutable_next_cursor()->set_sell_side(false);
+                chunk->mutable_next_cursor()->set_after_sequence(
+                    chunk->buy_orders(chunk->buy_orders_size() - 1).sequence());
+                return;
+            }
+            // Buy side exhausted; fill the rest of this chunk from the sell side
+            limit -= chunk->buy_orders_size();
+            after_sequence = 0;
+        }
+
+        auto* next_cursor = chunk->mutable_next_cursor();
+        next_cursor->set_sell_side(true);
+        next_cursor->set_after_sequence(after_sequence);
+
+        // A chunk filled exactly by the tail of the buy side leaves the sell
+        // side for the next request
+        if (limit > 0) {
+            bool more = appendSnapshotPage(sell_orders_, request.symbol(),
+                                           after_sequence, limit,
+                                           chunk->mutable_sell_orders());
+            if (chunk->sell_orders_size() > 0) {
+                next_cursor->set_after_sequence(
+                    chunk->sell_orders(chunk->sell_orders_size() - 1).sequence());
+            }
+            chunk->set_last_chunk(!more);
+        }
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Failed to get order book chunk: {}", e.what());
+        throw OrderError("Failed to get order book chunk: " + std::string(e.what()));
+    }
+}
+
+order_service::OrderStatusResponse OrderClientServer::getOrderStatus(
+    const order_service::OrderStatusRequest& request) const {
+    order_service::OrderStatusResponse response;
+    getOrderStatus(request, &response);
+    return response;
+}
+
+void OrderClientServer::getOrderStatus(const order_service::OrderStatusRequest& request,
+                                       order_service::OrderStatusResponse* response) const {
+    try {
+        if (status_index_.lookup(request.order_id(), response)) {
+            response->set_message("Order found");
+        } else {
+            response->set_status(order_service::OrderStatus::UNKNOWN);
+            response->set_message("Order not found");
+        }
+        setTimestamp(response, currentTimestampNanos());
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Failed to get status of order {}: {}", request.order_id(), e.what());
+        throw OrderError("Failed to get order status: " + std::string(e.what()));
+    }
+}
+
+std::vector<SymbolBookStats> OrderClientServer::bookStats() {
+    std::vector<SymbolBookStats> result;
+    {
+        std::lock_guard<std::mutex> lock(order_mutex_);
+        result.reserve(tallies_.size());
+        for (const auto& [symbol, tally] : tallies_) {
+            auto& stats = result.emplace_back();
+            stats.symbol = symbol;
+            stats.buy = {tally.buy.orders, tally.buy.orders_at_price.size(), tally.buy.quantity};
+            stats.sell = {tally.sell.orders, tally.sell.orders_at_price.size(), tally.sell.quantity};
+            stats.fills = tally.fills;
+            stats.matched_quantity = tally.matched_quantity;
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const auto& a, const auto& b) { return a.symbol < b.symbol; });
+    return result;
+}
+
+void OrderClientServer::addResting(const order_service::OrderBookEntry& entry) {
+    auto& tally = tallies_[entry.details().stock_symbol()];
+    auto& side = entry.details().is_buy_order() ? tally.buy : tally.sell;
+    ++side.orders;
+    side.quantity += entry.remaining_quantity();
+    ++side.orders_at_price[entry.details().price()];
+}
+
+void OrderClientServer::takeResting(const order_service::OrderBookEntry& entry, int quantity, bool leaves_book) {
+    auto& tally = tallies_[entry.details().stock_symbol()];
+    auto& side = entry.details().is_buy_order() ? tally.buy : tally.sell;
+    side.quantity -= quantity;
+    if (leaves_book) {
+        --side.orders;
+        auto level = side.orders_at_price.find(entry.details().price());
+        if (--level->second == 0) {
+            side.orders_at_price.erase(level);
+        }
+    }
+}
@@ -0,0 +1,184 @@
+// src/order_event_log.cpp
+#include "order_event_log.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    template <size_t N>
+    void copyField(char (&field)[N], const std::string& value) {
+        size_t length = std::min(value.size(), N);
+        std::memcpy(field, value.data(), length);
+        std::memset(field + length, 0, N - length);
+    }
+
+    OrderAuditRecord makeRecord(OrderAuditRecord::Type type) {
+        OrderAuditRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.type = type;
+        return record;
+    }
+
+    constexpr auto kAuditIdleWait = std::chrono::milliseconds(1);
+    constexpr auto kAuditFlushInterval = std::chrono::milliseconds(100);
+}
+
+OrderEventLog::OrderEventLog(OrderLogConfig config)
+    : config_(std::move(config)) {
+    if (config_.mode == OrderLogMode::Sampled && config_.sample_every == 0) {
+        throw std::invalid_argument("Order log sample rate must be at least 1");
+    }
+    if (config_.mode != OrderLogMode::Audit) {
+        return;
+    }
+
+    audit_file_ = std::fopen(config_.audit_path.c_str(), "ab");
+    if (!audit_file_) {
+        throw std::runtime_error("Failed to open order audit file " + config_.audit_path);
+    }
+    audit_queue_ = std::make_unique<BoundedMpscQueue<OrderAuditRecord>>(config_.audit_queue_records);
+    audit_writer_ = std::thread(&OrderEventLog::runAuditWriter, this);
+    spdlog::info("Writing order audit records to {}", config_.audit_path);
+}
+
+OrderEventLog::~OrderEventLog() {
+    running_.store(false, std::memory_order_release);
+    if (audit_writer_.joinable()) {
+        audit_writer_.join();
+    }
+    if (audit_file_) {
+        std::fclose(audit_file_);
+    }
+}
+
+bool OrderEventLog::shouldLog() noexcept {
+    switch (config_.mode) {
+        case OrderLogMode::Off:
+            return false;
+        case OrderLogMode::Audit:
+            return true;
+        case OrderLogMode::Sampled:
+            break;
+    }
+    // Counting per thread keeps the sampling decision off any shared line
+    thread_local uint32_t countdown = 0;
+    if (countdown == 0) {
+        countdown = config_.sample_every;
+    }
+    return --countdown == 0;
+}
+
+void OrderEventLog::logOrder(const order_service::OrderDetails& details,
+                             const order_service::OrderResponse& response,
+                             const std::vector<order_service::ExecutionReport>& executions) {
+    if (config_.mode == OrderLogMode::Sampled) {
+        spdlog::info("Order {} from {}: {} {} {} @ {} -> {} (matched {})",
+                     details.order_id(), details.trader_id(),
+                     details.is_buy_order() ? "BUY" : "SELL",
+                     details.quantity(), details.stock_symbol(), details.price(),
+                     order_service::OrderStatus_Name(response.status()),
+                     response.matched_quantity());
+        for (size_t i = 0; i + 1 < executions.size(); i += 2) {
+            spdlog::info("  filled {} @ {} against {}",
+                         executions[i].quantity(), executions[i].price(), executions[i].order_id());
+        }
+        return;
+    }
+    if (config_.mode != OrderLogMode::Audit) {
+        return;
+    }
+
+    auto record = makeRecord(OrderAuditRecord::Type::Order);
+    record.is_buy_order = details.is_buy_order();
+    record.status = static_cast<uint8_t>(response.status());
+    record.quantity = details.quantity();
+    record.timestamp_ns = response.timestamp_ns();
+    record.price = details.price();
+    copyField(record.order_id, details.order_id());
+    copyField(record.trader_id, details.trader_id());
+    copyField(record.symbol, details.stock_symbol());
+    enqueue(record);
+
+    for (size_t i = 0; i + 1 < executions.size(); i += 2) {
+        const auto& resting = executions[i];
+        const auto& aggressor = executions[i + 1];
+
+        auto fill = makeRecord(OrderAuditRecord::Type::Fill);
+        fill.is_buy_order = aggressor.is_buy_order();
+        fill.status = static_cast<uint8_t>(aggressor.status());
+        fill.quantity = aggressor.quantity();
+        fill.timestamp_ns = aggressor.timestamp_ns();
+        fill.price = aggressor.price();
+        copyField(fill.order_id, aggressor.order_id());
+        copyField(fill.trader_id, aggressor.trader_id());
+        copyField(fill.symbol, aggressor.stock_symbol());
+        copyField(fill.counterparty_order_id, resting.order_id());
+        enqueue(fill);
+    }
+}
+
+void OrderEventLog::logCancel(const order_service::CancelRequest& request,
+                              const order_service::CancelResponse& response,
+                              const std::string& symbol,
+                              int cancelled_quantity) {
+    if (config_.mode == OrderLogMode::Sampled) {
+        spdlog::info("Cancel {} {} {} {} -> {}", request.order_id(),
+                     request.is_buy_order() ? "BUY" : "SELL", cancelled_quantity, symbol,
+                     order_service::OrderStatus_Name(response.status()));
+        return;
+    }
+    if (config_.mode != OrderLogMode::Audit) {
+        return;
+    }
+
+    auto record = makeRecord(OrderAuditRecord::Type::Cancel);
+    record.is_buy_order = request.is_buy_order();
+    record.status = static_cast<uint8_t>(response.status());
+    record.quantity = cancelled_quantity;
+    record.timestamp_ns = response.timestamp_ns();
+    copyField(record.order_id, request.order_id());
+    copyField(record.trader_id, request.trader_id());
+    copyField(record.symbol, symbol);
+    enqueue(record);
+}
+
+void OrderEventLog::enqueue(const OrderAuditRecord& record) noexcept {
+    if (!audit_queue_->tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void OrderEventLog::runAuditWriter() {
+    OrderAuditRecord record;
+    uint64_t reported_dropped = 0;
+    auto last_flush = std::chrono::steady_clock::now();
+
+    for (;;) {
+        bool stopping = !running_.load(std::memory_order_acquire);
+        size_t written = 0;
+        while (audit_queue_->tryPop(record)) {
+            std::fwrite(&record, sizeof(record), 1, audit_file_);
+            ++written;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (stopping || now - last_flush >= kAuditFlushInterval) {
+            std::fflush(audit_file_);
+            last_flush = now;
+
+            uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+            if (dropped != reported_dropped) {
+                spdlog::warn("Order audit queue full: {} records dropped so far", dropped);
+                reported_dropped = dropped;
+            }
+        }
+        if (stopping) {
+            break;
+        }
+        if (written == 0) {
+            std::this_thread::sleep_for(kAuditIdleWait);
+        }
+    }
+}
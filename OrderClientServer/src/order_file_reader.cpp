@@ -0,0 +1,488 @@
+// src/order_file_reader.cpp
+#include "order_file_reader.hpp"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr std::array<std::string_view, 6> kFieldNames = {
+        "order_id", "trader_id", "symbol", "price", "quantity", "is_buy"};
+
+    bool endsWith(const std::string& text, std::string_view suffix) {
+        return text.size() >= suffix.size() &&
+               text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    OrderFileFormat streamable(OrderFileFormat format) {
+        if (format == OrderFileFormat::Json || format == OrderFileFormat::Capture) {
+            throw std::invalid_argument("OrderFileReader reads NDJSON and CSV, not a JSON document");
+        }
+        return format;
+    }
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && isSpace(text.front())) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && isSpace(text.back())) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool equalsIgnoreCase(std::string_view text, std::string_view lower) {
+        if (text.size() != lower.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i] >= 'A' && text[i] <= 'Z' ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+            if (c != lower[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool parseNumber(std::string_view text, T& value) {
+        const char* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    void appendUtf8(std::string& out, uint32_t code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    // Cursor over one NDJSON line
+    class JsonLine {
+    public:
+        explicit JsonLine(std::string_view text) : text_(text) {}
+
+        void skipSpace() {
+            while (pos_ < text_.size() && (isSpace(text_[pos_]) || text_[pos_] == '\n')) {
+                ++pos_;
+            }
+        }
+        [[nodiscard]] bool atEnd() const { return pos_ >= text_.size(); }
+        [[nodiscard]] char peek() const { return atEnd() ? '\0' : text_[pos_]; }
+        bool consume(char c) {
+            skipSpace();
+            if (peek() != c) {
+                return false;
+            }
+            ++pos_;
+            return true;
+        }
+
+        // A string at the cursor. Escape-free strings are returned as a view
+        // of the line; escaped ones are decoded into scratch.
+        bool string(std::string_view& value, std::string& scratch) {
+            if (!consume('"')) {
+                return false;
+            }
+            size_t start = pos_;
+            while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+                ++pos_;
+            }
+            if (pos_ < text_.size() && text_[pos_] == '"') {
+                value = text_.substr(start, pos_ - start);
+                ++pos_;
+                return true;
+            }
+
+            scratch.assign(text_.substr(start, pos_ - start));
+            while (pos_ < text_.size() && text_[pos_] != '"') {
+                char c = text_[pos_++];
+                if (c != '\\') {
+                    scratch += c;
+                    continue;
+                }
+                if (atEnd()) {
+                    return false;
+                }
+                char escaped = text_[pos_++];
+                switch (escaped) {
+                    case '"': scratch += '"'; break;
+                    case '\\': scratch += '\\'; break;
+                    case '/': scratch += '/'; break;
+                    case 'b': scratch += '\b'; break;
+                    case 'f': scratch += '\f'; break;
+                    case 'n': scratch += '\n'; break;
+                    case 'r': scratch += '\r'; break;
+                    case 't': scratch += '\t'; break;
+                    case 'u': {
+                        uint32_t code_point = 0;
+                        if (!hex4(code_point)) {
+                            return false;
+                        }
+                        // A high surrogate must be followed by its low half
+                        if (code_point >= 0xD800 && code_point < 0xDC00) {
+                            uint32_t low = 0;
+                            if (text_.substr(pos_, 2) != "\\u") {
+                                return false;
+                            }
+                            pos_ += 2;
+                            if (!hex4(low) || low < 0xDC00 || low >= 0xE000) {
+                                return false;
+                            }
+                            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        appendUtf8(scratch, code_point);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            if (atEnd()) {
+                return false;
+            }
+            ++pos_;
+            value = scratch;
+            return true;
+        }
+
+        // The characters of a number or literal at the cursor
+        std::string_view token() {
+            skipSpace();
+            size_t start = pos_;
+            while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' &&
+                   !isSpace(text_[pos_])) {
+                ++pos_;
+            }
+            return text_.substr(start, pos_ - start);
+        }
+
+        // Skips a nested object or array, strings included
+        bool skipNested() {
+            int depth = 0;
+            std::string ignored;
+            do {
+                skipSpace();
+                char c = peek();
+                if (c == '"') {
+                    std::string_view value;
+                    if (!string(value, ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (atEnd()) {
+                    return false;
+                }
+                depth += c == '{' || c == '[' ? 1 : c == '}' || c == ']' ? -1 : 0;
+                ++pos_;
+            } while (depth > 0);
+            return true;
+        }
+
+    private:
+        std::string_view text_;
+        size_t pos_ = 0;
+
+        bool hex4(uint32_t& value) {
+            if (pos_ + 4 > text_.size()) {
+                return false;
+            }
+            auto [ptr, ec] = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, value, 16);
+            if (ec != std::errc() || ptr != text_.data() + pos_ + 4) {
+                return false;
+            }
+            pos_ += 4;
+            return true;
+        }
+    };
+}
+
+OrderFileFormat orderFileFormatFor(const std::string& path) {
+    if (endsWith(path, ".ndjson") || endsWith(path, ".jsonl")) {
+        return OrderFileFormat::NdJson;
+    }
+    if (endsWith(path, ".csv")) {
+        return OrderFileFormat::Csv;
+    }
+    if (endsWith(path, ".ocap")) {
+        return OrderFileFormat::Capture;
+    }
+    return OrderFileFormat::Json;
+}
+
+OrderFileReader::OrderFileReader(const std::string& path, OrderFileFormat format)
+    : format_(streamable(format))
+    , file_(path)
+{
+    columns_.fill(kNoColumn);
+    if (format_ == OrderFileFormat::Csv) {
+        readCsvHeader();
+    }
+}
+
+bool OrderFileReader::nextLine(std::string_view& line) {
+    std::string_view data = file_.data();
+    if (offset_ >= data.size()) {
+        return false;
+    }
+    const char* start = data.data() + offset_;
+    const void* newline = std::memchr(start, '\n', data.size() - offset_);
+    size_t length = newline ? static_cast<size_t>(static_cast<const char*>(newline) - start)
+                            : data.size() - offset_;
+    line = std::string_view(start, length);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    offset_ += length + (newline ? 1 : 0);
+    ++line_number_;
+
+    if (offset_ - released_ >= kReleaseStep) {
+        // The current line may straddle the boundary, so keep its pages
+        file_.release(static_cast<size_t>(start - data.data()));
+        released_ = offset_;
+    }
+    return true;
+}
+
+void OrderFileReader::readCsvHeader() {
+    std::string_view line;
+    while (nextLine(line)) {
+        if (trim(line).empty()) {
+            continue;
+        }
+        size_t column = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t comma = line.find(',', start);
+            std::string_view name = trim(line.substr(start, comma == std::string_view::npos ? std::string_view::npos
+                                                                                            : comma - start));
+            if (name.size() >= 2 && name.front() == '"' && name.back() == '"') {
+                name = name.substr(1, name.size() - 2);
+            }
+            for (size_t field = 0; field < kFieldCount; ++field) {
+                if (name == kFieldNames[field] || (field == IsBuy && name == "side")) {
+                    columns_[field] = column;
+                }
+            }
+            ++column;
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            start = comma + 1;
+        }
+        column_count_ = column;
+        for (size_t field = 0; field < kFieldCount; ++field) {
+            if (columns_[field] == kNoColumn) {
+                throw std::runtime_error(file_.path() + ": CSV header has no " + std::string(kFieldNames[field]) +
+                                         " column");
+            }
+        }
+        return;
+    }
+}
+
+ReadResult OrderFileReader::next(order_service::OrderRequest& request) {
+    std::string_view line;
+    while (nextLine(line)) {
+        if (trim(line).empty()) {
+            continue;
+        }
+        bool parsed = format_ == OrderFileFormat::NdJson ? parseNdJson(line, request) : parseCsv(line, request);
+        return parsed ? ReadResult::Order : ReadResult::Malformed;
+    }
+    return ReadResult::End;
+}
+
+bool OrderFileReader::fail(std::string message) {
+    error_ = std::move(message);
+    return false;
+}
+
+bool OrderFileReader::setField(Field field, std::string_view value, bool quoted,
+                               order_service::OrderRequest& request) {
+    auto* details = request.mutable_details();
+    bool json = format_ == OrderFileFormat::NdJson;
+    switch (field) {
+        case OrderId:
+        case TraderId:
+        case Symbol:
+            if (json && !quoted) {
+                return fail(std::string(kFieldNames[field]) + " must be a string");
+            }
+            if (field == OrderId) {
+                details->set_order_id(value.data(), value.size());
+            } else if (field == TraderId) {
+                details->set_trader_id(value.data(), value.size());
+            } else {
+                details->set_stock_symbol(value.data(), value.size());
+            }
+            return true;
+        case Price: {
+            double price = 0.0;
+            if ((json && quoted) || !parseNumber(value, price)) {
+                return fail("bad price '" + std::string(value) + "'");
+            }
+            details->set_price(price);
+            return true;
+        }
+        case Quantity: {
+            int32_t quantity = 0;
+            if ((json && quoted) || !parseNumber(value, quantity)) {
+                return fail("bad quantity '" + std::string(value) + "'");
+            }
+            details->set_quantity(quantity);
+            return true;
+        }
+        case IsBuy: {
+            bool literal = !json || !quoted;
+            if (literal && (value == "true" || (!json && (value == "1" || equalsIgnoreCase(value, "buy"))))) {
+                details->set_is_buy_order(true);
+                return true;
+            }
+            if (literal && (value == "false" || (!json && (value == "0" || equalsIgnoreCase(value, "sell"))))) {
+                details->set_is_buy_order(false);
+                return true;
+            }
+            return fail("bad is_buy '" + std::string(value) + "'");
+        }
+        case kFieldCount:
+            break;
+    }
+    return fail("unknown field");
+}
+
+bool OrderFileReader::parseNdJson(std::string_view line, order_service::OrderRequest& request) {
+    JsonLine json(line);
+    uint32_t seen = 0;
+    if (!json.consume('{')) {
+        return fail("expected a JSON object");
+    }
+    json.skipSpace();
+    if (json.peek() != '}') {
+        do {
+            std::string_view key;
+            if (!json.string(key, scratch_)) {
+                return fail("bad key");
+            }
+            size_t field = 0;
+            while (field < kFieldCount && key != kFieldNames[field]) {
+                ++field;
+            }
+            if (!json.consume(':')) {
+                return fail("expected ':' after key");
+            }
+
+            json.skipSpace();
+            char first = json.peek();
+            if (field == kFieldCount) {
+                // Unknown keys may hold anything
+                std::string_view ignored;
+                bool skipped = first == '"' ? json.string(ignored, scratch_)
+                             : first == '{' || first == '[' ? json.skipNested()
+                             : !json.token().empty();
+                if (!skipped) {
+                    return fail("bad value");
+                }
+                continue;
+            }
+
+            std::string_view value;
+            bool quoted = first == '"';
+            if (quoted ? !json.string(value, scratch_) : (value = json.token()).empty()) {
+                return fail("bad " + std::string(kFieldNames[field]));
+            }
+            if (!setField(static_cast<Field>(field), value, quoted, request)) {
+                return false;
+            }
+            seen |= 1u << field;
+        } while (json.consume(','));
+    }
+    if (!json.consume('}')) {
+        return fail("expected ',' or '}'");
+    }
+    json.skipSpace();
+    if (!json.atEnd()) {
+        return fail("trailing characters after the object");
+    }
+    for (size_t field = 0; field < kFieldCount; ++field) {
+        if (!(seen & (1u << field))) {
+            return fail("missing " + std::string(kFieldNames[field]));
+        }
+    }
+    return true;
+}
+
+bool OrderFileReader::parseCsv(std::string_view line, order_service::OrderRequest& request) {
+    size_t column = 0;
+    size_t pos = 0;
+    for (;;) {
+        std::string_view value;
+        while (pos < line.size() && isSpace(line[pos])) {
+            ++pos;
+        }
+        if (pos < line.size() && line[pos] == '"') {
+            // Quoted: "" stands for one quote
+            size_t start = ++pos;
+            bool escaped = false;
+            while (pos < line.size() && (line[pos] != '"' || (pos + 1 < line.size() && line[pos + 1] == '"'))) {
+                escaped = escaped || line[pos] == '"';
+                pos += line[pos] == '"' ? 2 : 1;
+            }
+            if (pos >= line.size()) {
+                return fail("unterminated quote in column " + std::to_string(column + 1));
+            }
+            value = line.substr(start, pos - start);
+            if (escaped) {
+                scratch_.clear();
+                for (size_t i = 0; i < value.size(); ++i) {
+                    scratch_ += value[i];
+                    i += value[i] == '"' ? 1 : 0;
+                }
+                value = scratch_;
+            }
+            ++pos;
+            while (pos < line.size() && isSpace(line[pos])) {
+                ++pos;
+            }
+            if (pos < line.size() && line[pos] != ',') {
+                return fail("text after closing quote in column " + std::to_string(column + 1));
+            }
+        } else {
+            size_t comma = line.find(',', pos);
+            size_t end = comma == std::string_view::npos ? line.size() : comma;
+            value = trim(line.substr(pos, end - pos));
+            pos = end;
+        }
+
+        for (size_t field = 0; field < kFieldCount; ++field) {
+            if (columns_[field] == column && !setField(static_cast<Field>(field), value, false, request)) {
+                return false;
+            }
+        }
+        ++column;
+        if (pos >= line.size()) {
+            break;
+        }
+        ++pos;  // The comma
+    }
+    if (column != column_count_) {
+        return fail("expected " + std::to_string(column_count_) + " columns, got " + std::to_string(column));
+    }
+    return true;
+}
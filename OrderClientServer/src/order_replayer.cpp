@@ -0,0 +1,216 @@
+// src/order_replayer.cpp
+#include "order_replayer.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    bool accepted(order_service::OrderStatus status) {
+        return status != order_service::OrderStatus::REJECTED &&
+               status != order_service::OrderStatus::ERROR &&
+               status != order_service::OrderStatus::UNKNOWN;
+    }
+}
+
+OrderReplayer::OrderReplayer(AsyncOrderClient& client, ReplayConfig config)
+    : client_(client)
+    , config_(config)
+{
+    if (config_.window == 0) {
+        throw std::invalid_argument("replay window must be at least 1");
+    }
+    slots_ = std::make_unique<Slot[]>(config_.window);
+    free_slots_.reserve(config_.window);
+    for (size_t i = config_.window; i-- > 0;) {
+        free_slots_.push_back(&slots_[i]);
+    }
+}
+
+ReplayReport OrderReplayer::replay(const OrderSource& next) {
+    auto interval = config_.rate_per_second > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.rate_per_second))
+        : Clock::duration::zero();
+    Clock::time_point started = Clock::now();
+
+    try {
+        for (uint64_t index = 0;; ++index) {
+            Slot* slot = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                slot_freed_.wait(lock, [this] { return !free_slots_.empty(); });
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+            }
+            slot->request.clear();
+            bool more = false;
+            try {
+                more = next(slot->request);
+            } catch (...) {
+                // Hand the slot back, or waitForAllSlots would wait for it forever
+                std::lock_guard lock(mutex_);
+                free_slots_.push_back(slot);
+                throw;
+            }
+            if (!more) {
+                std::lock_guard lock(mutex_);
+                free_slots_.push_back(slot);
+                break;
+            }
+            if (interval != Clock::duration::zero()) {
+                std::this_thread::sleep_until(started + interval * index);
+            }
+            slot->index = index;
+            const ReplayRequest& request = slot->request;
+            slot->ids[0] = request.kind == ReplayKind::Cancel ? request.cancel.order_id()
+                                                              : request.order.details().order_id();
+            slot->id_count = 1;
+            if (request.kind == ReplayKind::Amend && request.cancel.order_id() != slot->ids[0]) {
+                slot->ids[1] = request.cancel.order_id();
+                slot->id_count = 2;
+                // Taken in one global order, so two amends cannot wait on each other
+                if (slot->ids[1] < slot->ids[0]) {
+                    std::swap(slot->ids[0], slot->ids[1]);
+                }
+            }
+            slot->held_ids = 0;
+            bool ready = false;
+            {
+                std::lock_guard lock(mutex_);
+                ready = acquireIds(*slot);
+            }
+            if (ready) {
+                start(*slot);
+            }
+        }
+    }
+    catch (...) {
+        // The callbacks still in flight refer to the slots
+        waitForAllSlots();
+        std::lock_guard lock(mutex_);
+        report_ = ReplayReport{};
+        throw;
+    }
+    waitForAllSlots();
+
+    std::lock_guard lock(mutex_);
+    report_.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    return std::exchange(report_, ReplayReport{});
+}
+
+void OrderReplayer::waitForAllSlots() {
+    std::unique_lock lock(mutex_);
+    slot_freed_.wait(lock, [this] { return free_slots_.size() == config_.window; });
+}
+
+bool OrderReplayer::acquireIds(Slot& slot) {
+    for (; slot.held_ids < slot.id_count; ++slot.held_ids) {
+        auto [busy, inserted] = busy_ids_.try_emplace(slot.ids[slot.held_ids]);
+        if (!inserted) {
+            busy->second.push_back(&slot);
+            return false;
+        }
+    }
+    return true;
+}
+
+void OrderReplayer::releaseIds(Slot& slot, std::vector<Slot*>& ready) {
+    for (size_t i = 0; i < slot.id_count; ++i) {
+        auto busy = busy_ids_.find(slot.ids[i]);
+        if (busy->second.empty()) {
+            busy_ids_.erase(busy);
+            continue;
+        }
+        // The id passes straight to the waiter, so later requests for it
+        // still queue behind
+        Slot* waiter = busy->second.front();
+        busy->second.pop_front();
+        ++waiter->held_ids;
+        if (acquireIds(*waiter)) {
+            ready.push_back(waiter);
+        }
+    }
+}
+
+void OrderReplayer::start(Slot& slot) {
+    slot.sent = Clock::now();
+    const ReplayRequest& request = slot.request;
+    switch (request.kind) {
+        case ReplayKind::New:
+            client_.submitOrder(request.order.details(), [this, &slot](const grpc::Status& rpc,
+                                                                        order_service::OrderResponse& response) {
+                complete(slot, rpc, true, response.status(), response.message());
+            });
+            break;
+        case ReplayKind::Cancel:
+            client_.cancelOrder(request.cancel, [this, &slot](const grpc::Status& rpc,
+                                                              order_service::CancelResponse& response) {
+                complete(slot, rpc, false, response.status(), response.message());
+            });
+            break;
+        case ReplayKind::Amend:
+            // The amend completes when its replacement is answered
+            client_.amendOrder(request.cancel, request.order.details(), [this, &slot](AsyncOrderClient::AmendResult& result) {
+                if (result.replaced) {
+                    complete(slot, result.status, true, result.replacement.status(), result.replacement.message());
+                } else {
+                    complete(slot, result.status, false, result.cancel.status(), result.cancel.message());
+                }
+            });
+            break;
+    }
+}
+
+void OrderReplayer::complete(Slot& slot, const grpc::Status& rpc, bool submit, order_service::OrderStatus status,
+                             const std::string& message) {
+    auto latency = Clock::now() - slot.sent;
+    const ReplayRequest& request = slot.request;
+    const std::string& order_id = request.kind == ReplayKind::New ? request.order.details().order_id()
+                                                                   : request.cancel.order_id();
+    const char* what = request.kind == ReplayKind::New ? "Order"
+                     : request.kind == ReplayKind::Cancel ? "Cancel" : "Amend";
+    // Errors for new orders carry no prefix; cancels and amends say which they were
+    std::string prefix = request.kind == ReplayKind::New ? std::string() : std::string(what) + " ";
+
+    std::vector<Slot*> ready;
+    std::unique_lock lock(mutex_);
+    report_.latency.record(latency);
+    ++report_.submitted;
+    report_.cancels += request.kind == ReplayKind::Cancel ? 1 : 0;
+    report_.amends += request.kind == ReplayKind::Amend ? 1 : 0;
+
+    if (!rpc.ok()) {
+        ++report_.failed;
+        if (report_.errors.size() < config_.max_errors) {
+            report_.errors.push_back({slot.index, order_id,
+                                      prefix + "RPC failed (" + std::to_string(rpc.error_code()) + "): " +
+                                      rpc.error_message()});
+        }
+    } else if (submit ? !accepted(status) : status != order_service::OrderStatus::CANCELLED) {
+        ++report_.rejected;
+        if (report_.errors.size() < config_.max_errors) {
+            report_.errors.push_back({slot.index, order_id,
+                                      prefix + order_service::OrderStatus_Name(status) + ": " + message});
+        }
+    } else {
+        ++report_.accepted;
+    }
+
+    if (config_.log_each_order) {
+        if (rpc.ok()) {
+            spdlog::info("{} {}: {}", what, order_id, order_service::OrderStatus_Name(status));
+        } else {
+            spdlog::error("{} {}: RPC failed: {}", what, order_id, rpc.error_message());
+        }
+    }
+
+    releaseIds(slot, ready);
+    free_slots_.push_back(&slot);
+    slot_freed_.notify_all();
+    lock.unlock();
+    for (Slot* next : ready) {
+        start(*next);
+    }
+}
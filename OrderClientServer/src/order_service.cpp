@@ -1,118 +1,571 @@
 // src/order_service.cpp
 #include "order_service.hpp"
+#include "timestamp.hpp"
 #include <spdlog/spdlog.h>
-#include <chrono>
-#include <iomanip>
-#include <thread>
+#include <future>
+#include <mutex>
 
 namespace {
-    std::string getCurrentTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto now_c = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+    // Fast-fails a shed request. grpc-retry-pushback-ms is the hint gRPC's
+    // client retry policy honours.
+    grpc::Status overloadedStatus(grpc::ServerContextBase* context,
+                                  const AdmissionController::Ticket& ticket) {
+        context->AddTrailingMetadata("grpc-retry-pushback-ms",
+                                     std::to_string(ticket.retryAfter().count()));
+        return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                            "Server overloaded; retry after " +
+                            std::to_string(ticket.retryAfter().count()) + " ms");
     }
+
+    // Unary reactor for a traced call; OnDone runs once gRPC has finished
+    // the call, which is the Sent stage
+    class TracedUnaryReactor : public grpc::ServerUnaryReactor {
+    public:
+        TracedUnaryReactor(std::shared_ptr<RequestTracer> tracer, TracedRpc rpc)
+            : tracer_(std::move(tracer))
+            , trace_(tracer_->begin(rpc)) {}
+
+        RequestTrace* trace() { return &trace_; }
+
+        void OnDone() override {
+            trace_.mark(TraceStage::Sent);
+            tracer_->record(trace_);
+            delete this;
+        }
+
+    private:
+        std::shared_ptr<RequestTracer> tracer_;
+        RequestTrace trace_;
+    };
+
+    grpc::Status laneFullStatus() {
+        return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Server overloaded; request queue full");
+    }
+
+    // Answers a throttled order or cancel in-band, like any other rejection,
+    // without it reaching the matcher
+    template <typename Response>
+    void rejectThrottled(Response* response, const std::string& trader_id) {
+        TimestampNanos now = currentTimestampNanos();
+        response->set_status(order_service::OrderStatus::REJECTED);
+        response->set_reject_reason(order_service::RejectReason::THROTTLED);
+        response->set_message("Message rate limit exceeded for trader " + trader_id);
+        response->set_timestamp_ns(now);
+        response->set_timestamp(formatTimestamp(now));
+    }
+
+    // Wraps a shared serialized update in a ByteBuffer without copying it;
+    // the slice keeps the buffer alive until gRPC has sent it
+    grpc::ByteBuffer toByteBuffer(const SerializedBookUpdate& update) {
+        auto* holder = new SerializedBookUpdate(update);
+        grpc::Slice slice(const_cast<char*>((*holder)->data()), (*holder)->size(),
+                          [](void* user_data) { delete static_cast<SerializedBookUpdate*>(user_data); },
+                          holder);
+        return grpc::ByteBuffer(&slice, 1);
+    }
+
+    template <typename Message>
+    class FinishedStreamReactor : public grpc::ServerWriteReactor<Message> {
+    public:
+        explicit FinishedStreamReactor(const grpc::Status& status) { this->Finish(status); }
+        void OnDone() override { delete this; }
+    };
+
+    // Server-streaming reactor fed from a subscription queue. wake() is called
+    // whenever the queue gains a message; at most one write is in flight and
+    // the queue is drained as writes complete.
+    template <typename Message>
+    class QueuedWriteReactor : public grpc::ServerWriteReactor<Message> {
+    public:
+        void OnWriteDone(bool ok) override {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                write_in_flight_ = false;
+            }
+            if (!ok) {
+                spdlog::warn("Failed to write to stream, client may have disconnected");
+                finish(grpc::Status::OK);
+                return;
+            }
+            wake();
+        }
+
+        void OnCancel() override {
+            finish(grpc::Status::CANCELLED);
+        }
+
+    protected:
+        enum class Next { Idle, Write, Finish };
+
+        // Called under mutex_. Fills `message` for Write or `status` for Finish.
+        virtual Next next(Message& message, grpc::Status& status) = 0;
+
+        void wake() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (write_in_flight_ || finished_) {
+                return;
+            }
+            grpc::Status status;
+            switch (next(current_, status)) {
+                case Next::Idle:
+                    break;
+                case Next::Write:
+                    write_in_flight_ = true;
+                    this->StartWrite(&current_);
+                    break;
+                case Next::Finish:
+                    finished_ = true;
+                    this->Finish(status);
+                    break;
+            }
+        }
+
+        void finish(const grpc::Status& status) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!finished_) {
+                finished_ = true;
+                this->Finish(status);
+            }
+        }
+
+        std::mutex mutex_;
+
+    private:
+        Message current_;
+        bool write_in_flight_{false};
+        bool finished_{false};
+    };
+
+    // One order book subscriber, woken by the publisher with conflated,
+    // pre-serialized updates
+    class BookStreamReactor : public QueuedWriteReactor<grpc::ByteBuffer> {
+    public:
+        BookStreamReactor(std::shared_ptr<MarketDataPublisher> publisher, const std::string& symbol)
+            : publisher_(std::move(publisher)) {
+            auto subscription = publisher_->subscribe(symbol, [this] { wake(); });
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                subscription_ = std::move(subscription);
+            }
+            // Pick up the initial snapshot if it was queued during subscribe()
+            wake();
+        }
+
+        void OnDone() override {
+            publisher_->unsubscribe(subscription_);
+            spdlog::info("Order book stream ended ({} updates conflated)",
+                         subscription_->conflated());
+            delete this;
+        }
+
+    private:
+        Next next(grpc::ByteBuffer& message, grpc::Status&) override {
+            if (!subscription_) {
+                return Next::Idle;
+            }
+            auto update = subscription_->pop();
+            if (!update) {
+                return Next::Idle;
+            }
+            message = toByteBuffer(update);
+            return Next::Write;
+        }
+
+        std::shared_ptr<MarketDataPublisher> publisher_;
+        std::shared_ptr<BookSubscription> subscription_;
+    };
+
+    // One trader's execution report stream. Reports are never dropped: once
+    // the subscription overflows, the queued reports are flushed and the
+    // stream ends so the client knows to reconcile.
+    class ExecutionStreamReactor : public QueuedWriteReactor<order_service::ExecutionReport> {
+    public:
+        ExecutionStreamReactor(std::shared_ptr<ExecutionReportHub> hub, const std::string& trader_id)
+            : hub_(std::move(hub)) {
+            auto subscription = hub_->subscribe(trader_id, [this] { wake(); });
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                subscription_ = std::move(subscription);
+            }
+            // Pick up reports delivered before subscription_ was set
+            wake();
+        }
+
+        void OnDone() override {
+            hub_->unsubscribe(subscription_);
+            spdlog::info("Execution stream for trader {} ended", subscription_->traderId());
+            delete this;
+        }
+
+    private:
+        Next next(order_service::ExecutionReport& message, grpc::Status& status) override {
+            if (!subscription_) {
+                return Next::Idle;
+            }
+            if (auto report = subscription_->pop()) {
+                message = std::move(*report);
+                return Next::Write;
+            }
+            if (subscription_->overflowed()) {
+                status = grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                      "Execution stream fell behind; resubscribe and reconcile open orders");
+                return Next::Finish;
+            }
+            return Next::Idle;
+        }
+
+        std::shared_ptr<ExecutionReportHub> hub_;
+        std::shared_ptr<ExecutionSubscription> subscription_;
+    };
 }
 
-OrderServiceImpl::OrderServiceImpl(std::shared_ptr<OrderClientServer> server)
-    : server_(std::move(server)) {
+OrderServiceImpl::OrderServiceImpl(std::shared_ptr<OrderClientServer> server,
+                                   std::shared_ptr<MarketDataPublisher> publisher,
+                                   std::shared_ptr<AdmissionController> admission,
+                                   std::shared_ptr<RateLimiter> rate_limiter,
+                                   std::shared_ptr<LaneScheduler> lanes,
+                                   std::shared_ptr<RequestTracer> tracer,
+                                   std::shared_ptr<ServerMetrics> metrics)
+    : server_(std::move(server))
+    , publisher_(std::move(publisher))
+    , executions_(std::make_shared<ExecutionReportHub>())
+    , admission_(std::move(admission))
+    , rate_limiter_(std::move(rate_limiter))
+    , lanes_(std::move(lanes))
+    , tracer_(std::move(tracer))
+    , metrics_(std::move(metrics)) {
     if (!server_) {
         throw std::invalid_argument("Server cannot be null");
     }
+    std::weak_ptr<ExecutionReportHub> weak_executions = executions_;
+    server_->setExecutionListener(
+        [weak_executions](const order_service::ExecutionReport& report) {
+            if (auto executions = weak_executions.lock()) {
+                executions->publish(report);
+            }
+        },
+        [weak_executions] {
+            if (auto executions = weak_executions.lock()) {
+                executions->deliver();
+            }
+        });
+    if (!publisher_) {
+        publisher_ = std::make_shared<MarketDataPublisher>(server_);
+        std::weak_ptr<MarketDataPublisher> weak_publisher = publisher_;
+        server_->setBookUpdateListener([weak_publisher](const std::string& symbol) {
+            if (auto publisher = weak_publisher.lock()) {
+                publisher->markDirty(symbol);
+            }
+        });
+        publisher_->start();
+    }
+    // With lanes, order entry queues in the scheduler rather than on the
+    // order lock, so that is where admission measures queueing delay
+    std::weak_ptr<AdmissionController> weak_admission = admission_;
+    if (admission_ && lanes_) {
+        lanes_->setQueueDelayListener([weak_admission](RequestPriority lane, std::chrono::nanoseconds delay) {
+            auto admission = weak_admission.lock();
+            if (admission && lane != RequestPriority::Query) {
+                admission->observeQueueDelay(delay);
+            }
+        });
+    }
+    bool admission_watches_lock = admission_ && !lanes_;
+    if (admission_watches_lock || metrics_) {
+        std::weak_ptr<ServerMetrics> weak_metrics = metrics_;
+        server_->setLockWaitListener([weak_admission, weak_metrics, admission_watches_lock](
+                                         std::chrono::nanoseconds waited) {
+            if (auto metrics = weak_metrics.lock()) {
+                metrics->recordLockWait(waited);
+            }
+            if (admission_watches_lock) {
+                if (auto admission = weak_admission.lock()) {
+                    admission->observeQueueDelay(waited);
+                }
+            }
+        });
+    }
+    if (lanes_) {
+        lanes_->start();
+    }
+
+    SetMessageAllocatorFor_SubmitOrder(&submit_allocator_);
+    SetMessageAllocatorFor_CancelOrder(&cancel_allocator_);
+    SetMessageAllocatorFor_ViewOrderBook(&view_allocator_);
+    SetMessageAllocatorFor_GetOrderStatus(&status_allocator_);
 }
 
-grpc::Status OrderServiceImpl::SubmitOrder(grpc::ServerContext* context,
-                                         const order_service::OrderRequest* request,
-                                         order_service::OrderResponse* response) {
-    try {
-        spdlog::info("Received order: ID={}, Symbol={}, Price={}, Qty={}, Side={}", 
-            request->details().order_id(),
-            request->details().stock_symbol(),
-            request->details().price(),
-            request->details().quantity(),
-            request->details().is_buy_order() ? "BUY" : "SELL");
-        
-        *response = server_->submitOrder(*request);
-        return grpc::Status::OK;
+OrderServiceImpl::UnaryCall OrderServiceImpl::startCall(grpc::CallbackServerContext* context, TracedRpc rpc) {
+    uint64_t started_ticks = metrics_ ? TscClock::now() : 0;
+    if (tracer_ && tracer_->shouldSample()) {
+        auto* reactor = new TracedUnaryReactor(tracer_, rpc);
+        return {reactor, reactor->trace(), rpc, started_ticks};
     }
-    catch (const std::exception& e) {
-        spdlog::error("Failed to submit order: {}", e.what());
-        return grpc::Status(grpc::StatusCode::INTERNAL, 
-                          std::string("Failed to submit order: ") + e.what());
+    return {context->DefaultReactor(), nullptr, rpc, started_ticks};
+}
+
+void OrderServiceImpl::finish(const UnaryCall& call, const grpc::Status& status) {
+    CallOutcome outcome = CallOutcome::Ok;
+    if (status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+        outcome = CallOutcome::Shed;
+    } else if (!status.ok()) {
+        outcome = CallOutcome::Failed;
     }
+    finish(call, status, outcome);
 }
 
-grpc::Status OrderServiceImpl::CancelOrder(grpc::ServerContext* context,
-                                         const order_service::CancelRequest* request,
-                                         order_service::CancelResponse* response) {
-    try {
-        spdlog::info("Received cancel request: Order ID={}, Side={}", 
-            request->order_id(),
-            request->is_buy_order() ? "BUY" : "SELL");
-        
-        *response = server_->cancelOrder(*request);
-        response->set_timestamp(getCurrentTimestamp());
-        return grpc::Status::OK;
+void OrderServiceImpl::finish(const UnaryCall& call, const grpc::Status& status, CallOutcome outcome) {
+    if (metrics_) {
+        auto elapsed = TscClock::toNanos(TscClock::now() - call.started_ticks);
+        metrics_->recordCall(call.rpc, outcome, std::chrono::nanoseconds(static_cast<int64_t>(elapsed)));
     }
-    catch (const std::exception& e) {
-        spdlog::error("Failed to cancel order: {}", e.what());
-        return grpc::Status(grpc::StatusCode::INTERNAL, 
-                          std::string("Failed to cancel order: ") + e.what());
+    call.reactor->Finish(status);
+}
+
+std::string OrderServiceImpl::renderMetrics() const {
+    if (!metrics_) {
+        return {};
     }
+    MetricsSources sources;
+    sources.server = server_.get();
+    sources.admission = admission_.get();
+    sources.lanes = lanes_.get();
+    sources.rate_limiter = rate_limiter_.get();
+    sources.tracer = tracer_.get();
+    return metrics_->render(sources);
 }
 
-grpc::Status OrderServiceImpl::ViewOrderBook(grpc::ServerContext* context,
-                                           const order_service::ViewOrderBookRequest* request,
-                                           order_service::ViewOrderBookResponse* response) {
-    try {
-        spdlog::info("Received order book request{}", 
-            request->symbol().empty() ? "" : " for symbol " + request->symbol());
-        
-        *response = server_->getOrderBook(*request);
-        response->set_timestamp(getCurrentTimestamp());
-        
-        spdlog::info("Returning order book with {} buy orders and {} sell orders",
-                    response->buy_orders_size(),
-                    response->sell_orders_size());
-        
-        return grpc::Status::OK;
+AdmissionController::Ticket OrderServiceImpl::admit(RequestPriority priority) {
+    return admission_ ? admission_->tryAdmit(priority) : AdmissionController::Ticket();
+}
+
+bool OrderServiceImpl::withinRate(const grpc::CallbackServerContext* context, const std::string& trader_id) {
+    return !rate_limiter_ || rate_limiter_->allow(trader_id, context->peer());
+}
+
+template <typename Handler>
+void OrderServiceImpl::dispatch(RequestPriority lane, const UnaryCall& call,
+                                AdmissionController::Ticket ticket, Handler&& handle) {
+    RequestTrace* trace = call.trace;
+    if (!lanes_) {
+        if (trace) {
+            trace->mark(TraceStage::Started);
+        }
+        handle();
+        return;
     }
-    catch (const std::exception& e) {
-        spdlog::error("Failed to get order book: {}", e.what());
-        return grpc::Status(grpc::StatusCode::INTERNAL, 
-                          std::string("Failed to get order book: ") + e.what());
+    bool queued = lanes_->submit(lane, [trace, ticket = std::move(ticket),
+                                        handle = std::forward<Handler>(handle)]() mutable {
+        if (trace) {
+            trace->mark(TraceStage::Started);
+        }
+        handle();
+    });
+    if (!queued) {
+        finish(call, laneFullStatus());
     }
 }
 
-grpc::Status OrderServiceImpl::StreamOrderBook(grpc::ServerContext* context,
-                                             const order_service::ViewOrderBookRequest* request,
-                                             grpc::ServerWriter<order_service::ViewOrderBookResponse>* writer) {
+bool OrderServiceImpl::runOnLane(RequestPriority lane, const std::function<void()>& work) {
+    if (!lanes_) {
+        work();
+        return true;
+    }
+    std::promise<void> done;
+    auto finished = done.get_future();
+    bool queued = lanes_->submit(lane, [&work, &done] {
+        try {
+            work();
+            done.set_value();
+        }
+        catch (...) {
+            done.set_exception(std::current_exception());
+        }
+    });
+    if (!queued) {
+        return false;
+    }
+    finished.get();
+    return true;
+}
+
+grpc::ServerUnaryReactor* OrderServiceImpl::SubmitOrder(grpc::CallbackServerContext* context,
+                                                      const order_service::OrderRequest* request,
+                                                      order_service::OrderResponse* response) {
+    auto call = startCall(context, TracedRpc::SubmitOrder);
+    if (!withinRate(context, request->details().trader_id())) {
+        rejectThrottled(response, request->details().trader_id());
+        finish(call, grpc::Status::OK, CallOutcome::Throttled);
+        return call.reactor;
+    }
+    auto ticket = admit(RequestPriority::Order);
+    if (!ticket) {
+        finish(call, overloadedStatus(context, ticket));
+        return call.reactor;
+    }
+    dispatch(RequestPriority::Order, call, std::move(ticket), [this, request, response, call] {
+        try {
+            server_->submitOrder(*request, response, call.trace);
+            finish(call, grpc::Status::OK);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to submit order: {}", e.what());
+            finish(call, grpc::Status(grpc::StatusCode::INTERNAL,
+                                      std::string("Failed to submit order: ") + e.what()));
+        }
+    });
+    return call.reactor;
+}
+
+grpc::ServerUnaryReactor* OrderServiceImpl::CancelOrder(grpc::CallbackServerContext* context,
+                                                      const order_service::CancelRequest* request,
+                                                      order_service::CancelResponse* response) {
+    auto call = startCall(context, TracedRpc::CancelOrder);
+    if (!withinRate(context, request->trader_id())) {
+        rejectThrottled(response, request->trader_id());
+        finish(call, grpc::Status::OK, CallOutcome::Throttled);
+        return call.reactor;
+    }
+    auto ticket = admit(RequestPriority::Cancel);
+    if (!ticket) {
+        finish(call, overloadedStatus(context, ticket));
+        return call.reactor;
+    }
+    dispatch(RequestPriority::Cancel, call, std::move(ticket), [this, request, response, call] {
+        try {
+            server_->cancelOrder(*request, response, call.trace);
+            finish(call, grpc::Status::OK);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to cancel order: {}", e.what());
+            finish(call, grpc::Status(grpc::StatusCode::INTERNAL,
+                                      std::string("Failed to cancel order: ") + e.what()));
+        }
+    });
+    return call.reactor;
+}
+
+grpc::ServerUnaryReactor* OrderServiceImpl::ViewOrderBook(grpc::CallbackServerContext* context,
+                                                        const order_service::ViewOrderBookRequest* request,
+                                                        order_service::ViewOrderBookResponse* response) {
+    auto call = startCall(context, TracedRpc::ViewOrderBook);
+    auto ticket = admit(RequestPriority::Query);
+    if (!ticket) {
+        finish(call, overloadedStatus(context, ticket));
+        return call.reactor;
+    }
+    dispatch(RequestPriority::Query, call, std::move(ticket), [this, request, response, call] {
+        try {
+            server_->getOrderBook(*request, response, call.trace);
+            SPDLOG_DEBUG("Returning order book{} with {} buy orders and {} sell orders",
+                         request->symbol().empty() ? "" : " for symbol " + request->symbol(),
+                         response->buy_orders_size(),
+                         response->sell_orders_size());
+            finish(call, grpc::Status::OK);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to get order book: {}", e.what());
+            finish(call, grpc::Status(grpc::StatusCode::INTERNAL,
+                                      std::string("Failed to get order book: ") + e.what()));
+        }
+    });
+    return call.reactor;
+}
+
+grpc::ServerWriteReactor<grpc::ByteBuffer>* OrderServiceImpl::StreamOrderBook(
+    grpc::CallbackServerContext* context, const grpc::ByteBuffer* request) {
+    order_service::ViewOrderBookRequest book_request;
+    grpc::ByteBuffer request_buffer(*request);
+    if (!grpc::SerializationTraits<order_service::ViewOrderBookRequest>::Deserialize(
+            &request_buffer, &book_request).ok()) {
+        spdlog::error("Failed to parse order book stream request");
+        return new FinishedStreamReactor<grpc::ByteBuffer>(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                                      "Malformed ViewOrderBookRequest"));
+    }
+
+    spdlog::info("Starting order book stream{} for {}",
+        book_request.symbol().empty() ? "" : " for symbol " + book_request.symbol(),
+        context->peer());
+    return new BookStreamReactor(publisher_, book_request.symbol());
+}
+
+grpc::ServerWriteReactor<order_service::ExecutionReport>* OrderServiceImpl::StreamExecutions(
+    grpc::CallbackServerContext* context, const order_service::ExecutionStreamRequest* request) {
+    if (request->trader_id().empty()) {
+        return new FinishedStreamReactor<order_service::ExecutionReport>(
+            grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "trader_id is required"));
+    }
+
+    spdlog::info("Starting execution stream for trader {} from {}", request->trader_id(), context->peer());
+    return new ExecutionStreamReactor(executions_, request->trader_id());
+}
+
+grpc::Status OrderServiceImpl::StreamOrderBookSnapshot(grpc::ServerContext* context,
+                                                     const order_service::OrderBookSnapshotRequest* request,
+                                                     grpc::ServerWriter<order_service::OrderBookSnapshotChunk>* writer) {
+    auto ticket = admit(RequestPriority::Query);
+    if (!ticket) {
+        return overloadedStatus(context, ticket);
+    }
     try {
-        spdlog::info("Starting order book stream{}", 
+        spdlog::info("Starting order book snapshot{}",
             request->symbol().empty() ? "" : " for symbol " + request->symbol());
-            
-        // Implementation for streaming updates
-        // This is a basic implementation that just sends periodic updates
+
+        // Each chunk is built, written and released before the next one is
+        // taken, so memory per request stays at one chunk. The arena is reset
+        // after each write, so its blocks are reused from chunk to chunk.
+        order_service::OrderBookSnapshotRequest page_request = *request;
+        google::protobuf::Arena arena;
+        int chunks = 0;
         while (!context->IsCancelled()) {
-            order_service::ViewOrderBookResponse response = server_->getOrderBook(*request);
-            response.set_timestamp(getCurrentTimestamp());
-            
-            if (!writer->Write(response)) {
-                spdlog::warn("Failed to write to stream, client may have disconnected");
+            auto* chunk = google::protobuf::Arena::CreateMessage<order_service::OrderBookSnapshotChunk>(&arena);
+            if (!runOnLane(RequestPriority::Query, [&] { server_->getOrderBookChunk(page_request, chunk); })) {
+                return laneFullStatus();
+            }
+
+            if (!writer->Write(*chunk)) {
+                spdlog::warn("Failed to write snapshot chunk, client may have disconnected");
                 break;
             }
-            
-            // Sleep for a short duration before sending the next update
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ++chunks;
+
+            if (chunk->last_chunk()) {
+                break;
+            }
+            *page_request.mutable_cursor() = chunk->next_cursor();
+            arena.Reset();
         }
-        
-        spdlog::info("Order book stream ended");
+
+        spdlog::info("Order book snapshot ended after {} chunks", chunks);
         return grpc::Status::OK;
     }
     catch (const std::exception& e) {
-        spdlog::error("Failed to stream order book: {}", e.what());
-        return grpc::Status(grpc::StatusCode::INTERNAL, 
-                          std::string("Failed to stream order book: ") + e.what());
+        spdlog::error("Failed to stream order book snapshot: {}", e.what());
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                          std::string("Failed to stream order book snapshot: ") + e.what());
+    }
+}
+
+grpc::ServerUnaryReactor* OrderServiceImpl::GetOrderStatus(grpc::CallbackServerContext* context,
+                                                         const order_service::OrderStatusRequest* request,
+                                                         order_service::OrderStatusResponse* response) {
+    auto call = startCall(context, TracedRpc::GetOrderStatus);
+    auto ticket = admit(RequestPriority::Query);
+    if (!ticket) {
+        finish(call, overloadedStatus(context, ticket));
+        return call.reactor;
+    }
+    if (call.trace) {
+        call.trace->mark(TraceStage::Started);
+    }
+    try {
+        server_->getOrderStatus(*request, response);
+        finish(call, grpc::Status::OK);
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Failed to get order status: {}", e.what());
+        finish(call, grpc::Status(grpc::StatusCode::INTERNAL,
+                                  std::string("Failed to get order status: ") + e.what()));
     }
+    return call.reactor;
 }
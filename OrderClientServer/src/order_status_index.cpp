@@ -0,0 +1,148 @@
+// src/order_status_index.cpp
+#include "order_status_index.hpp"
+#include <mutex>
+
+OrderStatusIndex::OrderStatusIndex(size_t terminal_capacity)
+    : terminal_capacity_(terminal_capacity) {}
+
+bool OrderStatusIndex::isTerminal(order_service::OrderStatus status) noexcept {
+    return status == order_service::OrderStatus::FULLY_FILLED ||
+           status == order_service::OrderStatus::CANCELLED;
+}
+
+void OrderStatusIndex::publish(Slot& slot,
+                               order_service::OrderStatus status,
+                               int filled_quantity,
+                               int remaining_quantity,
+                               double last_fill_price) noexcept {
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.status.store(status, std::memory_order_relaxed);
+    slot.filled_quantity.store(filled_quantity, std::memory_order_relaxed);
+    slot.remaining_quantity.store(remaining_quantity, std::memory_order_relaxed);
+    slot.last_fill_price.store(last_fill_price, std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+OrderStatusIndex::Slot* OrderStatusIndex::allocateSlot() {
+    if (!free_slots_.empty()) {
+        Slot* slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+    }
+    return &storage_.emplace_back();
+}
+
+void OrderStatusIndex::record(const order_service::OrderDetails& details,
+                              order_service::OrderStatus status,
+                              int filled_quantity,
+                              int remaining_quantity,
+                              double last_fill_price) {
+    // The writer is the only thread that mutates slots_, so it can search
+    // the map without taking the lock
+    auto it = slots_.find(details.order_id());
+    Slot* slot = it != slots_.end() ? it->second : nullptr;
+    bool was_terminal = false;
+
+    if (!slot || slot->details.stock_symbol() != details.stock_symbol() ||
+        slot->details.is_buy_order() != details.is_buy_order() ||
+        slot->details.trader_id() != details.trader_id()) {
+        // First sight of this order, or an order id reused by a new order.
+        // A replaced live slot is recycled; a replaced terminal slot is left
+        // for the terminal cache to recycle when it ages out.
+        Slot* fresh = allocateSlot();
+        fresh->details = details;
+        publish(*fresh, status, filled_quantity, remaining_quantity, last_fill_price);
+
+        std::unique_lock<std::shared_mutex> lock(map_mutex_);
+        if (slot && !isTerminal(static_cast<order_service::OrderStatus>(
+                        slot->status.load(std::memory_order_relaxed)))) {
+            free_slots_.push_back(slot);
+        }
+        slots_[details.order_id()] = fresh;
+        slot = fresh;
+    } else {
+        was_terminal = isTerminal(static_cast<order_service::OrderStatus>(
+            slot->status.load(std::memory_order_relaxed)));
+        publish(*slot, status, filled_quantity, remaining_quantity, last_fill_price);
+    }
+
+    if (isTerminal(status) && !was_terminal) {
+        terminal_.push_back(slot);
+        evictTerminal();
+    }
+}
+
+void OrderStatusIndex::cancel(const std::string& order_id) {
+    auto it = slots_.find(order_id);
+    if (it == slots_.end()) {
+        return;
+    }
+    Slot& slot = *it->second;
+    auto status = static_cast<order_service::OrderStatus>(slot.status.load(std::memory_order_relaxed));
+    if (isTerminal(status)) {
+        return;
+    }
+    publish(slot, order_service::OrderStatus::CANCELLED,
+            slot.filled_quantity.load(std::memory_order_relaxed), 0,
+            slot.last_fill_price.load(std::memory_order_relaxed));
+    terminal_.push_back(&slot);
+    evictTerminal();
+}
+
+void OrderStatusIndex::evictTerminal() {
+    if (terminal_.size() <= terminal_capacity_) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(map_mutex_);
+    while (terminal_.size() > terminal_capacity_) {
+        Slot* slot = terminal_.front();
+        terminal_.pop_front();
+
+        auto it = slots_.find(slot->details.order_id());
+        if (it != slots_.end() && it->second == slot) {
+            slots_.erase(it);
+        }
+        free_slots_.push_back(slot);
+    }
+}
+
+bool OrderStatusIndex::lookup(const std::string& order_id,
+                              order_service::OrderStatusResponse* response) const {
+    std::shared_lock<std::shared_mutex> lock(map_mutex_);
+    auto it = slots_.find(order_id);
+    if (it == slots_.end()) {
+        return false;
+    }
+    const Slot& slot = *it->second;
+
+    int32_t status;
+    int32_t filled_quantity;
+    int32_t remaining_quantity;
+    double last_fill_price;
+    uint32_t sequence;
+    do {
+        sequence = slot.sequence.load(std::memory_order_acquire);
+        status = slot.status.load(std::memory_order_relaxed);
+        filled_quantity = slot.filled_quantity.load(std::memory_order_relaxed);
+        remaining_quantity = slot.remaining_quantity.load(std::memory_order_relaxed);
+        last_fill_price = slot.last_fill_price.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 || sequence != slot.sequence.load(std::memory_order_relaxed));
+
+    *response->mutable_details() = slot.details;
+    response->set_status(static_cast<order_service::OrderStatus>(status));
+    response->set_filled_quantity(filled_quantity);
+    response->set_remaining_quantity(remaining_quantity);
+    response->set_last_fill_price(last_fill_price);
+    return true;
+}
+
+size_t OrderStatusIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(map_mutex_);
+    return slots_.size();
+}
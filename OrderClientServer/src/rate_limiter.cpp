@@ -0,0 +1,151 @@
+// src/rate_limiter.cpp
+#include "rate_limiter.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace {
+    // Makes room for one more key when the map is full: the oldest key is
+    // dropped if its bucket has fully refilled, and otherwise moved to the
+    // back so the next insert looks at the one after it. Returns whether a
+    // key may be added.
+    template <typename Map>
+    bool makeRoom(Map& map, std::deque<const std::string*>& order, size_t capacity, int64_t now_ns,
+                  const auto& bucket_of) {
+        if (map.size() < capacity) {
+            return true;
+        }
+        if (order.empty()) {
+            return false;
+        }
+        auto oldest = map.find(*order.front());
+        order.pop_front();
+        if (bucket_of(*oldest->second).idle(now_ns)) {
+            map.erase(oldest);
+            return true;
+        }
+        order.push_back(&oldest->first);
+        return false;
+    }
+
+    // Adds a key known to be missing, recording it as the newest
+    template <typename Map>
+    auto insertNewest(Map& map, std::deque<const std::string*>& order, const std::string& key, auto value) {
+        auto it = map.emplace(key, std::move(value)).first;
+        order.push_back(&it->first);
+        return it;
+    }
+}
+
+RateLimiter::RateLimiter(RateLimitConfig config)
+    : config_(config)
+    , overflow_trader_(config.trader_rate, config.trader_burst)
+    , overflow_connection_(config.connection_rate, config.connection_burst) {}
+
+bool RateLimiter::allow(const std::string& trader_id, const std::string& peer) {
+    return allow(trader_id, peer,
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+template <typename F>
+auto RateLimiter::withTrader(const std::string& trader_id, int64_t now_ns, F f) {
+    {
+        std::shared_lock<std::shared_mutex> lock(traders_mutex_);
+        auto it = traders_.find(trader_id);
+        if (it != traders_.end()) {
+            return f(*it->second);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(traders_mutex_);
+    auto it = traders_.find(trader_id);
+    if (it == traders_.end()) {
+        if (!makeRoom(traders_, trader_order_, config_.max_tracked_traders, now_ns,
+                      [](TraderState& trader) -> TokenBucket& { return trader.bucket; })) {
+            return f(overflow_trader_);
+        }
+        it = insertNewest(traders_, trader_order_, trader_id,
+                          std::make_unique<TraderState>(config_.trader_rate, config_.trader_burst));
+    }
+    return f(*it->second);
+}
+
+bool RateLimiter::allow(const std::string& trader_id, const std::string& peer, int64_t now_ns) {
+    auto acquire = [now_ns](TraderState& state) { return state.bucket.tryAcquire(now_ns); };
+    if (config_.trader_rate > 0 && !withTrader(trader_id, now_ns, acquire)) {
+        countThrottled(trader_id, now_ns);
+        return false;
+    }
+    if (config_.connection_rate > 0 && !allowConnection(peer, now_ns)) {
+        if (config_.trader_rate > 0) {
+            withTrader(trader_id, now_ns, [](TraderState& state) { state.bucket.refund(); });
+        }
+        countThrottled(trader_id, now_ns);
+        return false;
+    }
+    return true;
+}
+
+bool RateLimiter::allowConnection(const std::string& peer, int64_t now_ns) {
+    {
+        std::shared_lock<std::shared_mutex> lock(connections_mutex_);
+        auto it = connections_.find(peer);
+        if (it != connections_.end()) {
+            return it->second->tryAcquire(now_ns);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(connections_mutex_);
+    auto it = connections_.find(peer);
+    if (it == connections_.end()) {
+        if (!makeRoom(connections_, connection_order_, config_.max_tracked_connections, now_ns,
+                      [](TokenBucket& connection) -> TokenBucket& { return connection; })) {
+            return overflow_connection_.tryAcquire(now_ns);
+        }
+        it = insertNewest(connections_, connection_order_, peer,
+                          std::make_unique<TokenBucket>(config_.connection_rate, config_.connection_burst));
+    }
+    return it->second->tryAcquire(now_ns);
+}
+
+void RateLimiter::countThrottled(const std::string& trader_id, int64_t now_ns) {
+    throttled_total_.fetch_add(1, std::memory_order_relaxed);
+    uint64_t previous = withTrader(trader_id, now_ns, [](TraderState& state) {
+        return state.throttled.fetch_add(1, std::memory_order_relaxed);
+    });
+    if (previous == 0) {
+        spdlog::warn("Throttling trader {}", trader_id);
+    }
+}
+
+size_t RateLimiter::trackedTraders() const {
+    std::shared_lock<std::shared_mutex> lock(traders_mutex_);
+    return traders_.size();
+}
+
+uint64_t RateLimiter::throttled(const std::string& trader_id) const {
+    std::shared_lock<std::shared_mutex> lock(traders_mutex_);
+    auto it = traders_.find(trader_id);
+    return it != traders_.end() ? it->second->throttled.load(std::memory_order_relaxed) : 0;
+}
+
+std::vector<std::pair<std::string, uint64_t>> RateLimiter::mostThrottledTraders(size_t limit) const {
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    {
+        std::shared_lock<std::shared_mutex> lock(traders_mutex_);
+        for (const auto& [trader_id, state] : traders_) {
+            uint64_t throttled = state->throttled.load(std::memory_order_relaxed);
+            if (throttled > 0) {
+                counts.emplace_back(trader_id, throttled);
+            }
+        }
+    }
+    auto by_count = [](const auto& a, const auto& b) { return a.second > b.second; };
+    if (counts.size() > limit) {
+        std::partial_sort(counts.begin(), counts.begin() + static_cast<std::ptrdiff_t>(limit), counts.end(), by_count);
+        counts.resize(limit);
+    } else {
+        std::sort(counts.begin(), counts.end(), by_count);
+    }
+    return counts;
+}
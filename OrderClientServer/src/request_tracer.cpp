@@ -0,0 +1,218 @@
+// src/request_tracer.cpp
+#include "request_tracer.hpp"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace {
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    uint32_t currentThreadId() noexcept {
+        static std::atomic<uint32_t> next_thread_id{1};
+        thread_local uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+        return thread_id;
+    }
+
+    // Each interval is named after the stage that ends it
+    const char* intervalName(TraceStage end) noexcept {
+        switch (end) {
+            case TraceStage::Received: return "received";
+            case TraceStage::Started: return "queue";
+            case TraceStage::LockAcquired: return "lock_wait";
+            case TraceStage::Matched: return "match";
+            case TraceStage::ResponseBuilt: return "respond";
+            case TraceStage::Sent: return "send";
+        }
+        return "unknown";
+    }
+
+    // Calls visit(begin_stage, end_stage) for each pair of consecutive
+    // stages the trace reached
+    template <typename Visit>
+    void forEachInterval(const RequestTrace& trace, Visit&& visit) {
+        size_t previous = kTraceStageCount;
+        for (size_t stage = 0; stage < kTraceStageCount; ++stage) {
+            if (trace.ticks[stage] == 0) {
+                continue;
+            }
+            if (previous != kTraceStageCount && trace.ticks[stage] >= trace.ticks[previous]) {
+                visit(static_cast<TraceStage>(previous), static_cast<TraceStage>(stage));
+            }
+            previous = stage;
+        }
+    }
+
+    double percentile(std::vector<double>& values, double fraction) {
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+}
+
+const char* traceStageName(TraceStage stage) noexcept {
+    switch (stage) {
+        case TraceStage::Received: return "Received";
+        case TraceStage::Started: return "Started";
+        case TraceStage::LockAcquired: return "LockAcquired";
+        case TraceStage::Matched: return "Matched";
+        case TraceStage::ResponseBuilt: return "ResponseBuilt";
+        case TraceStage::Sent: return "Sent";
+    }
+    return "Unknown";
+}
+
+const char* tracedRpcName(TracedRpc rpc) noexcept {
+    switch (rpc) {
+        case TracedRpc::SubmitOrder: return "SubmitOrder";
+        case TracedRpc::CancelOrder: return "CancelOrder";
+        case TracedRpc::ViewOrderBook: return "ViewOrderBook";
+        case TracedRpc::GetOrderStatus: return "GetOrderStatus";
+    }
+    return "Unknown";
+}
+
+RequestTracer::RequestTracer(uint32_t sample_every, size_t capacity)
+    : sample_every_(std::max<uint32_t>(sample_every, 1))
+    , capacity_(roundUpToPowerOfTwo(capacity))
+    , slots_(std::make_unique<Slot[]>(capacity_)) {}
+
+bool RequestTracer::shouldSample() noexcept {
+    thread_local uint32_t countdown = 0;
+    if (countdown == 0) {
+        countdown = sample_every_;
+    }
+    return --countdown == 0;
+}
+
+RequestTrace RequestTracer::begin(TracedRpc rpc) noexcept {
+    RequestTrace trace;
+    trace.mark(TraceStage::Received);
+    trace.rpc = rpc;
+    trace.thread_id = currentThreadId();
+    trace.request_id = next_request_id_.fetch_add(1, std::memory_order_relaxed);
+    return trace;
+}
+
+void RequestTracer::record(const RequestTrace& trace) noexcept {
+    uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index & (capacity_ - 1)];
+
+    // A writer still in the slot has been lapped by the ring; drop this
+    // trace rather than interleave with it. The claim does not depend on
+    // what earlier laps left behind, so a dropped write costs one trace.
+    if (slot.writing.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    // A stalled writer that got here after a later lap keeps the newer trace
+    if (slot.sequence.load(std::memory_order_relaxed) > 2 * index) {
+        slot.writing.store(false, std::memory_order_release);
+        return;
+    }
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[kWords];
+    std::memcpy(words, &trace, sizeof(words));
+    for (size_t i = 0; i < kWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    slot.writing.store(false, std::memory_order_release);
+}
+
+std::vector<RequestTrace> RequestTracer::snapshot() const {
+    std::vector<RequestTrace> traces;
+    uint64_t end = next_.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    traces.reserve(static_cast<size_t>(end - begin));
+
+    for (uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = slots_[index & (capacity_ - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2) {
+            continue;  // Being written, dropped, or already overwritten
+        }
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != 2 * index + 2) {
+            continue;
+        }
+        RequestTrace& trace = traces.emplace_back();
+        std::memcpy(&trace, words, sizeof(words));
+    }
+    return traces;
+}
+
+std::string RequestTracer::chromeTraceJson() const {
+    auto traces = snapshot();
+    uint64_t origin = UINT64_MAX;
+    for (const auto& trace : traces) {
+        origin = std::min(origin, trace.at(TraceStage::Received));
+    }
+    auto micros = [origin](uint64_t ticks) { return TscClock::toNanos(ticks - origin) / 1000.0; };
+
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto& trace : traces) {
+        uint64_t first = trace.at(TraceStage::Received);
+        uint64_t last = first;
+        for (uint64_t ticks : trace.ticks) {
+            last = std::max(last, ticks);
+        }
+        events.push_back({{"name", tracedRpcName(trace.rpc)}, {"cat", "rpc"}, {"ph", "X"},
+                          {"ts", micros(first)}, {"dur", micros(last) - micros(first)},
+                          {"pid", 1}, {"tid", trace.thread_id},
+                          {"args", {{"request_id", trace.request_id}}}});
+        forEachInterval(trace, [&](TraceStage begin, TraceStage end) {
+            events.push_back({{"name", intervalName(end)}, {"cat", "stage"}, {"ph", "X"},
+                              {"ts", micros(trace.at(begin))},
+                              {"dur", micros(trace.at(end)) - micros(trace.at(begin))},
+                              {"pid", 1}, {"tid", trace.thread_id}});
+        });
+    }
+    return nlohmann::json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ns"}}.dump();
+}
+
+bool RequestTracer::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        spdlog::error("Failed to open trace file {}", path);
+        return false;
+    }
+    out << chromeTraceJson();
+    return static_cast<bool>(out);
+}
+
+std::string RequestTracer::stageSummary() const {
+    std::map<std::pair<TracedRpc, TraceStage>, std::vector<double>> intervals;
+    for (const auto& trace : snapshot()) {
+        forEachInterval(trace, [&](TraceStage begin, TraceStage end) {
+            intervals[{trace.rpc, end}].push_back(TscClock::toNanos(trace.at(end) - trace.at(begin)) / 1000.0);
+        });
+    }
+
+    std::string summary = fmt::format("{:<16} {:<10} {:>8} {:>10} {:>10} {:>10} {:>10}\n",
+                                      "rpc", "stage", "samples", "p50 us", "p90 us", "p99 us", "max us");
+    for (auto& [key, values] : intervals) {
+        // percentile() reorders the samples, so each figure is taken in turn
+        double max = *std::max_element(values.begin(), values.end());
+        double p50 = percentile(values, 0.50);
+        double p90 = percentile(values, 0.90);
+        double p99 = percentile(values, 0.99);
+        summary += fmt::format("{:<16} {:<10} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n",
+                               tracedRpcName(key.first), intervalName(key.second), values.size(),
+                               p50, p90, p99, max);
+    }
+    return summary;
+}
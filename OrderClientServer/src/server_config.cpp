@@ -0,0 +1,108 @@
+// src/server_config.cpp
+#include "server_config.hpp"
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+    const char* getEnvironment(const char* name) {
+        const char* value = std::getenv(name);
+        return (value && *value) ? value : nullptr;
+    }
+
+    unsigned long parseCount(const char* name, const char* value) {
+        try {
+            size_t parsed = 0;
+            unsigned long result = std::stoul(value, &parsed);
+            if (parsed == std::string(value).size() && result > 0) {
+                return result;
+            }
+        }
+        catch (const std::exception&) {
+        }
+        throw std::invalid_argument(std::string(name) + " must be a positive integer, got '" + value + "'");
+    }
+
+    // Like parseCount but accepts zero
+    unsigned long parseLimit(const char* name, const char* value) {
+        return std::string(value) == "0" ? 0 : parseCount(name, value);
+    }
+
+    OrderLogMode parseOrderLogMode(const std::string& value) {
+        if (value == "off") {
+            return OrderLogMode::Off;
+        }
+        if (value == "sampled") {
+            return OrderLogMode::Sampled;
+        }
+        if (value == "audit") {
+            return OrderLogMode::Audit;
+        }
+        throw std::invalid_argument("ORDER_LOG_MODE must be off, sampled or audit, got '" + value + "'");
+    }
+}
+
+ServerConfig ServerConfig::fromEnvironment() {
+    ServerConfig config;
+    if (const char* value = getEnvironment("ORDER_SERVER_ADDRESS")) {
+        config.listen_address = value;
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_UNIX_SOCKET")) {
+        config.unix_socket_path = value;
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_LOG_LEVEL")) {
+        config.log_level = value;
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_LOG_QUEUE")) {
+        config.log_queue_size = parseCount("ORDER_SERVER_LOG_QUEUE", value);
+    }
+    if (const char* value = getEnvironment("ORDER_LOG_MODE")) {
+        config.order_log.mode = parseOrderLogMode(value);
+    }
+    if (const char* value = getEnvironment("ORDER_LOG_SAMPLE_EVERY")) {
+        config.order_log.sample_every = static_cast<uint32_t>(parseCount("ORDER_LOG_SAMPLE_EVERY", value));
+    }
+    if (const char* value = getEnvironment("ORDER_AUDIT_PATH")) {
+        config.order_log.audit_path = value;
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_MAX_IN_FLIGHT")) {
+        config.admission.max_in_flight = parseLimit("ORDER_SERVER_MAX_IN_FLIGHT", value);
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_TARGET_DELAY_US")) {
+        config.admission.target_delay = std::chrono::microseconds(parseCount("ORDER_SERVER_TARGET_DELAY_US", value));
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_TRADER_RATE")) {
+        config.rate_limit.trader_rate = static_cast<double>(parseLimit("ORDER_SERVER_TRADER_RATE", value));
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_TRADER_BURST")) {
+        config.rate_limit.trader_burst = static_cast<uint32_t>(parseCount("ORDER_SERVER_TRADER_BURST", value));
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_CONNECTION_RATE")) {
+        config.rate_limit.connection_rate = static_cast<double>(parseLimit("ORDER_SERVER_CONNECTION_RATE", value));
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_CONNECTION_BURST")) {
+        config.rate_limit.connection_burst = static_cast<uint32_t>(parseCount("ORDER_SERVER_CONNECTION_BURST", value));
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_ORDER_WORKERS")) {
+        config.lanes.order_entry_workers = parseLimit("ORDER_SERVER_ORDER_WORKERS", value);
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_QUERY_WORKERS")) {
+        config.lanes.query_workers = parseCount("ORDER_SERVER_QUERY_WORKERS", value);
+    }
+    if (const char* value = getEnvironment("ORDER_SERVER_QUERY_SHARE_PCT")) {
+        unsigned long percent = parseCount("ORDER_SERVER_QUERY_SHARE_PCT", value);
+        if (percent > 100) {
+            throw std::invalid_argument("ORDER_SERVER_QUERY_SHARE_PCT must be at most 100");
+        }
+        config.lanes.query_share = static_cast<double>(percent) / 100.0;
+    }
+    if (const char* value = getEnvironment("ORDER_TRACE_SAMPLE_EVERY")) {
+        config.trace_sample_every = static_cast<uint32_t>(parseLimit("ORDER_TRACE_SAMPLE_EVERY", value));
+    }
+    if (const char* value = getEnvironment("ORDER_TRACE_PATH")) {
+        config.trace_path = value;
+    }
+    if (const char* value = getEnvironment("ORDER_METRICS_ADDRESS")) {
+        config.metrics_address = value;
+    }
+    return config;
+}
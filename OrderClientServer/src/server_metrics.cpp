@@ -0,0 +1,222 @@
+// src/server_metrics.cpp
+#include "server_metrics.hpp"
+#include "admission_controller.hpp"
+#include "lane_scheduler.hpp"
+#include "order_client_server.hpp"
+#include "rate_limiter.hpp"
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+
+namespace {
+    constexpr std::array<TracedRpc, kTracedRpcCount> kRpcs = {
+        TracedRpc::SubmitOrder, TracedRpc::CancelOrder, TracedRpc::ViewOrderBook, TracedRpc::GetOrderStatus};
+    constexpr std::array<CallOutcome, kCallOutcomeCount> kOutcomes = {
+        CallOutcome::Ok, CallOutcome::Throttled, CallOutcome::Shed, CallOutcome::Failed};
+    constexpr size_t kThrottledTradersReported = 20;
+
+    // Bucket bounds in nanoseconds, so observe() compares integers
+    constexpr std::array<int64_t, ShardedHistogram::kBoundsSeconds.size()> kBoundsNanos = [] {
+        std::array<int64_t, ShardedHistogram::kBoundsSeconds.size()> bounds{};
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            bounds[i] = static_cast<int64_t>(ShardedHistogram::kBoundsSeconds[i] * 1e9 + 0.5);
+        }
+        return bounds;
+    }();
+
+    // Label values may hold any string; Prometheus wants \, " and newline escaped
+    std::string escapeLabel(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            switch (c) {
+                case '\\': escaped += "\\\\"; break;
+                case '"': escaped += "\\\""; break;
+                case '\n': escaped += "\\n"; break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+        out += fmt::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    }
+
+    // `labels` is either empty or a comma-terminated label list
+    void appendHistogram(std::string& out, const char* name, const std::string& labels,
+                         const ShardedHistogram::Snapshot& snapshot) {
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < ShardedHistogram::kBucketCount; ++i) {
+            cumulative += snapshot.buckets[i];
+            std::string bound = i < ShardedHistogram::kBoundsSeconds.size()
+                ? fmt::format("{}", ShardedHistogram::kBoundsSeconds[i])
+                : std::string("+Inf");
+            out += fmt::format("{}_bucket{{{}le=\"{}\"}} {}\n", name, labels, bound, cumulative);
+        }
+        std::string plain_labels = labels.empty() ? std::string() : "{" + labels.substr(0, labels.size() - 1) + "}";
+        out += fmt::format("{}_sum{} {}\n", name, plain_labels, snapshot.sum_seconds);
+        out += fmt::format("{}_count{} {}\n", name, plain_labels, snapshot.count);
+    }
+
+    const char* laneName(RequestPriority lane) noexcept {
+        switch (lane) {
+            case RequestPriority::Cancel: return "cancel";
+            case RequestPriority::Order: return "order";
+            case RequestPriority::Query: return "query";
+        }
+        return "unknown";
+    }
+}
+
+size_t metricShard() noexcept {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+    return shard;
+}
+
+uint64_t ShardedCounter::value() const noexcept {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ShardedHistogram::observe(std::chrono::nanoseconds value) noexcept {
+    int64_t nanos = std::max<int64_t>(value.count(), 0);
+    size_t bucket = 0;
+    while (bucket < kBoundsNanos.size() && nanos > kBoundsNanos[bucket]) {
+        ++bucket;
+    }
+    Shard& shard = shards_[metricShard()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_ns.fetch_add(static_cast<uint64_t>(nanos), std::memory_order_relaxed);
+}
+
+ShardedHistogram::Snapshot ShardedHistogram::snapshot() const noexcept {
+    // Shards are read one at a time, so a scrape racing writers may see a
+    // sum and count a few observations apart; Prometheus tolerates that
+    Snapshot snapshot;
+    uint64_t sum_ns = 0;
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            uint64_t count = shard.buckets[i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += count;
+            snapshot.count += count;
+        }
+        sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+    }
+    snapshot.sum_seconds = static_cast<double>(sum_ns) / 1e9;
+    return snapshot;
+}
+
+const char* callOutcomeName(CallOutcome outcome) noexcept {
+    switch (outcome) {
+        case CallOutcome::Ok: return "ok";
+        case CallOutcome::Throttled: return "throttled";
+        case CallOutcome::Shed: return "shed";
+        case CallOutcome::Failed: return "failed";
+    }
+    return "unknown";
+}
+
+void ServerMetrics::recordCall(TracedRpc rpc, CallOutcome outcome, std::chrono::nanoseconds latency) noexcept {
+    auto rpc_index = static_cast<size_t>(rpc);
+    calls_[rpc_index][static_cast<size_t>(outcome)].add();
+    call_latency_[rpc_index].observe(latency);
+}
+
+uint64_t ServerMetrics::calls(TracedRpc rpc, CallOutcome outcome) const noexcept {
+    return calls_[static_cast<size_t>(rpc)][static_cast<size_t>(outcome)].value();
+}
+
+std::string ServerMetrics::render(const MetricsSources& sources) const {
+    std::string out;
+    out.reserve(16 * 1024);
+
+    appendHeader(out, "order_server_calls_total", "counter", "Unary calls handled, by RPC and outcome.");
+    for (TracedRpc rpc : kRpcs) {
+        for (CallOutcome outcome : kOutcomes) {
+            out += fmt::format("order_server_calls_total{{rpc=\"{}\",outcome=\"{}\"}} {}\n",
+                               tracedRpcName(rpc), callOutcomeName(outcome), calls(rpc, outcome));
+        }
+    }
+
+    appendHeader(out, "order_server_call_duration_seconds", "histogram",
+                 "Time from handler entry to Finish, including lane queueing.");
+    for (TracedRpc rpc : kRpcs) {
+        appendHistogram(out, "order_server_call_duration_seconds",
+                        fmt::format("rpc=\"{}\",", tracedRpcName(rpc)),
+                        call_latency_[static_cast<size_t>(rpc)].snapshot());
+    }
+
+    appendHeader(out, "order_server_lock_wait_seconds", "histogram", "Time requests waited for the order lock.");
+    appendHistogram(out, "order_server_lock_wait_seconds", "", lock_wait_.snapshot());
+
+    if (sources.server) {
+        auto books = sources.server->bookStats();
+        appendHeader(out, "order_server_book_orders", "gauge", "Resting orders, by symbol and side.");
+        for (const auto& book : books) {
+            std::string symbol = escapeLabel(book.symbol);
+            out += fmt::format("order_server_book_orders{{symbol=\"{}\",side=\"buy\"}} {}\n", symbol, book.buy.orders);
+            out += fmt::format("order_server_book_orders{{symbol=\"{}\",side=\"sell\"}} {}\n", symbol, book.sell.orders);
+        }
+        appendHeader(out, "order_server_book_price_levels", "gauge", "Distinct resting prices, by symbol and side.");
+        for (const auto& book : books) {
+            std::string symbol = escapeLabel(book.symbol);
+            out += fmt::format("order_server_book_price_levels{{symbol=\"{}\",side=\"buy\"}} {}\n",
+                               symbol, book.buy.price_levels);
+            out += fmt::format("order_server_book_price_levels{{symbol=\"{}\",side=\"sell\"}} {}\n",
+                               symbol, book.sell.price_levels);
+        }
+        appendHeader(out, "order_server_book_quantity", "gauge", "Resting quantity, by symbol and side.");
+        for (const auto& book : books) {
+            std::string symbol = escapeLabel(book.symbol);
+            out += fmt::format("order_server_book_quantity{{symbol=\"{}\",side=\"buy\"}} {}\n", symbol, book.buy.quantity);
+            out += fmt::format("order_server_book_quantity{{symbol=\"{}\",side=\"sell\"}} {}\n", symbol, book.sell.quantity);
+        }
+        appendHeader(out, "order_server_fills_total", "counter", "Resting orders hit by incoming orders, by symbol.");
+        for (const auto& book : books) {
+            out += fmt::format("order_server_fills_total{{symbol=\"{}\"}} {}\n", escapeLabel(book.symbol), book.fills);
+        }
+        appendHeader(out, "order_server_matched_quantity_total", "counter", "Quantity matched, by symbol.");
+        for (const auto& book : books) {
+            out += fmt::format("order_server_matched_quantity_total{{symbol=\"{}\"}} {}\n",
+                               escapeLabel(book.symbol), book.matched_quantity);
+        }
+    }
+
+    if (sources.admission) {
+        appendHeader(out, "order_server_admission_in_flight", "gauge", "Admitted requests not yet finished.");
+        out += fmt::format("order_server_admission_in_flight {}\n", sources.admission->inFlight());
+        appendHeader(out, "order_server_admission_overloaded", "gauge", "1 while queueing delay is above target.");
+        out += fmt::format("order_server_admission_overloaded {}\n", sources.admission->overloaded() ? 1 : 0);
+        appendHeader(out, "order_server_admission_rejected_total", "counter", "Requests shed by admission control.");
+        out += fmt::format("order_server_admission_rejected_total {}\n", sources.admission->rejected());
+    }
+
+    if (sources.lanes) {
+        appendHeader(out, "order_server_lane_queued", "gauge", "Tasks waiting for a lane worker, by lane.");
+        for (RequestPriority lane : {RequestPriority::Cancel, RequestPriority::Order, RequestPriority::Query}) {
+            out += fmt::format("order_server_lane_queued{{lane=\"{}\"}} {}\n", laneName(lane), sources.lanes->queued(lane));
+        }
+    }
+
+    if (sources.rate_limiter) {
+        appendHeader(out, "order_server_throttled_total", "counter", "Orders and cancels rejected by the rate limiter.");
+        out += fmt::format("order_server_throttled_total {}\n", sources.rate_limiter->throttledTotal());
+        // trader_id comes from the client, so only the worst offenders get a
+        // series of their own
+        appendHeader(out, "order_server_trader_throttled_total", "counter",
+                     "Orders and cancels rejected by the rate limiter, for the most throttled traders.");
+        for (const auto& [trader, throttled] : sources.rate_limiter->mostThrottledTraders(kThrottledTradersReported)) {
+            out += fmt::format("order_server_trader_throttled_total{{trader=\"{}\"}} {}\n", escapeLabel(trader), throttled);
+        }
+    }
+
+    if (sources.tracer) {
+        appendHeader(out, "order_server_traced_requests_total", "counter", "Requests recorded by the request tracer.");
+        out += fmt::format("order_server_traced_requests_total {}\n", sources.tracer->recorded());
+    }
+    return out;
+}
@@ -0,0 +1,34 @@
+// src/timestamp.cpp
+#include "timestamp.hpp"
+#include <chrono>
+#include <ctime>
+#include <limits>
+
+TimestampNanos currentTimestampNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const std::string& formatTimestamp(TimestampNanos nanos) {
+    struct FormattedSecond {
+        int64_t second = std::numeric_limits<int64_t>::min();
+        std::string text;
+    };
+    thread_local FormattedSecond cache;
+
+    int64_t second = nanos / 1'000'000'000;
+    if (nanos < 0 && nanos % 1'000'000'000 != 0) {
+        --second;
+    }
+    if (second != cache.second) {
+        std::time_t time = static_cast<std::time_t>(second);
+        std::tm local{};
+        localtime_r(&time, &local);
+
+        char buffer[32];
+        size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+        cache.text.assign(buffer, length);
+        cache.second = second;
+    }
+    return cache.text;
+}
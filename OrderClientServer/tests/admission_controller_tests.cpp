@@ -0,0 +1,87 @@
+// tests/admission_controller_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "admission_controller.hpp"
+#include <thread>
+#include <vector>
+
+class AdmissionControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+        config.max_in_flight = 2;
+        config.cancel_reserve = 1;
+        config.max_queries_in_flight = 1;
+        config.target_delay = std::chrono::microseconds(1000);
+        config.interval = std::chrono::milliseconds(10);
+    }
+
+    AdmissionConfig config;
+};
+
+TEST_F(AdmissionControllerTest, BudgetDependsOnPriority) {
+    AdmissionController admission(config);
+    std::vector<AdmissionController::Ticket> held;
+
+    // Queries stop first, once anything is in flight
+    held.push_back(admission.tryAdmit(RequestPriority::Query));
+    ASSERT_TRUE(held.back());
+    EXPECT_FALSE(admission.tryAdmit(RequestPriority::Query));
+
+    held.push_back(admission.tryAdmit(RequestPriority::Order));
+    ASSERT_TRUE(held.back());
+    auto rejected = admission.tryAdmit(RequestPriority::Order);
+    EXPECT_FALSE(rejected);
+    EXPECT_EQ(rejected.retryAfter(), config.retry_after);
+
+    // Cancels may use the reserve on top of the shared budget
+    held.push_back(admission.tryAdmit(RequestPriority::Cancel));
+    ASSERT_TRUE(held.back());
+    EXPECT_FALSE(admission.tryAdmit(RequestPriority::Cancel));
+    EXPECT_EQ(admission.inFlight(), 3u);
+    EXPECT_EQ(admission.rejected(), 3u);
+
+    held.clear();
+    EXPECT_EQ(admission.inFlight(), 0u);
+    EXPECT_TRUE(admission.tryAdmit(RequestPriority::Order));
+}
+
+TEST_F(AdmissionControllerTest, TicketsReleaseTheirSlotOnce) {
+    AdmissionController admission(config);
+    auto first = admission.tryAdmit(RequestPriority::Order);
+    AdmissionController::Ticket moved(std::move(first));
+    EXPECT_EQ(admission.inFlight(), 1u);
+
+    AdmissionController::Ticket assigned;
+    EXPECT_TRUE(assigned);  // Admitted without a budget
+    assigned = std::move(moved);
+    EXPECT_EQ(admission.inFlight(), 1u);
+
+    assigned = AdmissionController::Ticket();
+    EXPECT_EQ(admission.inFlight(), 0u);
+}
+
+TEST_F(AdmissionControllerTest, ShedsWhileDelayStandsAboveTarget) {
+    AdmissionController admission(config);
+
+    // A short spike is absorbed: the window also saw a fast request
+    admission.observeQueueDelay(std::chrono::milliseconds(5));
+    admission.observeQueueDelay(std::chrono::microseconds(10));
+    std::this_thread::sleep_for(config.interval);
+    admission.observeQueueDelay(std::chrono::milliseconds(5));
+    EXPECT_FALSE(admission.overloaded());
+
+    // Every request in a whole window waited too long
+    std::this_thread::sleep_for(config.interval);
+    admission.observeQueueDelay(std::chrono::milliseconds(5));
+    ASSERT_TRUE(admission.overloaded());
+
+    EXPECT_FALSE(admission.tryAdmit(RequestPriority::Order));
+    EXPECT_FALSE(admission.tryAdmit(RequestPriority::Query));
+    EXPECT_TRUE(admission.tryAdmit(RequestPriority::Cancel));
+
+    // With orders shed, a window without samples clears the state
+    std::this_thread::sleep_for(config.interval * 2);
+    EXPECT_TRUE(admission.tryAdmit(RequestPriority::Order));
+    EXPECT_FALSE(admission.overloaded());
+}
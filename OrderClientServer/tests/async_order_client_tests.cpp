@@ -0,0 +1,176 @@
+// tests/async_order_client_tests.cpp
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include "async_order_client.hpp"
+#include "in_process_server.hpp"
+#include <unistd.h>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace {
+    order_service::OrderDetails restingBuy(const std::string& order_id, double price) {
+        order_service::OrderDetails details;
+        details.set_order_id(order_id);
+        details.set_trader_id("trader1");
+        details.set_stock_symbol("AAPL");
+        details.set_price(price);
+        details.set_quantity(10);
+        details.set_is_buy_order(true);
+        return details;
+    }
+}
+
+TEST(AsyncOrderClientTest, CompletesFuturesAndCallbacks) {
+    InProcessServer server;
+    AsyncOrderClient client(server.clientConfig(2));
+    EXPECT_EQ(client.channelCount(), 2u);
+
+    auto submitted = client.submitOrder(restingBuy("o1", 100.0)).get();
+    ASSERT_TRUE(submitted.ok()) << submitted.status.error_message();
+    EXPECT_EQ(submitted.response.status(), order_service::OrderStatus::SUCCESS);
+
+    std::mutex mutex;
+    std::condition_variable answered;
+    bool done = false;
+    order_service::OrderStatus status = order_service::OrderStatus::UNKNOWN;
+    client.getOrderStatus("o1", [&](const grpc::Status& rpc, order_service::OrderStatusResponse& response) {
+        EXPECT_TRUE(rpc.ok());
+        std::lock_guard lock(mutex);
+        status = response.status();
+        done = true;
+        answered.notify_one();
+    });
+    {
+        std::unique_lock lock(mutex);
+        answered.wait(lock, [&] { return done; });
+    }
+    EXPECT_EQ(status, order_service::OrderStatus::SUCCESS);
+
+    auto book = client.viewOrderBook("AAPL").get();
+    ASSERT_TRUE(book.ok());
+    EXPECT_EQ(book.response.buy_orders_size(), 1);
+
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("o1");
+    cancel.set_is_buy_order(true);
+    cancel.set_trader_id("trader1");
+    auto cancelled = client.cancelOrder(cancel).get();
+    ASSERT_TRUE(cancelled.ok());
+    EXPECT_EQ(cancelled.response.status(), order_service::OrderStatus::CANCELLED);
+    EXPECT_EQ(client.inFlight(), 0u);
+}
+
+TEST(AsyncOrderClientTest, BatchesKeepInputOrder) {
+    InProcessServer server;
+    AsyncOrderClient client(server.clientConfig(3));
+
+    // Twice through the pool, so the second batch reuses its calls
+    std::vector<order_service::OrderDetails> orders;
+    for (int round = 0; round < 2; ++round) {
+        std::vector<order_service::OrderDetails> batch;
+        for (int i = 0; i < 150; ++i) {
+            batch.push_back(restingBuy("b" + std::to_string(round) + "_" + std::to_string(i), 50.0 + i * 0.01));
+        }
+        auto results = client.submitOrders(batch).get();
+        ASSERT_EQ(results.size(), batch.size());
+        for (const auto& result : results) {
+            ASSERT_TRUE(result.ok()) << result.status.error_message();
+            EXPECT_EQ(result.response.status(), order_service::OrderStatus::SUCCESS);
+        }
+        orders.insert(orders.end(), batch.begin(), batch.end());
+    }
+
+    // Every other cancel names an order that does not exist
+    std::vector<order_service::CancelRequest> cancels(2 * orders.size());
+    for (size_t i = 0; i < cancels.size(); ++i) {
+        cancels[i].set_order_id(i % 2 == 0 ? orders[i / 2].order_id() : "missing" + std::to_string(i));
+        cancels[i].set_is_buy_order(true);
+        cancels[i].set_trader_id("trader1");
+    }
+    auto cancelled = client.cancelOrders(cancels).get();
+    ASSERT_EQ(cancelled.size(), cancels.size());
+    for (size_t i = 0; i < cancelled.size(); ++i) {
+        ASSERT_TRUE(cancelled[i].ok());
+        EXPECT_EQ(cancelled[i].response.status() == order_service::OrderStatus::CANCELLED, i % 2 == 0) << i;
+    }
+
+    EXPECT_TRUE(client.submitOrders({}).get().empty());
+    EXPECT_EQ(client.viewOrderBook("").get().response.buy_orders_size(), 0);
+}
+
+TEST(AsyncOrderClientTest, AmendsReplaceOnlyCancelledOrders) {
+    InProcessServer server;
+    AsyncOrderClient client(server.clientConfig(2));
+    ASSERT_TRUE(client.submitOrder(restingBuy("o1", 100.0)).get().ok());
+
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("o1");
+    cancel.set_is_buy_order(true);
+    cancel.set_trader_id("trader1");
+    auto amended = client.amendOrder(cancel, restingBuy("o2", 99.0)).get();
+    ASSERT_TRUE(amended.ok()) << amended.status.error_message();
+    EXPECT_EQ(amended.cancel.status(), order_service::OrderStatus::CANCELLED);
+    EXPECT_TRUE(amended.replaced);
+    EXPECT_EQ(amended.replacement.status(), order_service::OrderStatus::SUCCESS);
+
+    // o1 is gone, so its second amend sends no replacement
+    auto repeated = client.amendOrder(cancel, restingBuy("o3", 98.0)).get();
+    ASSERT_TRUE(repeated.ok());
+    EXPECT_FALSE(repeated.replaced);
+    auto book = client.viewOrderBook("AAPL").get();
+    ASSERT_EQ(book.response.buy_orders_size(), 1);
+    EXPECT_EQ(book.response.buy_orders(0).details().order_id(), "o2");
+}
+
+TEST(AsyncOrderClientTest, ConnectsOverUnixSocket) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("async_order_client_test_" + std::to_string(::getpid()) + ".sock")).string();
+    InProcessServer server({.unix_socket_path = path});
+    OrderClientConfig config = server.clientConfig(2, OrderTransport::UnixSocket);
+    EXPECT_EQ(config.channelTarget(), "unix:" + path);
+
+    AsyncOrderClient client(config);
+    auto submitted = client.submitOrder(restingBuy("u1", 100.0)).get();
+    ASSERT_TRUE(submitted.ok()) << submitted.status.error_message();
+    EXPECT_EQ(submitted.response.status(), order_service::OrderStatus::SUCCESS);
+}
+
+TEST(AsyncOrderClientTest, RejectsIncompleteConfigs) {
+    OrderClientConfig config;
+    config.channels = 0;
+    EXPECT_THROW(AsyncOrderClient{config}, std::invalid_argument);
+
+    config.channels = 1;
+    config.transport = OrderTransport::UnixSocket;
+    EXPECT_THROW(AsyncOrderClient{config}, std::invalid_argument);
+    config.transport = OrderTransport::InProcess;
+    EXPECT_THROW(AsyncOrderClient{config}, std::invalid_argument);
+    EXPECT_THROW((void)config.channelTarget(), std::logic_error);
+}
+
+TEST(AsyncOrderClientTest, CallsStartedDuringDestructionAreRefused) {
+    InProcessServer server;
+    auto refused = std::make_shared<std::atomic<bool>>(false);
+    std::atomic<bool> destroying{false};
+    {
+        AsyncOrderClient client(server.clientConfig(1));
+        client.submitOrder(restingBuy("o1", 100.0), [&](const grpc::Status&, order_service::OrderResponse&) {
+            while (!destroying.load()) {
+                std::this_thread::yield();
+            }
+            // Keeps starting calls until the closing client refuses one
+            while (!refused->load()) {
+                client.getOrderStatus("o1", [refused](const grpc::Status& status,
+                                                      order_service::OrderStatusResponse&) {
+                    if (status.error_code() == grpc::StatusCode::CANCELLED) {
+                        refused->store(true);
+                    }
+                });
+            }
+        });
+        destroying = true;
+    }
+    EXPECT_TRUE(refused->load());
+}
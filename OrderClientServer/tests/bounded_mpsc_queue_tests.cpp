@@ -0,0 +1,53 @@
+// tests/bounded_mpsc_queue_tests.cpp
+#include <gtest/gtest.h>
+#include "bounded_mpsc_queue.hpp"
+#include <thread>
+#include <vector>
+
+TEST(BoundedMpscQueueTest, RejectsPushWhenFull) {
+    BoundedMpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.tryPush(4));
+}
+
+TEST(BoundedMpscQueueTest, DeliversEveryItemFromConcurrentProducers) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    BoundedMpscQueue<int> queue(256);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!queue.tryPush(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's items must arrive in order, and none may be lost
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        int value;
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / kPerProducer;
+        ASSERT_EQ(value % kPerProducer, next[producer]);
+        ++next[producer];
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+}
@@ -0,0 +1,184 @@
+// tests/execution_report_hub_tests.cpp
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "execution_report_hub.hpp"
+#include "in_process_server.hpp"
+#include "order_client_server.hpp"
+#include "order_service.pb.h"
+#include <thread>
+#include <vector>
+
+class ExecutionReportHubTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+
+        server = std::make_unique<OrderClientServer>();
+        server->setExecutionListener(
+            [this](const order_service::ExecutionReport& report) { hub.publish(report); },
+            [this] { hub.deliver(); });
+    }
+
+    void submit(const std::string& order_id, const std::string& trader_id,
+                double price, int quantity, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id(trader_id);
+        details->set_stock_symbol("AAPL");
+        details->set_price(price);
+        details->set_quantity(quantity);
+        details->set_is_buy_order(is_buy);
+        server->submitOrder(request);
+    }
+
+    ExecutionReportHub hub;
+    std::unique_ptr<OrderClientServer> server;
+};
+
+TEST_F(ExecutionReportHubTest, RestingOwnerReceivesFills) {
+    auto maker = hub.subscribe("maker", nullptr);
+    auto taker = hub.subscribe("taker", nullptr);
+
+    submit("sell1", "maker", 100.0, 50, false);
+    submit("buy1", "taker", 101.0, 30, true);
+    submit("buy2", "taker", 101.0, 20, true);
+
+    auto first = maker->pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->order_id(), "sell1");
+    EXPECT_EQ(first->status(), order_service::OrderStatus::PARTIAL_FILL);
+    EXPECT_EQ(first->quantity(), 30);
+    EXPECT_EQ(first->remaining_quantity(), 20);
+    EXPECT_DOUBLE_EQ(first->price(), 100.0);
+    EXPECT_FALSE(first->is_aggressor());
+
+    auto second = maker->pop();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->status(), order_service::OrderStatus::FULLY_FILLED);
+    EXPECT_EQ(second->remaining_quantity(), 0);
+    EXPECT_GT(second->execution_id(), first->execution_id());
+    EXPECT_FALSE(maker->pop().has_value());
+
+    auto taker_fill = taker->pop();
+    ASSERT_TRUE(taker_fill.has_value());
+    EXPECT_EQ(taker_fill->order_id(), "buy1");
+    EXPECT_EQ(taker_fill->status(), order_service::OrderStatus::FULLY_FILLED);
+    EXPECT_TRUE(taker_fill->is_aggressor());
+    EXPECT_EQ(taker->pending(), 1u);
+}
+
+TEST_F(ExecutionReportHubTest, CancelIsReported) {
+    auto maker = hub.subscribe("maker", nullptr);
+    submit("buy1", "maker", 99.0, 40, true);
+
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("buy1");
+    cancel.set_is_buy_order(true);
+    server->cancelOrder(cancel);
+
+    auto report = maker->pop();
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->status(), order_service::OrderStatus::CANCELLED);
+    EXPECT_EQ(report->quantity(), 40);
+    EXPECT_EQ(report->remaining_quantity(), 0);
+}
+
+TEST_F(ExecutionReportHubTest, OverflowStopsDeliveryInsteadOfDropping) {
+    int wakeups = 0;
+    auto slow = hub.subscribe("maker", [&wakeups] { ++wakeups; }, 2);
+
+    for (int i = 0; i < 3; ++i) {
+        submit("sell" + std::to_string(i), "maker", 100.0, 10, false);
+        submit("buy" + std::to_string(i), "taker", 100.0, 10, true);
+    }
+
+    EXPECT_TRUE(slow->overflowed());
+    EXPECT_EQ(slow->pending(), 2u);
+    EXPECT_EQ(wakeups, 3);
+
+    hub.unsubscribe(slow);
+    submit("sell9", "maker", 100.0, 10, false);
+    submit("buy9", "taker", 100.0, 10, true);
+    EXPECT_EQ(wakeups, 3);
+}
+
+TEST_F(ExecutionReportHubTest, ReportsArriveInExecutionOrderAcrossThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 300;
+    std::vector<std::shared_ptr<ExecutionSubscription>> subscriptions;
+    for (int t = 0; t < kThreads; ++t) {
+        subscriptions.push_back(hub.subscribe("trader" + std::to_string(t), nullptr, 1 << 16));
+    }
+
+    // Each thread rests a sell, crosses it with a smaller buy that may fill
+    // another thread's sell, then cancels what is left of its own
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t] {
+            std::string trader = "trader" + std::to_string(t);
+            for (int i = 0; i < kRounds; ++i) {
+                std::string id = trader + "_" + std::to_string(i);
+                submit("s" + id, trader, 100.0, 10, false);
+                submit("b" + id, trader, 100.0, 5, true);
+                order_service::CancelRequest cancel;
+                cancel.set_order_id("s" + id);
+                cancel.set_is_buy_order(false);
+                server->cancelOrder(cancel);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& subscription : subscriptions) {
+        EXPECT_FALSE(subscription->overflowed());
+        uint64_t last = 0;
+        size_t reports = 0;
+        while (auto report = subscription->pop()) {
+            EXPECT_GT(report->execution_id(), last) << report->order_id();
+            last = report->execution_id();
+            ++reports;
+        }
+        EXPECT_GT(reports, 0u);
+    }
+}
+
+TEST(ExecutionStreamTest, ReportsPublishedWhileSubscribingAreDelivered) {
+    spdlog::set_level(spdlog::level::warn);
+    InProcessServer server;
+    auto stub = order_service::OrderService::NewStub(server.channel());
+    ExecutionReportHub& hub = server.service().executionHub();
+
+    // Each report lands as soon as the stream's subscription exists, which
+    // races the reactor that is still setting itself up
+    for (int round = 0; round < 50; ++round) {
+        std::string trader_id = "trader" + std::to_string(round);
+        std::thread publisher([&hub, &trader_id, round] {
+            while (!hub.hasSubscribers(trader_id)) {
+                std::this_thread::yield();
+            }
+            order_service::ExecutionReport report;
+            report.set_execution_id(static_cast<uint64_t>(round) + 1);
+            report.set_trader_id(trader_id);
+            report.set_order_id("order" + std::to_string(round));
+            hub.publish(report);
+            hub.deliver();
+        });
+
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(5));
+        order_service::ExecutionStreamRequest request;
+        request.set_trader_id(trader_id);
+        auto reader = stub->StreamExecutions(&context, request);
+        order_service::ExecutionReport report;
+        bool delivered = reader->Read(&report);
+        publisher.join();
+        ASSERT_TRUE(delivered) << "round " << round;
+        EXPECT_EQ(report.order_id(), "order" + std::to_string(round));
+        context.TryCancel();
+        reader->Finish();
+    }
+}
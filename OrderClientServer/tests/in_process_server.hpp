@@ -0,0 +1,90 @@
+// tests/in_process_server.hpp
+#ifndef IN_PROCESS_SERVER_HPP
+#define IN_PROCESS_SERVER_HPP
+
+#include <grpcpp/grpcpp.h>
+#include "admission_controller.hpp"
+#include "async_order_client.hpp"
+#include "lane_scheduler.hpp"
+#include "order_client_server.hpp"
+#include "order_service.hpp"
+#include "rate_limiter.hpp"
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+struct InProcessServerOptions {
+    // Served as given, e.g. with a preloaded book; a new one if null
+    std::shared_ptr<OrderClientServer> orders;
+    // Passed to OrderServiceImpl; each is off when null
+    std::shared_ptr<AdmissionController> admission;
+    std::shared_ptr<RateLimiter> rate_limiter;
+    std::shared_ptr<LaneScheduler> lanes;
+    std::string unix_socket_path;  // Also listen on this socket when set
+    bool listen_tcp = false;       // Also listen on a free loopback port
+};
+
+// An order server in the calling process, for tests and benchmarks. It is
+// always reachable over in-process channels, which need no port, and
+// optionally over a unix socket and loopback TCP as well.
+class InProcessServer {
+public:
+    explicit InProcessServer(InProcessServerOptions options = {})
+        : orders_(options.orders ? std::move(options.orders) : std::make_shared<OrderClientServer>())
+        , service_(std::make_unique<OrderServiceImpl>(orders_, nullptr, std::move(options.admission),
+                                                      std::move(options.rate_limiter), std::move(options.lanes)))
+        , unix_socket_path_(std::move(options.unix_socket_path))
+    {
+        grpc::ServerBuilder builder;
+        if (options.listen_tcp) {
+            builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &tcp_port_);
+        }
+        if (!unix_socket_path_.empty()) {
+            builder.AddListeningPort("unix:" + unix_socket_path_, grpc::InsecureServerCredentials());
+        }
+        builder.RegisterService(service_.get());
+        grpc_server_ = builder.BuildAndStart();
+        if (!grpc_server_ || (options.listen_tcp && tcp_port_ == 0)) {
+            throw std::runtime_error("cannot start the in-process server");
+        }
+    }
+
+    ~InProcessServer() {
+        grpc_server_->Shutdown();
+        if (!unix_socket_path_.empty()) {
+            std::filesystem::remove(unix_socket_path_);
+        }
+    }
+
+    InProcessServer(const InProcessServer&) = delete;
+    InProcessServer& operator=(const InProcessServer&) = delete;
+
+    std::shared_ptr<grpc::Channel> channel() { return grpc_server_->InProcessChannel(grpc::ChannelArguments()); }
+
+    // A client config for one of the transports this server listens on
+    OrderClientConfig clientConfig(size_t channels, OrderTransport transport = OrderTransport::InProcess) {
+        OrderClientConfig config;
+        config.transport = transport;
+        config.target = "127.0.0.1:" + std::to_string(tcp_port_);
+        config.unix_socket_path = unix_socket_path_;
+        config.in_process_server = grpc_server_.get();
+        config.channels = channels;
+        if (transport != OrderTransport::InProcess) {
+            config.connect_timeout = std::chrono::seconds(5);
+        }
+        return config;
+    }
+
+    OrderClientServer& orders() { return *orders_; }
+    OrderServiceImpl& service() { return *service_; }
+
+private:
+    std::shared_ptr<OrderClientServer> orders_;
+    std::unique_ptr<OrderServiceImpl> service_;
+    std::string unix_socket_path_;
+    int tcp_port_ = 0;
+    std::unique_ptr<grpc::Server> grpc_server_;
+};
+
+#endif // IN_PROCESS_SERVER_HPP
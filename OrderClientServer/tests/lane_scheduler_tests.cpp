@@ -0,0 +1,143 @@
+// tests/lane_scheduler_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "lane_scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class LaneSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+        config.order_entry_workers = 1;
+        config.query_workers = 1;
+    }
+
+    // Occupies the single order-entry worker until release() is called
+    void blockOrderEntry(LaneScheduler& lanes) {
+        std::promise<void> started;
+        auto running = started.get_future();
+        ASSERT_TRUE(lanes.submit(RequestPriority::Order, [this, &started] {
+            started.set_value();
+            gate.wait();
+        }));
+        running.wait();
+    }
+
+    void release() { gate_promise.set_value(); }
+
+    LaneConfig config;
+    std::promise<void> gate_promise;
+    std::shared_future<void> gate = gate_promise.get_future().share();
+};
+
+TEST_F(LaneSchedulerTest, CancelsOvertakeQueuedOrders) {
+    LaneScheduler lanes(config);
+    std::vector<std::chrono::nanoseconds> delays;
+    lanes.setQueueDelayListener([&delays](RequestPriority, std::chrono::nanoseconds delay) {
+        delays.push_back(delay);
+    });
+    lanes.start();
+    blockOrderEntry(lanes);
+
+    std::mutex mutex;
+    std::vector<std::string> ran;
+    auto record = [&](std::string name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(mutex);
+            ran.push_back(name);
+        };
+    };
+    ASSERT_TRUE(lanes.submit(RequestPriority::Order, record("order1")));
+    ASSERT_TRUE(lanes.submit(RequestPriority::Order, record("order2")));
+    ASSERT_TRUE(lanes.submit(RequestPriority::Cancel, record("cancel1")));
+    EXPECT_EQ(lanes.queued(RequestPriority::Order), 2u);
+
+    release();
+    lanes.stop();
+    EXPECT_EQ(ran, (std::vector<std::string>{"cancel1", "order1", "order2"}));
+    EXPECT_EQ(delays.size(), 4u);
+}
+
+TEST_F(LaneSchedulerTest, FullLaneRefusesWorkAndStopDrains) {
+    config.max_queued = 1;
+    LaneScheduler lanes(config);
+    lanes.start();
+    blockOrderEntry(lanes);
+
+    std::atomic<int> ran{0};
+    EXPECT_TRUE(lanes.submit(RequestPriority::Order, [&ran] { ++ran; }));
+    EXPECT_FALSE(lanes.submit(RequestPriority::Order, [&ran] { ++ran; }));
+    // Lanes are bounded separately
+    EXPECT_TRUE(lanes.submit(RequestPriority::Cancel, [&ran] { ++ran; }));
+
+    release();
+    lanes.stop();
+    EXPECT_EQ(ran.load(), 2);
+    EXPECT_FALSE(lanes.submit(RequestPriority::Order, [&ran] { ++ran; }));
+}
+
+TEST_F(LaneSchedulerTest, QueriesArePacedWithoutDelayingOrders) {
+    config.query_share = 0.5;
+    LaneScheduler lanes(config);
+    lanes.start();
+
+    const auto work = std::chrono::milliseconds(10);
+    auto busy = [work] {
+        auto end = std::chrono::steady_clock::now() + work;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::promise<void> queries_done;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(lanes.submit(RequestPriority::Query, busy));
+    }
+    ASSERT_TRUE(lanes.submit(RequestPriority::Query, [&queries_done] { queries_done.set_value(); }));
+
+    // An order submitted behind the queries runs on its own lane
+    std::promise<void> order_done;
+    ASSERT_TRUE(lanes.submit(RequestPriority::Order, [&order_done] { order_done.set_value(); }));
+    EXPECT_EQ(order_done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    // 30 ms of query work at a 50% share takes at least 60 ms of wall time
+    queries_done.get_future().wait();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 6 * work - std::chrono::milliseconds(5));
+}
+
+TEST_F(LaneSchedulerTest, PacedQueriesRunOneAtATimeOnSeveralWorkers) {
+    config.query_workers = 3;
+    config.query_share = 0.5;
+    LaneScheduler lanes(config);
+    lanes.start();
+
+    const auto work = std::chrono::milliseconds(10);
+    std::atomic<int> running{0};
+    std::atomic<int> most_running{0};
+    auto query = [&] {
+        int now_running = running.fetch_add(1) + 1;
+        int most = most_running.load();
+        while (now_running > most && !most_running.compare_exchange_weak(most, now_running)) {
+        }
+        std::this_thread::sleep_for(work);
+        running.fetch_sub(1);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(lanes.submit(RequestPriority::Query, query));
+    }
+    std::promise<void> queries_done;
+    ASSERT_TRUE(lanes.submit(RequestPriority::Query, [&queries_done] { queries_done.set_value(); }));
+    queries_done.get_future().wait();
+
+    // 40 ms of query work at a 50% share takes at least 80 ms of wall time
+    EXPECT_EQ(most_running.load(), 1);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 8 * work - std::chrono::milliseconds(5));
+}
@@ -0,0 +1,58 @@
+// tests/load_generator_tests.cpp
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+#include "in_process_server.hpp"
+#include "load_generator.hpp"
+
+TEST(LoadGeneratorTest, ParsesMix) {
+    EXPECT_EQ(LoadConfig::parseMix("60:30:10"), (std::array<uint32_t, kLoadRpcCount>{60, 30, 10}));
+    EXPECT_EQ(LoadConfig::parseMix("1:0:0"), (std::array<uint32_t, kLoadRpcCount>{1, 0, 0}));
+    EXPECT_THROW(LoadConfig::parseMix("60:30"), std::invalid_argument);
+    EXPECT_THROW(LoadConfig::parseMix("0:0:0"), std::invalid_argument);
+    EXPECT_THROW(LoadConfig::parseMix("a:b:c"), std::invalid_argument);
+    EXPECT_THROW(LoadConfig::parseMix("1:2:3:4"), std::invalid_argument);
+}
+
+TEST(LoadGeneratorTest, RejectsConfigsThatCannotRun) {
+    LoadConfig config;
+    config.clients = 0;
+    EXPECT_THROW(LoadGenerator{config}, std::invalid_argument);
+    config.clients = 1;
+    config.rate_per_second = 0.0;
+    EXPECT_THROW(LoadGenerator{config}, std::invalid_argument);
+}
+
+TEST(LoadGeneratorTest, RunsTheMixAtTheTargetRate) {
+    spdlog::set_level(spdlog::level::warn);
+    InProcessServer server;
+    LoadConfig config;
+    config.clients = 2;
+    config.rate_per_second = 2000.0;
+    config.seconds = 0.5;
+    config.mix = {50, 30, 20};
+
+    LoadReport report = LoadGenerator(config, [&server](int) { return server.channel(); }).run();
+    spdlog::set_level(spdlog::level::info);
+
+    // An open-loop schedule sends exactly rate * seconds calls
+    EXPECT_EQ(report.sent(), 1000u);
+    EXPECT_EQ(report.answered(), report.sent());
+    for (const auto& stats : report.rpcs) {
+        EXPECT_EQ(stats.shed, 0u);
+        EXPECT_EQ(stats.failed, 0u);
+        EXPECT_EQ(stats.latency.count(), stats.ok + stats.rejected);
+    }
+    const LoadRpcStats& news = report.stats(LoadRpc::New);
+    const LoadRpcStats& cancels = report.stats(LoadRpc::Cancel);
+    const LoadRpcStats& amends = report.stats(LoadRpc::Amend);
+    EXPECT_GT(cancels.sent, 0u);
+    EXPECT_GT(amends.sent, 0u);
+    // Cancels and amends only target acknowledged resting orders
+    EXPECT_EQ(cancels.rejected + amends.rejected, 0u);
+
+    // Everything still resting is on the book
+    auto book = server.orders().getOrderBook(order_service::ViewOrderBookRequest());
+    uint64_t resting = news.ok - cancels.ok;
+    EXPECT_EQ(static_cast<uint64_t>(book.buy_orders_size() + book.sell_orders_size()), resting);
+}
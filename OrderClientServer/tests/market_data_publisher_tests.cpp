@@ -0,0 +1,105 @@
+// tests/market_data_publisher_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "market_data_publisher.hpp"
+#include "order_client_server.hpp"
+#include "order_service.pb.h"
+
+class MarketDataPublisherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+
+        server = std::make_shared<OrderClientServer>();
+        // Not started: tests drive publishPending() directly
+        publisher = std::make_unique<MarketDataPublisher>(server);
+        server->setBookUpdateListener([this](const std::string& symbol) {
+            publisher->markDirty(symbol);
+        });
+    }
+
+    void submit(const std::string& order_id, const std::string& symbol, double price, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("trader1");
+        details->set_stock_symbol(symbol);
+        details->set_price(price);
+        details->set_quantity(10);
+        details->set_is_buy_order(is_buy);
+        server->submitOrder(request);
+    }
+
+    static order_service::ViewOrderBookResponse parse(const SerializedBookUpdate& update) {
+        order_service::ViewOrderBookResponse response;
+        EXPECT_TRUE(response.ParseFromString(*update));
+        return response;
+    }
+
+    std::shared_ptr<OrderClientServer> server;
+    std::unique_ptr<MarketDataPublisher> publisher;
+};
+
+TEST_F(MarketDataPublisherTest, SerializesOncePerSymbol) {
+    int notified = 0;
+    auto first = publisher->subscribe("AAPL", [&notified] { ++notified; });
+    auto second = publisher->subscribe("AAPL", [&notified] { ++notified; });
+
+    submit("buy1", "AAPL", 100.0, true);
+    EXPECT_EQ(publisher->publishPending(), 1u);
+    EXPECT_EQ(publisher->serializedCount(), 1u);
+    EXPECT_EQ(notified, 2);
+
+    auto a = first->pop();
+    auto b = second->pop();
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a.get(), b.get());  // Same shared buffer, not a copy
+    EXPECT_EQ(parse(a).buy_orders_size(), 1);
+}
+
+TEST_F(MarketDataPublisherTest, SlowSubscriberIsConflated) {
+    auto slow = publisher->subscribe("AAPL", nullptr, 2);
+
+    for (int i = 0; i < 5; ++i) {
+        submit("buy" + std::to_string(i), "AAPL", 100.0 + i, true);
+        publisher->publishPending();
+    }
+
+    EXPECT_EQ(slow->pending(), 2u);
+    EXPECT_EQ(slow->conflated(), 3u);
+
+    slow->pop();
+    auto latest = slow->pop();
+    ASSERT_NE(latest, nullptr);
+    EXPECT_EQ(parse(latest).buy_orders_size(), 5);
+    EXPECT_EQ(slow->pop(), nullptr);
+}
+
+TEST_F(MarketDataPublisherTest, OnlyAffectedTopicsArePublished) {
+    auto aapl = publisher->subscribe("AAPL", nullptr);
+    auto all = publisher->subscribe("", nullptr);
+    publisher->publishPending();
+    aapl->pop();
+    all->pop();
+
+    submit("msft1", "MSFT", 50.0, true);
+    EXPECT_EQ(publisher->publishPending(), 1u);
+    EXPECT_EQ(aapl->pending(), 0u);
+    EXPECT_EQ(all->pending(), 1u);
+}
+
+TEST_F(MarketDataPublisherTest, LateSubscriberGetsLatestState) {
+    auto early = publisher->subscribe("AAPL", nullptr);
+    submit("buy1", "AAPL", 100.0, true);
+    publisher->publishPending();
+
+    int notified = 0;
+    auto late = publisher->subscribe("AAPL", [&notified] { ++notified; });
+    EXPECT_EQ(notified, 1);
+    EXPECT_EQ(late->pop().get(), early->pop().get());
+
+    publisher->unsubscribe(late);
+    publisher->unsubscribe(early);
+    submit("buy2", "AAPL", 101.0, true);
+    EXPECT_EQ(publisher->publishPending(), 0u);
+}
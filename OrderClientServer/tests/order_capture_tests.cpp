@@ -0,0 +1,131 @@
+// tests/order_capture_tests.cpp
+#include <gtest/gtest.h>
+#include "order_capture.hpp"
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string tempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() /
+                ("order_capture_test_" + std::to_string(::getpid()) + "_" + name + ".ocap")).string();
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    void writeFile(const std::string& path, const std::string& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+}
+
+TEST(OrderCaptureTest, RoundTripsEveryCommand) {
+    std::string path = tempPath("round_trip");
+    {
+        CaptureWriter writer(path);
+        writer.writeNew(1000, "o1", "trader1", "AAPL", 150.25, 100, true);
+        writer.writeNew(2000, "o2", "trader1", "AAPL", 150.5, 50, false);
+        writer.writeCancel(3000, "o1", "trader1", {}, true);
+        writer.writeAmend(4000, "o2", "o3", "trader1", "AAPL", 150.4999, 40, false);
+        EXPECT_EQ(writer.recordCount(), 4u);
+        writer.close();
+    }
+
+    CaptureReader reader(path);
+    EXPECT_EQ(reader.header().version, kCaptureVersion);
+    EXPECT_EQ(reader.header().price_scale, CaptureWriter::kDefaultPriceScale);
+    // trader1 and AAPL are each stored once; order ids are in the records
+    EXPECT_EQ(reader.stringCount(), 2u);
+    auto records = reader.records();
+    ASSERT_EQ(records.size(), 4u);
+
+    EXPECT_EQ(records[0].type, CaptureType::New);
+    EXPECT_EQ(records[0].timestamp_ns, 1000);
+    EXPECT_EQ(records[0].price, 1502500);
+    EXPECT_DOUBLE_EQ(reader.price(records[0]), 150.25);
+    EXPECT_EQ(records[0].orderId(), "o1");
+    EXPECT_EQ(records[0].replacesOrderId(), "");
+    EXPECT_EQ(reader.string(records[0].trader_ref), "trader1");
+    EXPECT_EQ(reader.string(records[0].symbol_ref), "AAPL");
+    EXPECT_EQ(records[0].quantity, 100);
+    EXPECT_EQ(records[0].is_buy, 1);
+    EXPECT_EQ(records[1].is_buy, 0);
+    EXPECT_EQ(records[1].symbol_ref, records[0].symbol_ref);
+
+    EXPECT_EQ(records[2].type, CaptureType::Cancel);
+    EXPECT_EQ(records[2].orderId(), "o1");
+    EXPECT_EQ(records[2].symbol_ref, kNoCaptureRef);
+    EXPECT_EQ(reader.string(records[2].symbol_ref), "");
+
+    EXPECT_EQ(records[3].type, CaptureType::Amend);
+    EXPECT_EQ(records[3].replacesOrderId(), "o2");
+    EXPECT_EQ(records[3].orderId(), "o3");
+    EXPECT_EQ(records[3].price, 1504999);
+    EXPECT_THROW((void)reader.string(2), std::out_of_range);
+
+    std::filesystem::remove(path);
+}
+
+TEST(OrderCaptureTest, EmptyCaptureHasOnlyAHeader) {
+    std::string path = tempPath("empty");
+    CaptureWriter(path).close();
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(CaptureHeader));
+
+    CaptureReader reader(path);
+    EXPECT_TRUE(reader.records().empty());
+    EXPECT_EQ(reader.stringCount(), 0u);
+    std::filesystem::remove(path);
+}
+
+TEST(OrderCaptureTest, RejectsMalformedFiles) {
+    std::string path = tempPath("malformed");
+    {
+        CaptureWriter writer(path);
+        writer.writeNew(0, "o1", "trader1", "AAPL", 10.0, 1, true);
+    }  // The destructor completes the file
+    const std::string good = readFile(path);
+    ASSERT_NO_THROW(CaptureReader{path});
+
+    std::string bytes = good;
+    bytes[0] = 'X';
+    writeFile(path, bytes);
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+
+    bytes = good;
+    uint16_t version = kCaptureVersion + 1;
+    std::memcpy(bytes.data() + offsetof(CaptureHeader, version), &version, sizeof(version));
+    writeFile(path, bytes);
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+
+    // Cut into the record, then into the dictionary
+    writeFile(path, good.substr(0, sizeof(CaptureHeader) + 8));
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+    writeFile(path, good.substr(0, good.size() - 1));
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+
+    // A string count the dictionary cannot hold
+    bytes = good;
+    uint32_t string_count = UINT32_MAX - 1;
+    std::memcpy(bytes.data() + offsetof(CaptureHeader, string_count), &string_count, sizeof(string_count));
+    writeFile(path, bytes);
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+
+    writeFile(path, "");
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(CaptureReader{path}, std::runtime_error);
+
+    EXPECT_THROW(CaptureWriter(path, 0), std::invalid_argument);
+    CaptureWriter writer(path);
+    EXPECT_THROW(writer.writeNew(0, "o1", "trader1", "AAPL", 1e300, 1, true), std::invalid_argument);
+    EXPECT_THROW(writer.writeCancel(0, std::string(kCaptureOrderIdSize + 1, 'x'), "trader1", {}, true),
+                 std::invalid_argument);
+    writer.writeCancel(0, std::string(kCaptureOrderIdSize, 'x'), "trader1", {}, true);
+    EXPECT_EQ(writer.recordCount(), 1u);
+    writer.close();
+    std::filesystem::remove(path);
+}
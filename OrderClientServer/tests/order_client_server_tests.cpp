@@ -5,6 +5,7 @@
 #include "order_service.hpp"
 #include "order_service.pb.h"
 #include "order_service.grpc.pb.h"
+#include <set>
 
 class OrderClientServerTest : public ::testing::Test {
 protected:
@@ -155,3 +156,138 @@ TEST_F(OrderClientServerTest, PriceCrossingTest) {
     EXPECT_EQ(orderBook.buy_orders_size(), 0);
     EXPECT_EQ(orderBook.sell_orders_size(), 0);
 }
+
+TEST_F(OrderClientServerTest, SnapshotChunksCoverBookOnce) {
+    // Resting, non-crossing orders on both sides plus another symbol
+    for (int i = 0; i < 7; ++i) {
+        server->submitOrder(createOrderRequest(
+            "buy" + std::to_string(i), "trader1", "AAPL", 90.0 + i, 10, true));
+    }
+    for (int i = 0; i < 5; ++i) {
+        server->submitOrder(createOrderRequest(
+            "sell" + std::to_string(i), "trader2", "AAPL", 110.0 + i, 10, false));
+    }
+    server->submitOrder(createOrderRequest("msft1", "trader3", "MSFT", 50.0, 10, true));
+
+    order_service::OrderBookSnapshotRequest request;
+    request.set_symbol("AAPL");
+    request.set_max_orders_per_chunk(3);
+
+    std::set<std::string> seen;
+    int chunks = 0;
+    while (true) {
+        auto chunk = server->getOrderBookChunk(request);
+        ++chunks;
+        EXPECT_LE(chunk.buy_orders_size() + chunk.sell_orders_size(), 3);
+        for (const auto& entry : chunk.buy_orders()) {
+            EXPECT_TRUE(entry.details().is_buy_order());
+            EXPECT_TRUE(seen.insert(entry.details().order_id()).second);
+        }
+        for (const auto& entry : chunk.sell_orders()) {
+            EXPECT_FALSE(entry.details().is_buy_order());
+            EXPECT_TRUE(seen.insert(entry.details().order_id()).second);
+        }
+        if (chunk.last_chunk()) {
+            break;
+        }
+        *request.mutable_cursor() = chunk.next_cursor();
+        ASSERT_LT(chunks, 10);
+    }
+
+    EXPECT_EQ(seen.size(), 12u);
+    EXPECT_EQ(chunks, 4);
+    EXPECT_EQ(seen.count("msft1"), 0u);
+}
+
+TEST_F(OrderClientServerTest, SnapshotResumesAfterBookChanges) {
+    for (int i = 0; i < 4; ++i) {
+        server->submitOrder(createOrderRequest(
+            "buy" + std::to_string(i), "trader1", "AAPL", 90.0 + i, 10, true));
+    }
+
+    order_service::OrderBookSnapshotRequest request;
+    request.set_max_orders_per_chunk(2);
+    auto first = server->getOrderBookChunk(request);
+    ASSERT_EQ(first.buy_orders_size(), 2);
+    EXPECT_FALSE(first.last_chunk());
+
+    // An order cancelled before the cursor reaches it is simply skipped
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("buy3");
+    cancel.set_is_buy_order(true);
+    server->cancelOrder(cancel);
+
+    *request.mutable_cursor() = first.next_cursor();
+    auto second = server->getOrderBookChunk(request);
+    ASSERT_EQ(second.buy_orders_size(), 1);
+    EXPECT_EQ(second.buy_orders(0).details().order_id(), "buy2");
+    EXPECT_TRUE(second.last_chunk());
+}
+
+TEST_F(OrderClientServerTest, ResponseAndEntryShareOneTimestamp) {
+    auto response = server->submitOrder(createOrderRequest("order1", "trader1", "AAPL", 150.0, 100, true));
+    EXPECT_GT(response.timestamp_ns(), 0);
+    EXPECT_FALSE(response.timestamp().empty());
+
+    order_service::ViewOrderBookRequest book_request;
+    book_request.set_symbol("AAPL");
+    auto book = server->getOrderBook(book_request);
+    ASSERT_EQ(book.buy_orders_size(), 1);
+    EXPECT_EQ(book.buy_orders(0).timestamp_ns(), response.timestamp_ns());
+    EXPECT_EQ(book.buy_orders(0).timestamp(), response.timestamp());
+    EXPECT_GE(book.timestamp_ns(), response.timestamp_ns());
+}
+
+TEST_F(OrderClientServerTest, BookStatsFollowFillsAndCancels) {
+    server->submitOrder(createOrderRequest("b1", "trader1", "AAPL", 100.0, 10, true));
+    server->submitOrder(createOrderRequest("b2", "trader1", "AAPL", 100.0, 20, true));
+    server->submitOrder(createOrderRequest("b3", "trader1", "AAPL", 99.0, 30, true));
+    server->submitOrder(createOrderRequest("m1", "trader1", "MSFT", 50.0, 5, true));
+    // Fills all of b1 and half of b2
+    server->submitOrder(createOrderRequest("s1", "trader2", "AAPL", 100.0, 20, false));
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("b3");
+    cancel.set_is_buy_order(true);
+    server->cancelOrder(cancel);
+
+    auto stats = server->bookStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].symbol, "AAPL");
+    EXPECT_EQ(stats[0].buy.orders, 1u);
+    EXPECT_EQ(stats[0].buy.price_levels, 1u);
+    EXPECT_EQ(stats[0].buy.quantity, 10);
+    EXPECT_EQ(stats[0].sell.orders, 0u);
+    EXPECT_EQ(stats[0].fills, 2u);
+    EXPECT_EQ(stats[0].matched_quantity, 20u);
+    EXPECT_EQ(stats[1].symbol, "MSFT");
+    EXPECT_EQ(stats[1].buy.orders, 1u);
+    EXPECT_EQ(stats[1].buy.quantity, 5);
+}
+
+TEST_F(OrderClientServerTest, MatchingKeepsTimePriorityAndArrivalOrder) {
+    server->submitOrder(createOrderRequest("s1", "trader1", "AAPL", 101.0, 10, false));
+    server->submitOrder(createOrderRequest("s2", "trader1", "AAPL", 100.0, 10, false));
+    server->submitOrder(createOrderRequest("s3", "trader1", "AAPL", 100.0, 10, false));
+    server->submitOrder(createOrderRequest("s4", "trader1", "AAPL", 102.0, 10, false));
+
+    // Best price first, then the earlier of the two orders at that price
+    auto response = server->submitOrder(createOrderRequest("b1", "trader2", "AAPL", 101.0, 15, true));
+    EXPECT_EQ(response.matched_quantity(), 15);
+
+    auto book = server->getOrderBook(order_service::ViewOrderBookRequest());
+    ASSERT_EQ(book.sell_orders_size(), 3);
+    EXPECT_EQ(book.sell_orders(0).details().order_id(), "s1");
+    EXPECT_EQ(book.sell_orders(1).details().order_id(), "s3");
+    EXPECT_EQ(book.sell_orders(1).remaining_quantity(), 5);
+    EXPECT_EQ(book.sell_orders(2).details().order_id(), "s4");
+
+    // The remaining sells are still in arrival order, so a cursor resumes
+    // after s3 without revisiting s1
+    order_service::OrderBookSnapshotRequest request;
+    request.mutable_cursor()->set_sell_side(true);
+    request.mutable_cursor()->set_after_sequence(book.sell_orders(1).sequence());
+    auto chunk = server->getOrderBookChunk(request);
+    ASSERT_EQ(chunk.sell_orders_size(), 1);
+    EXPECT_EQ(chunk.sell_orders(0).details().order_id(), "s4");
+    EXPECT_TRUE(chunk.last_chunk());
+}
@@ -0,0 +1,98 @@
+// tests/order_event_log_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "order_client_server.hpp"
+#include "order_event_log.hpp"
+#include "order_service.pb.h"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+    int countLogged(OrderEventLog& log, int calls) {
+        int logged = 0;
+        for (int i = 0; i < calls; ++i) {
+            logged += log.shouldLog() ? 1 : 0;
+        }
+        return logged;
+    }
+}
+
+TEST(OrderEventLogTest, SamplesOneOrderInN) {
+    OrderLogConfig config;
+    config.mode = OrderLogMode::Sampled;
+    config.sample_every = 4;
+    OrderEventLog log(config);
+    EXPECT_EQ(countLogged(log, 12), 3);
+}
+
+TEST(OrderEventLogTest, OffModeLogsNothing) {
+    OrderLogConfig config;
+    config.mode = OrderLogMode::Off;
+    OrderEventLog log(config);
+    EXPECT_EQ(countLogged(log, 10), 0);
+}
+
+TEST(OrderEventLogTest, AuditRecordsOrdersFillsAndCancels) {
+    spdlog::set_level(spdlog::level::warn);
+    auto path = std::filesystem::temp_directory_path() /
+                ("order_audit_test_" + std::to_string(::getpid()) + ".bin");
+    std::filesystem::remove(path);
+
+    {
+        OrderLogConfig config;
+        config.mode = OrderLogMode::Audit;
+        config.audit_path = path.string();
+        auto log = std::make_shared<OrderEventLog>(config);
+
+        OrderClientServer server;
+        server.setOrderEventLog(log);
+
+        order_service::OrderRequest sell;
+        sell.mutable_details()->set_order_id("sell1");
+        sell.mutable_details()->set_trader_id("maker");
+        sell.mutable_details()->set_stock_symbol("AAPL");
+        sell.mutable_details()->set_price(100.0);
+        sell.mutable_details()->set_quantity(100);
+        server.submitOrder(sell);
+
+        order_service::OrderRequest buy = sell;
+        buy.mutable_details()->set_order_id("buy1");
+        buy.mutable_details()->set_trader_id("taker");
+        buy.mutable_details()->set_price(101.0);
+        buy.mutable_details()->set_quantity(40);
+        buy.mutable_details()->set_is_buy_order(true);
+        server.submitOrder(buy);
+
+        order_service::CancelRequest cancel;
+        cancel.set_order_id("sell1");
+        server.cancelOrder(cancel);
+        EXPECT_EQ(log->droppedRecords(), 0u);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<OrderAuditRecord> records;
+    OrderAuditRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        records.push_back(record);
+    }
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[0].type, OrderAuditRecord::Type::Order);
+    EXPECT_STREQ(records[0].order_id, "sell1");
+    EXPECT_EQ(records[1].type, OrderAuditRecord::Type::Order);
+    EXPECT_EQ(records[1].status, order_service::OrderStatus::FULLY_FILLED);
+
+    EXPECT_EQ(records[2].type, OrderAuditRecord::Type::Fill);
+    EXPECT_STREQ(records[2].order_id, "buy1");
+    EXPECT_STREQ(records[2].counterparty_order_id, "sell1");
+    EXPECT_EQ(records[2].quantity, 40);
+    EXPECT_DOUBLE_EQ(records[2].price, 100.0);
+    EXPECT_EQ(records[2].timestamp_ns, records[1].timestamp_ns);
+
+    EXPECT_EQ(records[3].type, OrderAuditRecord::Type::Cancel);
+    EXPECT_EQ(records[3].status, order_service::OrderStatus::CANCELLED);
+    EXPECT_EQ(records[3].quantity, 60);
+    EXPECT_STREQ(records[3].symbol, "AAPL");
+}
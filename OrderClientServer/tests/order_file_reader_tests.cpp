@@ -0,0 +1,150 @@
+// tests/order_file_reader_tests.cpp
+#include <gtest/gtest.h>
+#include "order_file_reader.hpp"
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    // A file holding the given text, removed at the end of the test
+    class TempFile {
+    public:
+        TempFile(const std::string& extension, const std::string& text)
+            : path_(std::filesystem::temp_directory_path() /
+                    ("order_file_reader_test_" + std::to_string(::getpid()) + extension))
+        {
+            std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+            out << text;
+        }
+        ~TempFile() { std::filesystem::remove(path_); }
+
+        [[nodiscard]] std::string path() const { return path_.string(); }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    std::vector<order_service::OrderDetails> readAll(OrderFileReader& reader, std::vector<uint64_t>* malformed = nullptr) {
+        std::vector<order_service::OrderDetails> orders;
+        order_service::OrderRequest request;
+        for (;;) {
+            request.Clear();
+            ReadResult result = reader.next(request);
+            if (result == ReadResult::End) {
+                return orders;
+            }
+            if (result == ReadResult::Order) {
+                orders.push_back(request.details());
+            } else if (malformed) {
+                malformed->push_back(reader.lineNumber());
+            }
+        }
+    }
+}
+
+TEST(OrderFileReaderTest, PicksFormatByExtension) {
+    EXPECT_EQ(orderFileFormatFor("capture.ndjson"), OrderFileFormat::NdJson);
+    EXPECT_EQ(orderFileFormatFor("capture.jsonl"), OrderFileFormat::NdJson);
+    EXPECT_EQ(orderFileFormatFor("data/capture.csv"), OrderFileFormat::Csv);
+    EXPECT_EQ(orderFileFormatFor("orders.json"), OrderFileFormat::Json);
+    EXPECT_EQ(orderFileFormatFor("capture.ocap"), OrderFileFormat::Capture);
+    EXPECT_THROW(OrderFileReader("orders.json", OrderFileFormat::Json), std::invalid_argument);
+    EXPECT_THROW(OrderFileReader("/nonexistent/orders.csv", OrderFileFormat::Csv), std::runtime_error);
+}
+
+TEST(OrderFileReaderTest, ParsesNdJson) {
+    TempFile file(".ndjson",
+        "{\"order_id\":\"o1\",\"trader_id\":\"t1\",\"symbol\":\"AAPL\",\"price\":150.5,\"quantity\":100,\"is_buy\":true}\n"
+        "\r\n"
+        "  { \"is_buy\" : false , \"quantity\": 7, \"price\": 1e2, \"symbol\": \"MS\\u00c9\", "
+        "\"trader_id\": \"t\\\"2\\\"\", \"order_id\": \"o2\", \"venue\": {\"a\": [1, \"}\"]}, \"note\": null }\r\n"
+        "{\"order_id\":\"o3\",\"trader_id\":\"t3\",\"symbol\":\"X\",\"price\":1,\"quantity\":1,\"is_buy\":true}");
+    OrderFileReader reader(file.path(), OrderFileFormat::NdJson);
+    auto orders = readAll(reader);
+    ASSERT_EQ(orders.size(), 3u);
+
+    EXPECT_EQ(orders[0].order_id(), "o1");
+    EXPECT_EQ(orders[0].trader_id(), "t1");
+    EXPECT_EQ(orders[0].stock_symbol(), "AAPL");
+    EXPECT_DOUBLE_EQ(orders[0].price(), 150.5);
+    EXPECT_EQ(orders[0].quantity(), 100);
+    EXPECT_TRUE(orders[0].is_buy_order());
+
+    EXPECT_EQ(orders[1].order_id(), "o2");
+    EXPECT_EQ(orders[1].trader_id(), "t\"2\"");
+    EXPECT_EQ(orders[1].stock_symbol(), "MS\xC3\x89");
+    EXPECT_DOUBLE_EQ(orders[1].price(), 100.0);
+    EXPECT_EQ(orders[1].quantity(), 7);
+    EXPECT_FALSE(orders[1].is_buy_order());
+
+    // The last line has no newline
+    EXPECT_EQ(orders[2].order_id(), "o3");
+    EXPECT_EQ(reader.lineNumber(), 4u);
+}
+
+TEST(OrderFileReaderTest, SkipsMalformedNdJsonLines) {
+    TempFile file(".ndjson",
+        "{\"order_id\":\"o1\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":1,\"quantity\":1,\"is_buy\":true}\n"
+        "{\"order_id\":\"o2\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":\"1\",\"quantity\":1,\"is_buy\":true}\n"
+        "{\"order_id\":\"o3\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":1,\"is_buy\":true}\n"
+        "{\"order_id\":\"o4\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":1,\"quantity\":1.5,\"is_buy\":true}\n"
+        "{\"order_id\":\"o5\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":1,\"quantity\":1,\"is_buy\":true} x\n"
+        "not json\n"
+        "{\"order_id\":\"o7\",\"trader_id\":\"t1\",\"symbol\":\"A\",\"price\":2,\"quantity\":1,\"is_buy\":false}\n");
+    OrderFileReader reader(file.path(), OrderFileFormat::NdJson);
+    order_service::OrderRequest request;
+    EXPECT_EQ(reader.next(request), ReadResult::Order);
+    request.Clear();
+    EXPECT_EQ(reader.next(request), ReadResult::Malformed);
+    EXPECT_EQ(reader.error(), "bad price '1'");
+    request.Clear();
+    EXPECT_EQ(reader.next(request), ReadResult::Malformed);
+    EXPECT_EQ(reader.error(), "missing quantity");
+
+    std::vector<uint64_t> malformed;
+    auto orders = readAll(reader, &malformed);
+    ASSERT_EQ(orders.size(), 1u);
+    EXPECT_EQ(orders[0].order_id(), "o7");
+    EXPECT_EQ(malformed, (std::vector<uint64_t>{4, 5, 6}));
+}
+
+TEST(OrderFileReaderTest, ParsesCsvWithAnyColumnOrder) {
+    TempFile file(".csv",
+        "symbol,order_id,price,quantity,side,trader_id,venue\r\n"
+        "AAPL,o1,150.25,100,buy,t1,X\r\n"
+        "\n"
+        "\"MS,FT\", \"o\"\"2\" ,99,5,SELL,t2,\r\n"
+        "AAPL,o3,abc,1,buy,t1,X\n"
+        "AAPL,o4,1,1,buy,t1\n"
+        "AAPL,o5,1,1,maybe,t1,X\n"
+        "AAPL,o6,1.5,3,0,t1,X");
+    OrderFileReader reader(file.path(), OrderFileFormat::Csv);
+    std::vector<uint64_t> malformed;
+    auto orders = readAll(reader, &malformed);
+    ASSERT_EQ(orders.size(), 3u);
+
+    EXPECT_EQ(orders[0].order_id(), "o1");
+    EXPECT_EQ(orders[0].stock_symbol(), "AAPL");
+    EXPECT_DOUBLE_EQ(orders[0].price(), 150.25);
+    EXPECT_TRUE(orders[0].is_buy_order());
+
+    EXPECT_EQ(orders[1].order_id(), "o\"2");
+    EXPECT_EQ(orders[1].stock_symbol(), "MS,FT");
+    EXPECT_EQ(orders[1].trader_id(), "t2");
+    EXPECT_FALSE(orders[1].is_buy_order());
+
+    EXPECT_EQ(orders[2].order_id(), "o6");
+    EXPECT_EQ(orders[2].quantity(), 3);
+    EXPECT_FALSE(orders[2].is_buy_order());
+    EXPECT_EQ(malformed, (std::vector<uint64_t>{5, 6, 7}));
+}
+
+TEST(OrderFileReaderTest, CsvNeedsEveryColumn) {
+    TempFile file(".csv", "order_id,trader_id,symbol,price,quantity\no1,t1,A,1,1\n");
+    EXPECT_THROW(OrderFileReader(file.path(), OrderFileFormat::Csv), std::runtime_error);
+
+    TempFile empty(".ndjson", "");
+    OrderFileReader reader(empty.path(), OrderFileFormat::NdJson);
+    order_service::OrderRequest request;
+    EXPECT_EQ(reader.next(request), ReadResult::End);
+}
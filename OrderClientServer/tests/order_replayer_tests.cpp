@@ -0,0 +1,211 @@
+// tests/order_replayer_tests.cpp
+#include <gtest/gtest.h>
+#include <grpcpp/grpcpp.h>
+#include "in_process_server.hpp"
+#include "order_replayer.hpp"
+#include <algorithm>
+
+namespace {
+    // Resting buys at distinct prices from one trader
+    OrderReplayer::OrderSource restingBuys(int count, const std::string& trader_id) {
+        auto position = std::make_shared<int>(0);
+        return [=](ReplayRequest& request) {
+            if (*position == count) {
+                return false;
+            }
+            int i = (*position)++;
+            auto* details = request.order.mutable_details();
+            details->set_order_id("r" + std::to_string(i));
+            details->set_trader_id(trader_id);
+            details->set_stock_symbol("AAPL");
+            details->set_price(50.0 + (i % 1000) * 0.01);
+            details->set_quantity(10);
+            details->set_is_buy_order(true);
+            return true;
+        };
+    }
+}
+
+TEST(OrderReplayerTest, PipelinesEveryOrder) {
+    InProcessServer server;
+    ReplayConfig config;
+    config.window = 32;
+    AsyncOrderClient client(server.clientConfig(2));
+    OrderReplayer replayer(client, config);
+
+    ReplayReport report = replayer.replay(restingBuys(2000, "trader1"));
+    EXPECT_EQ(report.submitted, 2000u);
+    EXPECT_EQ(report.accepted, 2000u);
+    EXPECT_TRUE(report.errors.empty());
+    EXPECT_EQ(report.latency.count(), 2000u);
+    EXPECT_GT(report.ordersPerSecond(), 0.0);
+
+    auto book = server.orders().getOrderBook(order_service::ViewOrderBookRequest());
+    EXPECT_EQ(book.buy_orders_size(), 2000);
+
+    // The replayer can run another source
+    report = replayer.replay(restingBuys(0, "trader1"));
+    EXPECT_EQ(report.submitted, 0u);
+}
+
+TEST(OrderReplayerTest, RateLimitPacesSends) {
+    InProcessServer server;
+    ReplayConfig config;
+    config.window = 8;
+    config.rate_per_second = 1000.0;
+    AsyncOrderClient client(server.clientConfig(2));
+    OrderReplayer replayer(client, config);
+
+    ReplayReport report = replayer.replay(restingBuys(200, "trader1"));
+    EXPECT_EQ(report.accepted, 200u);
+    // 199 intervals of 1 ms
+    EXPECT_GE(report.seconds, 0.199);
+}
+
+TEST(OrderReplayerTest, ReportsRejectedOrders) {
+    RateLimitConfig limits;
+    limits.trader_rate = 1.0;
+    limits.trader_burst = 10;
+    InProcessServer server({.rate_limiter = std::make_shared<RateLimiter>(limits)});
+    ReplayConfig config;
+    config.window = 4;
+    AsyncOrderClient client(server.clientConfig(2));
+    OrderReplayer replayer(client, config);
+
+    ReplayReport report = replayer.replay(restingBuys(50, "trader1"));
+    EXPECT_EQ(report.submitted, 50u);
+    EXPECT_EQ(report.accepted, 10u);
+    EXPECT_EQ(report.rejected, 40u);
+    ASSERT_EQ(report.errors.size(), 40u);
+    for (const auto& error : report.errors) {
+        EXPECT_EQ(error.order_id, "r" + std::to_string(error.index));
+        EXPECT_EQ(error.message.rfind("REJECTED", 0), 0u) << error.message;
+    }
+
+    EXPECT_THROW(OrderReplayer(client, ReplayConfig{0}), std::invalid_argument);
+}
+
+TEST(OrderReplayerTest, ReplaysCancelsAndAmends) {
+    InProcessServer server;
+    ReplayConfig config;
+    config.window = 8;
+    AsyncOrderClient client(server.clientConfig(2));
+    OrderReplayer replayer(client, config);
+    ASSERT_EQ(replayer.replay(restingBuys(4, "trader1")).accepted, 4u);
+
+    // Cancel r0, amend r1 into a1, and cancel r9, which never rested
+    std::vector<ReplayRequest> requests(3);
+    requests[0].kind = ReplayKind::Cancel;
+    requests[0].cancel.set_order_id("r0");
+    requests[1].kind = ReplayKind::Amend;
+    requests[1].cancel.set_order_id("r1");
+    auto* details = requests[1].order.mutable_details();
+    details->set_order_id("a1");
+    details->set_trader_id("trader1");
+    details->set_stock_symbol("AAPL");
+    details->set_price(49.0);
+    details->set_quantity(5);
+    details->set_is_buy_order(true);
+    requests[2].kind = ReplayKind::Cancel;
+    requests[2].cancel.set_order_id("r9");
+    for (auto& request : requests) {
+        request.cancel.set_trader_id("trader1");
+        request.cancel.set_is_buy_order(true);
+    }
+
+    size_t position = 0;
+    ReplayReport report = replayer.replay([&](ReplayRequest& request) {
+        if (position == requests.size()) {
+            return false;
+        }
+        request = requests[position++];
+        return true;
+    });
+    EXPECT_EQ(report.submitted, 3u);
+    EXPECT_EQ(report.cancels, 2u);
+    EXPECT_EQ(report.amends, 1u);
+    EXPECT_EQ(report.accepted, 2u);
+    EXPECT_EQ(report.rejected, 1u);
+    ASSERT_EQ(report.errors.size(), 1u);
+    EXPECT_EQ(report.errors[0].order_id, "r9");
+    EXPECT_EQ(report.errors[0].message.rfind("Cancel ", 0), 0u) << report.errors[0].message;
+
+    auto book = server.orders().getOrderBook(order_service::ViewOrderBookRequest());
+    std::vector<std::string> resting;
+    for (const auto& entry : book.buy_orders()) {
+        resting.push_back(entry.details().order_id());
+    }
+    std::sort(resting.begin(), resting.end());
+    EXPECT_EQ(resting, (std::vector<std::string>{"a1", "r2", "r3"}));
+}
+
+TEST(OrderReplayerTest, HoldsCancelsUntilTheirOrderIsAnswered) {
+    InProcessServer server;
+    ReplayConfig config;
+    config.window = 64;
+    config.max_errors = 5;
+    AsyncOrderClient client(server.clientConfig(4));
+    OrderReplayer replayer(client, config);
+
+    // Each order is amended and then cancelled right behind its submit,
+    // with every step in the window at once; then 20 unknown cancels
+    const int orders = 300;
+    int position = 0;
+    ReplayReport report = replayer.replay([&](ReplayRequest& request) {
+        if (position == 3 * orders + 20) {
+            return false;
+        }
+        int i = position / 3;
+        int step = position++ % 3;
+        std::string order_id = "o" + std::to_string(i);
+        std::string replacement_id = "n" + std::to_string(i);
+        if (i >= orders) {
+            request.kind = ReplayKind::Cancel;
+            request.cancel.set_order_id("missing" + std::to_string(position));
+        } else if (step == 0 || step == 1) {
+            request.kind = step == 0 ? ReplayKind::New : ReplayKind::Amend;
+            auto* details = request.order.mutable_details();
+            details->set_order_id(step == 0 ? order_id : replacement_id);
+            details->set_trader_id("trader1");
+            details->set_stock_symbol("AAPL");
+            details->set_price(50.0 + i * 0.01);
+            details->set_quantity(10);
+            details->set_is_buy_order(true);
+            request.cancel.set_order_id(order_id);
+        } else {
+            request.kind = ReplayKind::Cancel;
+            request.cancel.set_order_id(replacement_id);
+        }
+        request.cancel.set_trader_id("trader1");
+        request.cancel.set_is_buy_order(true);
+        return true;
+    });
+    EXPECT_EQ(report.submitted, 3u * orders + 20u);
+    EXPECT_EQ(report.accepted, 3u * orders);
+    EXPECT_EQ(report.rejected, 20u);
+    EXPECT_EQ(report.errors.size(), 5u);
+    EXPECT_EQ(server.orders().getOrderBook(order_service::ViewOrderBookRequest()).buy_orders_size(), 0);
+}
+
+TEST(OrderReplayerTest, ThrowingSourceWaitsForSentRequests) {
+    InProcessServer server;
+    ReplayConfig config;
+    config.window = 4;
+    AsyncOrderClient client(server.clientConfig(2));
+    OrderReplayer replayer(client, config);
+
+    auto source = restingBuys(10, "trader1");
+    int pulled = 0;
+    EXPECT_THROW(replayer.replay([&](ReplayRequest& request) {
+        if (pulled++ == 10) {
+            throw std::runtime_error("Bad input line");
+        }
+        return source(request);
+    }), std::runtime_error);
+
+    // Every order sent before the throw was answered, and the window is whole again
+    auto book = server.orders().getOrderBook(order_service::ViewOrderBookRequest());
+    EXPECT_EQ(book.buy_orders_size(), 10);
+    ReplayReport report = replayer.replay(restingBuys(5, "trader2"));
+    EXPECT_EQ(report.accepted, 5u);
+}
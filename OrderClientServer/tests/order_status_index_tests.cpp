@@ -0,0 +1,118 @@
+// tests/order_status_index_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "order_client_server.hpp"
+#include "order_status_index.hpp"
+#include "order_service.pb.h"
+#include <atomic>
+#include <thread>
+
+class OrderStatusIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::warn);
+        server = std::make_unique<OrderClientServer>(2);
+    }
+
+    void submit(const std::string& order_id, double price, int quantity, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("trader1");
+        details->set_stock_symbol("AAPL");
+        details->set_price(price);
+        details->set_quantity(quantity);
+        details->set_is_buy_order(is_buy);
+        server->submitOrder(request);
+    }
+
+    order_service::OrderStatusResponse status(const std::string& order_id) {
+        order_service::OrderStatusRequest request;
+        request.set_order_id(order_id);
+        return server->getOrderStatus(request);
+    }
+
+    std::unique_ptr<OrderClientServer> server;
+};
+
+TEST_F(OrderStatusIndexTest, TracksFillsOnBothSides) {
+    submit("sell1", 100.0, 100, false);
+    EXPECT_EQ(status("sell1").status(), order_service::OrderStatus::SUCCESS);
+    EXPECT_EQ(status("sell1").remaining_quantity(), 100);
+
+    submit("buy1", 101.0, 40, true);
+
+    auto maker = status("sell1");
+    EXPECT_EQ(maker.status(), order_service::OrderStatus::PARTIAL_FILL);
+    EXPECT_EQ(maker.filled_quantity(), 40);
+    EXPECT_EQ(maker.remaining_quantity(), 60);
+    EXPECT_DOUBLE_EQ(maker.last_fill_price(), 100.0);
+
+    // Fully filled orders leave the book but still resolve
+    auto taker = status("buy1");
+    EXPECT_EQ(taker.status(), order_service::OrderStatus::FULLY_FILLED);
+    EXPECT_EQ(taker.details().trader_id(), "trader1");
+    EXPECT_EQ(taker.remaining_quantity(), 0);
+    EXPECT_DOUBLE_EQ(taker.last_fill_price(), 100.0);
+}
+
+TEST_F(OrderStatusIndexTest, CancelKeepsFillHistory) {
+    submit("sell1", 100.0, 100, false);
+    submit("buy1", 100.0, 30, true);
+
+    order_service::CancelRequest cancel;
+    cancel.set_order_id("sell1");
+    cancel.set_is_buy_order(false);
+    server->cancelOrder(cancel);
+
+    auto response = status("sell1");
+    EXPECT_EQ(response.status(), order_service::OrderStatus::CANCELLED);
+    EXPECT_EQ(response.filled_quantity(), 30);
+    EXPECT_EQ(response.remaining_quantity(), 0);
+    EXPECT_EQ(status("missing").status(), order_service::OrderStatus::UNKNOWN);
+}
+
+TEST_F(OrderStatusIndexTest, TerminalCacheIsBounded) {
+    submit("resting", 90.0, 10, true);
+    for (int i = 0; i < 3; ++i) {
+        submit("sell" + std::to_string(i), 100.0, 10, false);
+        submit("buy" + std::to_string(i), 100.0, 10, true);
+    }
+
+    // Capacity 2: the oldest terminal orders have aged out, live ones never do
+    EXPECT_EQ(status("sell0").status(), order_service::OrderStatus::UNKNOWN);
+    EXPECT_EQ(status("buy2").status(), order_service::OrderStatus::FULLY_FILLED);
+    EXPECT_EQ(status("resting").status(), order_service::OrderStatus::SUCCESS);
+}
+
+TEST_F(OrderStatusIndexTest, ReadersNeverSeeTornUpdates) {
+    OrderStatusIndex index(16);
+    order_service::OrderDetails details;
+    details.set_order_id("order1");
+    details.set_quantity(1000000);
+    index.record(details, order_service::OrderStatus::SUCCESS, 0, 1000000);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            order_service::OrderStatusResponse response;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (index.lookup("order1", &response) &&
+                    response.filled_quantity() + response.remaining_quantity() != 1000000) {
+                    inconsistent.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int filled = 1; filled <= 200000; ++filled) {
+        index.record(details, order_service::OrderStatus::PARTIAL_FILL, filled, 1000000 - filled, 100.0);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(inconsistent.load(), 0);
+}
@@ -0,0 +1,153 @@
+// tests/rate_limiter_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "rate_limiter.hpp"
+#include "token_bucket.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int64_t kSecond = 1000000000;
+}
+
+TEST(TokenBucketTest, AllowsBurstThenRefillsAtRate) {
+    TokenBucket bucket(10.0, 3);  // One token every 100 ms
+    const int64_t start = 5 * kSecond;
+
+    EXPECT_TRUE(bucket.tryAcquire(start));
+    EXPECT_TRUE(bucket.tryAcquire(start));
+    EXPECT_TRUE(bucket.tryAcquire(start));
+    EXPECT_FALSE(bucket.tryAcquire(start));
+
+    EXPECT_FALSE(bucket.tryAcquire(start + kSecond / 20));
+    EXPECT_TRUE(bucket.tryAcquire(start + kSecond / 10));
+    EXPECT_FALSE(bucket.tryAcquire(start + kSecond / 10));
+
+    EXPECT_FALSE(bucket.idle(start + kSecond / 10));
+    EXPECT_TRUE(bucket.idle(start + kSecond));
+}
+
+TEST(TokenBucketTest, ConcurrentCallersNeverExceedBurst) {
+    TokenBucket bucket(1.0, 100);
+    std::atomic<int> granted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) {
+                if (bucket.tryAcquire(kSecond)) {
+                    granted.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(granted.load(), 100);
+}
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        spdlog::set_level(spdlog::level::err);
+    }
+};
+
+TEST_F(RateLimiterTest, ThrottlesEachTraderIndependently) {
+    RateLimitConfig config;
+    config.trader_rate = 1.0;
+    config.trader_burst = 2;
+    RateLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.allow("noisy", "ipv4:10.0.0.1:1000", kSecond));
+    EXPECT_TRUE(limiter.allow("noisy", "ipv4:10.0.0.1:1000", kSecond));
+    EXPECT_FALSE(limiter.allow("noisy", "ipv4:10.0.0.1:1000", kSecond));
+    EXPECT_FALSE(limiter.allow("noisy", "ipv4:10.0.0.2:1000", kSecond));
+    EXPECT_TRUE(limiter.allow("quiet", "ipv4:10.0.0.1:1000", kSecond));
+
+    EXPECT_EQ(limiter.throttled("noisy"), 2u);
+    EXPECT_EQ(limiter.throttled("quiet"), 0u);
+    EXPECT_EQ(limiter.throttledTotal(), 2u);
+
+    auto counts = limiter.mostThrottledTraders(10);
+    ASSERT_EQ(counts.size(), 1u);
+    EXPECT_EQ(counts[0].first, "noisy");
+    EXPECT_EQ(counts[0].second, 2u);
+
+    EXPECT_TRUE(limiter.allow("noisy", "ipv4:10.0.0.1:1000", 2 * kSecond));
+}
+
+TEST_F(RateLimiterTest, ConnectionLimitSpansTraders) {
+    RateLimitConfig config;
+    config.connection_rate = 1.0;
+    config.connection_burst = 2;
+    config.max_tracked_connections = 2;
+    RateLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.allow("trader1", "conn_a", kSecond));
+    EXPECT_TRUE(limiter.allow("trader2", "conn_a", kSecond));
+    EXPECT_FALSE(limiter.allow("trader3", "conn_a", kSecond));
+    EXPECT_EQ(limiter.throttled("trader3"), 1u);
+
+    // Idle connections are forgotten once too many are tracked; a busy one
+    // keeps its state
+    EXPECT_TRUE(limiter.allow("trader1", "conn_b", 10 * kSecond));
+    EXPECT_TRUE(limiter.allow("trader1", "conn_b", 10 * kSecond));
+    EXPECT_TRUE(limiter.allow("trader1", "conn_c", 10 * kSecond));
+    EXPECT_TRUE(limiter.allow("trader1", "conn_d", 10 * kSecond));
+    EXPECT_FALSE(limiter.allow("trader1", "conn_b", 10 * kSecond));
+}
+
+TEST_F(RateLimiterTest, ConnectionLimitDoesNotChargeTheTrader) {
+    RateLimitConfig config;
+    config.trader_rate = 1.0;
+    config.trader_burst = 2;
+    config.connection_rate = 1.0;
+    config.connection_burst = 1;
+    RateLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.allow("trader1", "conn_a", kSecond));
+    EXPECT_FALSE(limiter.allow("trader1", "conn_a", kSecond));
+    EXPECT_FALSE(limiter.allow("trader1", "conn_a", kSecond));
+    // The refused messages were refunded, so one token is left on a fresh
+    // connection
+    EXPECT_TRUE(limiter.allow("trader1", "conn_b", kSecond));
+    EXPECT_FALSE(limiter.allow("trader1", "conn_c", kSecond));
+}
+
+TEST_F(RateLimiterTest, TrackedTradersAreBounded) {
+    RateLimitConfig config;
+    config.trader_rate = 1.0;
+    config.trader_burst = 1;
+    config.max_tracked_traders = 2;
+    RateLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.allow("busy1", "conn", kSecond));
+    EXPECT_TRUE(limiter.allow("busy2", "conn", kSecond));
+    EXPECT_FALSE(limiter.allow("busy1", "conn", kSecond));
+
+    // Neither tracked trader has refilled, so the sprayed ones share the
+    // overflow bucket and the map stays at its cap
+    int granted = 0;
+    for (int i = 0; i < 100; ++i) {
+        std::string trader = "sprayed" + std::to_string(i);
+        granted += limiter.allow(trader, "conn", kSecond) ? 1 : 0;
+        EXPECT_EQ(limiter.trackedTraders(), 2u);
+    }
+    EXPECT_EQ(granted, 1);
+    EXPECT_EQ(limiter.throttled("sprayed1"), 0u);
+    EXPECT_EQ(limiter.throttledTotal(), 100u);
+
+    auto counts = limiter.mostThrottledTraders(1000);
+    ASSERT_EQ(counts.size(), 1u);
+    EXPECT_EQ(counts[0].first, "busy1");
+    EXPECT_EQ(counts[0].second, 1u);
+
+    // Once a tracked trader has refilled, a new trader takes its place
+    EXPECT_TRUE(limiter.allow("late", "conn", 10 * kSecond));
+    EXPECT_FALSE(limiter.allow("late", "conn", 10 * kSecond));
+    EXPECT_EQ(limiter.throttled("late"), 1u);
+    EXPECT_EQ(limiter.trackedTraders(), 2u);
+    EXPECT_EQ(limiter.mostThrottledTraders(0).size(), 0u);
+}
@@ -0,0 +1,120 @@
+// tests/request_tracer_tests.cpp
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include "order_client_server.hpp"
+#include "request_tracer.hpp"
+#include <thread>
+#include <vector>
+
+TEST(RequestTracerTest, SamplesOneRequestInN) {
+    RequestTracer tracer(4);
+    int sampled = 0;
+    for (int i = 0; i < 8; ++i) {
+        sampled += tracer.shouldSample() ? 1 : 0;
+    }
+    EXPECT_EQ(sampled, 2);
+}
+
+TEST(RequestTracerTest, RingKeepsTheMostRecentTraces) {
+    RequestTracer tracer(1, 4);
+    for (int i = 0; i < 6; ++i) {
+        auto trace = tracer.begin(TracedRpc::SubmitOrder);
+        trace.mark(TraceStage::Sent);
+        tracer.record(trace);
+    }
+
+    auto traces = tracer.snapshot();
+    ASSERT_EQ(traces.size(), 4u);
+    EXPECT_EQ(traces.front().request_id, 3u);
+    EXPECT_EQ(traces.back().request_id, 6u);
+    EXPECT_EQ(tracer.recorded(), 6u);
+}
+
+TEST(RequestTracerTest, ConcurrentWritersNeverPublishTornTraces) {
+    RequestTracer tracer(1, 64);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&tracer] {
+            for (int i = 0; i < 5000; ++i) {
+                auto trace = tracer.begin(TracedRpc::CancelOrder);
+                // Every stage carries the same value so a torn copy shows up
+                for (auto& ticks : trace.ticks) {
+                    ticks = trace.request_id;
+                }
+                tracer.record(trace);
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        for (const auto& trace : tracer.snapshot()) {
+            for (auto ticks : trace.ticks) {
+                ASSERT_EQ(ticks, trace.request_id);
+            }
+        }
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+}
+
+TEST(RequestTracerTest, SlotsRecoverAfterDroppedWrites) {
+    // A tiny ring under many writers laps writers still copying their
+    // trace, so some writes are dropped
+    RequestTracer tracer(1, 2);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 8; ++t) {
+        writers.emplace_back([&tracer] {
+            for (int i = 0; i < 20000; ++i) {
+                tracer.record(tracer.begin(TracedRpc::SubmitOrder));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    // Once the writers are gone, every slot takes the next write again
+    tracer.record(tracer.begin(TracedRpc::ViewOrderBook));
+    tracer.record(tracer.begin(TracedRpc::ViewOrderBook));
+    auto traces = tracer.snapshot();
+    ASSERT_EQ(traces.size(), 2u);
+    EXPECT_EQ(traces[0].rpc, TracedRpc::ViewOrderBook);
+    EXPECT_EQ(traces[1].rpc, TracedRpc::ViewOrderBook);
+}
+
+TEST(RequestTracerTest, ServerMarksLockAndMatchStages) {
+    spdlog::set_level(spdlog::level::warn);
+    OrderClientServer server;
+    RequestTracer tracer(1);
+
+    order_service::OrderRequest request;
+    auto* details = request.mutable_details();
+    details->set_order_id("order1");
+    details->set_trader_id("trader1");
+    details->set_stock_symbol("AAPL");
+    details->set_price(100.0);
+    details->set_quantity(10);
+    details->set_is_buy_order(true);
+
+    auto trace = tracer.begin(TracedRpc::SubmitOrder);
+    trace.mark(TraceStage::Started);
+    order_service::OrderResponse response;
+    server.submitOrder(request, &response, &trace);
+    trace.mark(TraceStage::Sent);
+    tracer.record(trace);
+
+    for (size_t stage = 1; stage < kTraceStageCount; ++stage) {
+        EXPECT_GE(trace.ticks[stage], trace.ticks[stage - 1]) << traceStageName(static_cast<TraceStage>(stage));
+    }
+    EXPECT_NE(trace.at(TraceStage::LockAcquired), 0u);
+    EXPECT_NE(trace.at(TraceStage::Matched), 0u);
+
+    // One slice for the request and one per interval
+    auto json = nlohmann::json::parse(tracer.chromeTraceJson());
+    ASSERT_EQ(json["traceEvents"].size(), 6u);
+    EXPECT_EQ(json["traceEvents"][0]["name"], "SubmitOrder");
+    EXPECT_EQ(json["traceEvents"][2]["name"], "lock_wait");
+
+    EXPECT_NE(tracer.stageSummary().find("lock_wait"), std::string::npos);
+}
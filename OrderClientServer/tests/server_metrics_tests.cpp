@@ -0,0 +1,126 @@
+// tests/server_metrics_tests.cpp
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include "metrics_http_server.hpp"
+#include "order_client_server.hpp"
+#include "server_metrics.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+namespace {
+    order_service::OrderRequest makeOrder(const std::string& order_id, const std::string& symbol,
+                                          double price, bool is_buy) {
+        order_service::OrderRequest request;
+        auto* details = request.mutable_details();
+        details->set_order_id(order_id);
+        details->set_trader_id("trader1");
+        details->set_stock_symbol(symbol);
+        details->set_price(price);
+        details->set_quantity(10);
+        details->set_is_buy_order(is_buy);
+        return request;
+    }
+
+    std::string httpGet(uint16_t port, const std::string& path) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return {};
+        }
+        std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+        send(fd, request.data(), request.size(), 0);
+        std::string response;
+        char buffer[4096];
+        ssize_t received = 0;
+        while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, static_cast<size_t>(received));
+        }
+        close(fd);
+        return response;
+    }
+}
+
+TEST(ServerMetricsTest, ShardedCounterSumsAllThreads) {
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&counter] {
+            for (int i = 0; i < 10000; ++i) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.value(), 80000u);
+}
+
+TEST(ServerMetricsTest, HistogramBucketsByUpperBound) {
+    ShardedHistogram histogram;
+    histogram.observe(std::chrono::microseconds(10));   // On the first bound
+    histogram.observe(std::chrono::microseconds(11));
+    histogram.observe(std::chrono::seconds(5));         // +Inf
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 3u);
+    EXPECT_EQ(snapshot.buckets[0], 1u);
+    EXPECT_EQ(snapshot.buckets[1], 1u);
+    EXPECT_EQ(snapshot.buckets[ShardedHistogram::kBucketCount - 1], 1u);
+    EXPECT_NEAR(snapshot.sum_seconds, 5.000021, 1e-9);
+}
+
+TEST(ServerMetricsTest, RendersCallsAndPerSymbolBookStats) {
+    spdlog::set_level(spdlog::level::warn);
+    OrderClientServer server;
+    server.submitOrder(makeOrder("b1", "AAPL", 100.0, true));
+    server.submitOrder(makeOrder("b2", "AAPL", 101.0, true));
+    server.submitOrder(makeOrder("b3", "AAPL", 101.0, true));
+    server.submitOrder(makeOrder("s1", "AAPL", 101.0, false));
+
+    ServerMetrics metrics;
+    metrics.recordCall(TracedRpc::SubmitOrder, CallOutcome::Ok, std::chrono::microseconds(40));
+    metrics.recordCall(TracedRpc::SubmitOrder, CallOutcome::Throttled, std::chrono::microseconds(5));
+    EXPECT_EQ(metrics.calls(TracedRpc::SubmitOrder, CallOutcome::Ok), 1u);
+
+    MetricsSources sources;
+    sources.server = &server;
+    std::string text = metrics.render(sources);
+
+    EXPECT_NE(text.find("order_server_calls_total{rpc=\"SubmitOrder\",outcome=\"throttled\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("order_server_call_duration_seconds_bucket{rpc=\"SubmitOrder\",le=\"5e-05\"} 2\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("order_server_call_duration_seconds_count{rpc=\"SubmitOrder\"} 2\n"), std::string::npos);
+    // The sell filled one of the two buys at 101, leaving two orders on two levels
+    EXPECT_NE(text.find("order_server_book_orders{symbol=\"AAPL\",side=\"buy\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("order_server_book_price_levels{symbol=\"AAPL\",side=\"buy\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("order_server_book_quantity{symbol=\"AAPL\",side=\"buy\"} 20\n"), std::string::npos);
+    EXPECT_NE(text.find("order_server_fills_total{symbol=\"AAPL\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("order_server_matched_quantity_total{symbol=\"AAPL\"} 10\n"), std::string::npos);
+}
+
+TEST(ServerMetricsTest, HttpEndpointServesRegisteredPaths) {
+    MetricsHttpServer endpoint("127.0.0.1:0");
+    endpoint.handle("/metrics", [] {
+        return MetricsHttpServer::Response{"text/plain; version=0.0.4", "up 1\n"};
+    });
+    endpoint.start();
+    ASSERT_NE(endpoint.port(), 0);
+
+    std::string response = httpGet(endpoint.port(), "/metrics?name=up");
+    EXPECT_EQ(response.rfind("HTTP/1.0 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("Content-Type: text/plain; version=0.0.4\r\n"), std::string::npos);
+    EXPECT_EQ(response.substr(response.size() - 5), "up 1\n");
+
+    EXPECT_EQ(httpGet(endpoint.port(), "/other").rfind("HTTP/1.0 404", 0), 0u);
+    endpoint.stop();
+}
@@ -0,0 +1,31 @@
+// tests/timestamp_tests.cpp
+#include <gtest/gtest.h>
+#include "timestamp.hpp"
+#include <ctime>
+
+TEST(TimestampTest, FormatsLocalTime) {
+    std::time_t seconds = 1700000000;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char expected[32];
+    std::strftime(expected, sizeof(expected), "%Y-%m-%d %H:%M:%S", &local);
+
+    TimestampNanos nanos = static_cast<TimestampNanos>(seconds) * 1'000'000'000 + 123456789;
+    EXPECT_EQ(formatTimestamp(nanos), expected);
+}
+
+TEST(TimestampTest, SubSecondChangesReuseTheCachedText) {
+    TimestampNanos second = 1700000000LL * 1'000'000'000;
+    const std::string& first = formatTimestamp(second);
+    std::string text = first;
+
+    EXPECT_EQ(&formatTimestamp(second + 999'999'999), &first);
+    EXPECT_EQ(formatTimestamp(second + 999'999'999), text);
+    EXPECT_NE(formatTimestamp(second + 1'000'000'000), text);
+}
+
+TEST(TimestampTest, ClockIsEpochNanoseconds) {
+    TimestampNanos now = currentTimestampNanos();
+    EXPECT_NEAR(static_cast<double>(now / 1'000'000'000),
+                static_cast<double>(std::time(nullptr)), 2.0);
+}
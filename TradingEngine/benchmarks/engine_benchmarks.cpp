@@ -0,0 +1,263 @@
+// benchmarks/engine_benchmarks.cpp
+//
+// Google Benchmark microbenchmarks for OrderBook. Every book and order pool
+// comes from a fixed seed, so runs compare like for like; order generation
+// and book rebuilds happen outside the timed regions. Each benchmark is
+// parameterized by the number of resting orders in the book.
+//
+// Repeat for error bars and write JSON with the run_engine_benchmarks
+// target, or pass --benchmark_repetitions and --benchmark_out directly.
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "order_book.hpp"
+#include "order.hpp"
+#include "workload_generator.hpp"
+#include "workload_replay.hpp"
+
+namespace {
+    constexpr uint32_t kSeed = 42;
+    constexpr double kMidPrice = 100.0;
+    // Orders added or amended before the book is rebuilt; large enough that
+    // the paused rebuild is a small share of the run
+    constexpr size_t kPoolSize = 4096;
+
+    // The engine reports fills on std::cout. Benchmarks swap in a sink so
+    // the console reporter's output stays readable; formatting still runs.
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+
+    class SilenceEngineOutput {
+    public:
+        SilenceEngineOutput()
+            : previous_(std::cout.rdbuf(&sink_))
+        {}
+
+        ~SilenceEngineOutput() { std::cout.rdbuf(previous_); }
+
+        SilenceEngineOutput(const SilenceEngineOutput&) = delete;
+        SilenceEngineOutput& operator=(const SilenceEngineOutput&) = delete;
+
+    private:
+        NullBuffer sink_;
+        std::streambuf* previous_;
+    };
+
+    // Resting AAPL orders from the workload generator with a fixed mid, so
+    // bids stay at or below mid - 0.01 and asks at or above mid + 0.01 and
+    // the book never crosses
+    class OrderFactory {
+    public:
+        explicit OrderFactory(uint32_t seed)
+            : workload_(restingFlow(seed))
+        {}
+
+        std::vector<Order> restingOrders(const std::string& prefix, size_t count) {
+            std::vector<Order> orders;
+            orders.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                WorkloadCommand add = workload_.nextAdd(i % 2 == 0);
+                std::string traderId = "T";
+                traderId += std::to_string(i % 100);
+                orders.emplace_back(prefix + std::to_string(i), traderId, "AAPL",
+                                    add.price, add.quantity, add.isBuyOrder);
+            }
+            return orders;
+        }
+
+        double restingPrice(bool isBuyOrder) {
+            return workload_.nextAdd(isBuyOrder).price;
+        }
+
+    private:
+        WorkloadGenerator workload_;
+
+        static WorkloadConfig restingFlow(uint32_t seed) {
+            WorkloadConfig config;
+            config.seed = seed;
+            config.symbols = {"AAPL"};
+            config.midPrice = kMidPrice;
+            config.midMoveProbability = 0.0;
+            config.cancelProbability = 0.0;
+            config.marketableProbability = 0.0;
+            // Spread the book over a few hundred levels
+            config.meanPassiveOffsetTicks = 100.0;
+            return config;
+        }
+    };
+
+    // A book holding `size` resting orders, plus the orders themselves (the
+    // book only references them). Rebuilding recreates the same orders, so a
+    // benchmark can consume the book and start over from identical state.
+    // `factory` draws any further orders or prices a benchmark needs.
+    struct SeededBook {
+        explicit SeededBook(size_t bookSize)
+            : factory(kSeed + 1)
+            , size(bookSize)
+        {
+            rebuild();
+        }
+
+        void rebuild() {
+            book.reset();
+            resting = OrderFactory(kSeed).restingOrders("R", size);
+            book = std::make_unique<OrderBook>();
+            for (auto& order : resting) {
+                book->addOrder(order);
+            }
+        }
+
+        OrderFactory factory;
+        size_t size;
+        std::vector<Order> resting;
+        std::unique_ptr<OrderBook> book;
+    };
+
+    void bookSizes(benchmark::internal::Benchmark* benchmark) {
+        benchmark->RangeMultiplier(10)->Range(1'000, 100'000);
+    }
+
+    void reportBookSize(benchmark::State& state) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.counters["book_size"] = static_cast<double>(state.range(0));
+    }
+}
+
+// Adds a new non-crossing order to a book of the given size
+static void BM_AddOrder(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    SeededBook seeded(static_cast<size_t>(state.range(0)));
+    std::vector<Order> incoming = seeded.factory.restingOrders("A", kPoolSize);
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next == incoming.size()) {
+            state.PauseTiming();
+            seeded.rebuild();
+            next = 0;
+            state.ResumeTiming();
+        }
+        seeded.book->addOrder(incoming[next++]);
+    }
+    reportBookSize(state);
+}
+
+// Cancels resting orders in seeded (random price) order
+static void BM_CancelOrder(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    SeededBook seeded(static_cast<size_t>(state.range(0)));
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next == seeded.resting.size()) {
+            state.PauseTiming();
+            seeded.rebuild();
+            next = 0;
+            state.ResumeTiming();
+        }
+        const Order& order = seeded.resting[next++];
+        seeded.book->cancelOrder(order.getOrderId(), order.isBuyOrder());
+    }
+    reportBookSize(state);
+}
+
+// An aggressive sell for one unit arrives and is matched against a large
+// resting bid at the top of the book: addOrder plus matchOrders per
+// iteration, with the book's size unchanged afterwards
+static void BM_MatchAggressiveOrder(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    SeededBook seeded(static_cast<size_t>(state.range(0)));
+    constexpr int kTopQuantity = 1'000'000'000;
+    Order topBid("TOP", "T0", "AAPL", kMidPrice, kTopQuantity, true);
+    seeded.book->addOrder(topBid);
+    std::vector<Order> aggressors;
+    aggressors.reserve(kPoolSize);
+    for (size_t i = 0; i < kPoolSize; ++i) {
+        std::string orderId = "M";
+        orderId += std::to_string(i);
+        aggressors.emplace_back(orderId, "T1", "AAPL", kMidPrice - 5.0, 1, false);
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        Order& aggressor = aggressors[next];
+        next = (next + 1) % aggressors.size();
+        aggressor.setQuantity(1);
+        seeded.book->addOrder(aggressor);
+        seeded.book->matchOrders();
+        if (topBid.getRemainingQuantity() < kTopQuantity / 2) {
+            topBid.setQuantity(kTopQuantity);
+        }
+    }
+    reportBookSize(state);
+}
+
+// Moves resting orders to a new price on their own side
+static void BM_AmendOrder(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    SeededBook seeded(static_cast<size_t>(state.range(0)));
+    std::vector<double> newPrices;
+    newPrices.reserve(kPoolSize);
+    for (size_t i = 0; i < kPoolSize; ++i) {
+        newPrices.push_back(seeded.factory.restingPrice(seeded.resting[i % seeded.resting.size()].isBuyOrder()));
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        const Order& order = seeded.resting[next % seeded.resting.size()];
+        benchmark::DoNotOptimize(seeded.book->amendOrder(order.getOrderId(), order.isBuyOrder(),
+                                                         newPrices[next % newPrices.size()],
+                                                         order.getQuantity()));
+        ++next;
+    }
+    reportBookSize(state);
+}
+
+// Total resting quantity at one price level
+static void BM_DepthQuery(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    SeededBook seeded(static_cast<size_t>(state.range(0)));
+    size_t next = 0;
+    for (auto _ : state) {
+        const Order& order = seeded.resting[next];
+        next = (next + 1) % seeded.resting.size();
+        benchmark::DoNotOptimize(seeded.book->getQuantityAtPrice(order.getPrice(), order.isBuyOrder()));
+    }
+    reportBookSize(state);
+}
+
+// One command of the generator's default flow (multi-symbol, Zipfian,
+// about twenty cancels per trade), replayed from a stream of the given
+// length that is rebuilt once consumed
+static void BM_ReplayWorkload(benchmark::State& state) {
+    SilenceEngineOutput silence;
+    WorkloadConfig config;
+    config.seed = kSeed;
+    WorkloadStream stream = WorkloadGenerator(config).generate(static_cast<size_t>(state.range(0)));
+    auto replay = std::make_unique<WorkloadReplay>(stream);
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next == stream.commands.size()) {
+            state.PauseTiming();
+            replay = std::make_unique<WorkloadReplay>(stream);
+            next = 0;
+            state.ResumeTiming();
+        }
+        replay->apply(stream.commands[next++]);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["stream_commands"] = static_cast<double>(state.range(0));
+}
+
+BENCHMARK(BM_AddOrder)->Apply(bookSizes);
+BENCHMARK(BM_CancelOrder)->Apply(bookSizes);
+BENCHMARK(BM_MatchAggressiveOrder)->Apply(bookSizes);
+BENCHMARK(BM_AmendOrder)->Apply(bookSizes);
+BENCHMARK(BM_DepthQuery)->Apply(bookSizes);
+BENCHMARK(BM_ReplayWorkload)->Arg(100'000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+// include/engine_trace.hpp
+#ifndef ENGINE_TRACE_HPP
+#define ENGINE_TRACE_HPP
+
+#include "tsc_clock.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Begin/end tracepoints for timeline views of the matching engine.
+//
+// Each thread writes TSC-stamped events into its own fixed ring, allocated
+// on the thread's first event; once full, the oldest events are
+// overwritten. Recording takes no lock and never allocates after that first
+// event. Event names must be string literals (only the pointer is stored).
+//
+// The dump reads every thread's ring without synchronizing with writers, so
+// take it while the traced threads are idle, e.g. after the sweep of
+// interest has returned.
+class EngineTrace {
+public:
+    static constexpr size_t kEventsPerThread = size_t{1} << 16;
+
+    static void begin(const char* name) noexcept { record(name, 'B'); }
+    static void end(const char* name) noexcept { record(name, 'E'); }
+
+    // Chrome trace-event JSON (chrome://tracing, Perfetto), one track per
+    // thread, with timestamps in microseconds from the earliest event
+    [[nodiscard]] static std::string chromeTraceJson();
+    static bool writeChromeTrace(const std::string& path);
+    // Drops all recorded events
+    static void clear();
+    // Events currently held across all threads
+    [[nodiscard]] static size_t eventCount();
+
+private:
+    static void record(const char* name, char phase) noexcept;
+};
+
+// Begins an event on construction and ends it on destruction
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) noexcept
+        : name_(name)
+    {
+        EngineTrace::begin(name_);
+    }
+
+    ~TraceScope() { EngineTrace::end(name_); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+};
+
+// Tracepoints compile to nothing unless the engine is built with
+// TRADING_ENGINE_TRACEPOINTS
+#define TE_TRACE_CONCAT_INNER(a, b) a##b
+#define TE_TRACE_CONCAT(a, b) TE_TRACE_CONCAT_INNER(a, b)
+
+#ifdef TE_TRACEPOINTS
+#define TE_TRACE_SCOPE(name) TraceScope TE_TRACE_CONCAT(teTraceScope, __LINE__)(name)
+#define TE_TRACE_BEGIN(name) EngineTrace::begin(name)
+#define TE_TRACE_END(name) EngineTrace::end(name)
+#else
+#define TE_TRACE_SCOPE(name) static_cast<void>(0)
+#define TE_TRACE_BEGIN(name) static_cast<void>(0)
+#define TE_TRACE_END(name) static_cast<void>(0)
+#endif
+
+#endif // ENGINE_TRACE_HPP
@@ -32,6 +32,11 @@ public:
     void setPrice(double newPrice) noexcept;
     void setQuantity(int newQuantity);
     void reduceQuantity(int amount);
+    // Moves the order to newPrice with newRemainingQuantity still open. The
+    // filled part is kept, so the total quantity changes by the same amount
+    // as the remaining one. A new price or a larger remaining quantity
+    // gives the order a new timestamp, so it loses its time priority.
+    void amend(double newPrice, int newRemainingQuantity);
     void cancel() noexcept;
 
     // Comparison operators
@@ -47,7 +52,7 @@ private:
     const std::string stockSymbol_;
     double price_;
     const bool isBuyOrder_;
-    const int64_t timestamp_;
+    int64_t timestamp_;
     int quantity_;
     int remainingQuantity_;
     bool isCanceled_;
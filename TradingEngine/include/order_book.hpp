@@ -4,10 +4,18 @@
 
 #include "order.hpp"
 #include "prioritizable_value_st.hpp"
+#include "latency_histogram.hpp"
 #include <memory>
 #include <vector>
 #include <functional>
 
+// Per-operation latency of one OrderBook
+struct OrderBookLatencies {
+    LatencyHistogram addOrder;
+    LatencyHistogram cancelOrder;
+    LatencyHistogram matchOrders;
+};
+
 class OrderBook {
 public:
     OrderBook();
@@ -16,6 +24,13 @@ public:
     void addOrder(Order& order);
     void matchOrders();
     void cancelOrder(const std::string& orderId, bool isBuyOrder);
+    // Moves a resting order to a new price and remaining quantity; what has
+    // already filled stays filled. A price change or a larger quantity sends
+    // the order to the back of its price level, while a smaller quantity at
+    // the same price keeps its place. Returns false if the order is not
+    // resting or is canceled; throws std::invalid_argument for a
+    // non-positive quantity.
+    bool amendOrder(const std::string& orderId, bool isBuyOrder, double newPrice, int newQuantity);
     int getQuantityAtPrice(double price, bool isBuyOrder) const;
     bool isOrderCanceled(const std::string& orderId, bool isBuyOrder) const;
 
@@ -28,9 +43,23 @@ public:
         return sellOrders->getAllValues();
     }
 
+    // True when built with TRADING_ENGINE_LATENCY_HISTOGRAMS, which times
+    // addOrder, cancelOrder and matchOrders with the TSC
+    static constexpr bool latencyTrackingEnabled() noexcept {
+#ifdef TE_LATENCY_HISTOGRAMS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Null unless latency tracking is compiled in
+    [[nodiscard]] const OrderBookLatencies* getLatencies() const noexcept { return latencies.get(); }
+
 private:
     std::unique_ptr<PrioritizableValueST<std::string, Order>> buyOrders;
     std::unique_ptr<PrioritizableValueST<std::string, Order>> sellOrders;
+    std::unique_ptr<OrderBookLatencies> latencies;
 
     bool isMatchPossible(const Order& buyOrder, const Order& sellOrder) const;
     void processMatch(Order& buyOrder, Order& sellOrder);
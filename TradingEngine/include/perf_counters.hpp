@@ -0,0 +1,97 @@
+// include/perf_counters.hpp
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+enum class PerfEvent : size_t {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LlcMisses,
+    BranchMisses,
+    DtlbMisses,
+    Count
+};
+
+// Counter deltas over one measured region. A counter the kernel could not
+// open is left invalid; values are scaled up when the kernel multiplexed it
+struct PerfSample {
+    static constexpr size_t kEventCount = static_cast<size_t>(PerfEvent::Count);
+
+    std::array<uint64_t, kEventCount> values{};
+    std::array<bool, kEventCount> valid{};
+    uint64_t elapsedNanos = 0;
+
+    [[nodiscard]] bool has(PerfEvent event) const noexcept { return valid[static_cast<size_t>(event)]; }
+    [[nodiscard]] uint64_t get(PerfEvent event) const noexcept { return values[static_cast<size_t>(event)]; }
+    [[nodiscard]] bool anyCounters() const noexcept;
+};
+
+// Hardware counters for the calling thread, read through Linux
+// perf_event_open around a benchmark region (user space only). Each event is
+// opened on its own, so a PMU missing one of them (common in VMs and
+// containers) still reports the rest; with none available, or on other
+// platforms, start/stop only time the region.
+//
+// Set TE_PERF_COUNTERS=0 to skip the counters and time only.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True when at least one counter opened
+    [[nodiscard]] bool available() const noexcept;
+    // Why no counters are available, empty when some are
+    [[nodiscard]] const std::string& unavailableReason() const noexcept { return unavailableReason_; }
+
+    void start();
+    PerfSample stop();
+
+    [[nodiscard]] static const char* eventName(PerfEvent event) noexcept;
+    // One line per counter, divided by the number of operations in the region
+    static void printPerOperation(std::ostream& out, const PerfSample& sample, size_t operations);
+
+private:
+    struct Reading {
+        uint64_t value = 0;
+        uint64_t timeEnabled = 0;
+        uint64_t timeRunning = 0;
+    };
+
+    std::array<int, PerfSample::kEventCount> fds_;
+    std::array<Reading, PerfSample::kEventCount> startReadings_{};
+    uint64_t startNanos_ = 0;
+    std::string unavailableReason_;
+
+    bool read(size_t index, Reading& reading) const;
+};
+
+// Counts the enclosing scope into `sample`
+class ScopedPerfRegion {
+public:
+    ScopedPerfRegion(PerfCounters& counters, PerfSample& sample)
+        : counters_(counters)
+        , sample_(sample)
+    {
+        counters_.start();
+    }
+
+    ~ScopedPerfRegion() { sample_ = counters_.stop(); }
+
+    ScopedPerfRegion(const ScopedPerfRegion&) = delete;
+    ScopedPerfRegion& operator=(const ScopedPerfRegion&) = delete;
+
+private:
+    PerfCounters& counters_;
+    PerfSample& sample_;
+};
+
+#endif // PERF_COUNTERS_HPP
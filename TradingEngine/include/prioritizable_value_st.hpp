@@ -8,6 +8,7 @@
 #include <optional>
 #include <functional>
 #include "order.hpp"
+#include "engine_trace.hpp"
 
 template<typename K, typename V>
 class PrioritizableValueST {
@@ -90,19 +91,40 @@ public:
     PrioritizableValueST& operator=(PrioritizableValueST&&) noexcept = default;
     ~PrioritizableValueST() = default;
 
+    // Putting a key that is already present updates its entry in place and
+    // moves its existing priority-map node, so it does not allocate
     void put(const K& key_in, double price_in, int64_t timestamp_in, V& value_in, bool isBuyOrder_in) {
-        auto entry = std::make_shared<Entry>(key_in, value_in, price_in, timestamp_in, isBuyOrder_in);
-    
+        TE_TRACE_SCOPE("PVST::put");
         auto it = entries_.find(key_in);
         if (it != entries_.end()) {
-            auto oldEntry = it->second;
-            priorityMap_.erase(CompositeKey(
-                oldEntry->price, oldEntry->timestamp, oldEntry->isBuyOrder));
+            TE_TRACE_SCOPE("PVST::put/update");
+            Entry& entry = *it->second;
+            CompositeKey oldKey(entry.price, entry.timestamp, entry.isBuyOrder);
+            CompositeKey newKey(price_in, timestamp_in, isBuyOrder_in);
+            entry.value = value_in;
+            entry.price = price_in;
+            entry.timestamp = timestamp_in;
+            entry.isBuyOrder = isBuyOrder_in;
+            if (!(oldKey == newKey)) {
+                auto node = priorityMap_.extract(oldKey);
+                if (node) {
+                    node.key() = newKey;
+                    priorityMap_.insert(std::move(node));
+                }
+            }
+            return;
         }
 
-        entries_[key_in] = entry;
+        TE_TRACE_BEGIN("PVST::put/make_shared");
+        auto entry = std::make_shared<Entry>(key_in, value_in, price_in, timestamp_in, isBuyOrder_in);
+        TE_TRACE_END("PVST::put/make_shared");
+
+        TE_TRACE_BEGIN("PVST::put/index_insert");
+        entries_.emplace(key_in, entry);
+        TE_TRACE_END("PVST::put/index_insert");
+        TE_TRACE_SCOPE("PVST::put/map_insert");
         priorityMap_.emplace(
-            CompositeKey(price_in, timestamp_in, isBuyOrder_in), entry);
+            CompositeKey(price_in, timestamp_in, isBuyOrder_in), std::move(entry));
     }    
 
     [[nodiscard]] std::optional<std::reference_wrapper<const V>> get(const K& key_in) const {
@@ -122,6 +144,7 @@ public:
     }
 
     void delete_(const K& key_in) {
+        TE_TRACE_SCOPE("PVST::delete");
         auto it = entries_.find(key_in);
         if (it != entries_.end()) {
             auto entry = it->second;
@@ -131,7 +154,17 @@ public:
         }
     }
 
+    // Highest-priority value, left in place
+    [[nodiscard]] std::optional<std::reference_wrapper<V>> peekMin() {
+        auto it = priorityMap_.begin();
+        if (it != priorityMap_.end()) {
+            return std::ref(it->second->value.get());
+        }
+        return std::nullopt;
+    }
+
     [[nodiscard]] std::optional<std::reference_wrapper<V>> deleteMin() {
+        TE_TRACE_SCOPE("PVST::deleteMin");
         if (entries_.empty()) {
             return std::nullopt;
         }
@@ -140,7 +173,10 @@ public:
         if (it != priorityMap_.end()) {
             auto entry = it->second;
             auto& value = entry->value.get();
+            TE_TRACE_BEGIN("PVST::deleteMin/index_erase");
             entries_.erase(entry->key);
+            TE_TRACE_END("PVST::deleteMin/index_erase");
+            TE_TRACE_SCOPE("PVST::deleteMin/map_erase");
             priorityMap_.erase(it);
             return std::ref(value);
         }
@@ -148,6 +184,7 @@ public:
     }
 
     [[nodiscard]] std::vector<std::reference_wrapper<V>> getAllValues() const {
+        TE_TRACE_SCOPE("PVST::getAllValues");
         std::vector<std::reference_wrapper<V>> values;
         values.reserve(entries_.size());
     
@@ -157,6 +194,14 @@ public:
         return values;
     }
 
+    // Visits every value without building a container
+    template<typename Visit>
+    void forEachValue(Visit&& visit) const {
+        for (const auto& [_, entry] : entries_) {
+            visit(entry->value.get());
+        }
+    }
+
     [[nodiscard]] bool contains(const K& key_in) const {
         return entries_.contains(key_in);
     }
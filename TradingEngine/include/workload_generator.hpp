@@ -0,0 +1,142 @@
+// include/workload_generator.hpp
+#ifndef WORKLOAD_GENERATOR_HPP
+#define WORKLOAD_GENERATOR_HPP
+
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class ArrivalProcess {
+    Poisson,  // Independent arrivals at baseRatePerSecond
+    Hawkes    // Self-exciting: every arrival raises the rate, which then decays
+};
+
+// Shape of a synthetic order flow. The defaults approximate a lit equity
+// venue: passive orders cluster a few ticks behind the touch, about twenty
+// cancels arrive per trade, most cancels hit young orders, and activity
+// across symbols is Zipfian.
+struct WorkloadConfig {
+    uint64_t seed = 1;
+
+    // Symbol i is drawn with probability proportional to 1 / (i + 1)^zipfExponent
+    std::vector<std::string> symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOG", "META", "TSLA", "JPM"};
+    double zipfExponent = 1.0;
+
+    // Every symbol starts at midPrice; each add moves its mid one tick up or
+    // down with probability midMoveProbability
+    double midPrice = 100.0;
+    double tickSize = 0.01;
+    double midMoveProbability = 0.05;
+    // The touch sits halfSpreadTicks from the mid. Passive orders rest a
+    // geometric number of ticks behind it; marketable orders cross it by
+    // up to maxCrossTicks.
+    int halfSpreadTicks = 1;
+    double meanPassiveOffsetTicks = 3.0;
+    int maxCrossTicks = 3;
+
+    // Quantity is a geometric number of lots, at least one
+    int lotSize = 100;
+    double meanLots = 3.0;
+
+    ArrivalProcess arrivals = ArrivalProcess::Poisson;
+    double baseRatePerSecond = 100'000.0;
+    // Hawkes excitation: each arrival adds hawkesJumpPerSecond to the rate,
+    // decaying at hawkesDecayPerSecond. The process is stationary while
+    // jump / decay < 1.
+    double hawkesJumpPerSecond = 60'000.0;
+    double hawkesDecayPerSecond = 100'000.0;
+
+    // Per-event mix; the rest are passive adds. The defaults give about 20
+    // cancels per marketable order.
+    double cancelProbability = 0.47;
+    double marketableProbability = 0.0235;
+    // A cancel picks a live order by age rank from the newest, geometrically
+    // with this mean, so young orders are the most likely to be pulled
+    double meanCancelAgeRank = 20.0;
+};
+
+enum class WorkloadCommandType : char {
+    Add = 'A',
+    Cancel = 'C',
+    Match = 'M'  // Run matching on the symbol's book (follows a marketable add)
+};
+
+struct WorkloadCommand {
+    WorkloadCommandType type = WorkloadCommandType::Add;
+    uint64_t timestampNanos = 0;
+    // New order's id for Add, the canceled order's for Cancel, 0 for Match
+    uint64_t orderId = 0;
+    // Index into the stream's symbols
+    uint32_t symbol = 0;
+    bool isBuyOrder = false;
+    double price = 0.0;
+    int quantity = 0;
+
+    bool operator==(const WorkloadCommand& other) const = default;
+};
+
+// A command stream and the symbol table its commands index into.
+//
+// The CSV form starts with a "#symbols,<name>,..." line and a header row,
+// then one command per line:
+//   timestamp_ns,type,order_id,symbol,side,price,quantity
+// with type A/C/M, the symbol by name and side B/S.
+struct WorkloadStream {
+    std::vector<std::string> symbols;
+    std::vector<WorkloadCommand> commands;
+
+    void writeCsv(std::ostream& out) const;
+    // Throws std::runtime_error naming the line for malformed input
+    static WorkloadStream readCsv(std::istream& in);
+
+    // Throw std::runtime_error if the file cannot be written or read
+    void writeFile(const std::string& path) const;
+    static WorkloadStream readFile(const std::string& path);
+};
+
+// Deterministic generator for WorkloadConfig flows. Random bits come from
+// std::mt19937_64, whose output the standard fixes, and the distributions
+// are derived here rather than taken from <random>, so a seed yields the
+// same stream whichever standard library the engine is built with.
+class WorkloadGenerator {
+public:
+    // Throws std::invalid_argument for a config without symbols, without a
+    // positive base rate, or with non-stationary Hawkes arrivals
+    explicit WorkloadGenerator(WorkloadConfig config);
+
+    // The next command. Cancels only name orders this generator added and
+    // has not canceled yet; they may have been filled in the meantime.
+    WorkloadCommand next();
+    // `count` commands from the current position
+    WorkloadStream generate(size_t count);
+    // An add on the given side, passive or marketable in the config's
+    // proportion, for callers that choose sides and cancels themselves.
+    // It is not tracked for later cancels.
+    WorkloadCommand nextAdd(bool isBuyOrder);
+
+    [[nodiscard]] const WorkloadConfig& config() const noexcept { return config_; }
+
+private:
+    WorkloadConfig config_;
+    std::mt19937_64 gen_;
+    std::vector<double> symbolCdf_;
+    std::vector<int64_t> midTicks_;
+    // Adds not yet canceled, oldest first
+    std::deque<WorkloadCommand> liveOrders_;
+    std::optional<WorkloadCommand> pendingMatch_;
+    uint64_t nextOrderId_ = 1;
+    double clockNanos_ = 0.0;
+    double excitation_ = 0.0;
+
+    double uniform();
+    uint64_t geometric(double mean);
+    uint32_t drawSymbol();
+    uint64_t advanceClock();
+    WorkloadCommand makeAdd(uint32_t symbol, bool isBuyOrder, bool marketable, uint64_t timestamp);
+};
+
+#endif // WORKLOAD_GENERATOR_HPP
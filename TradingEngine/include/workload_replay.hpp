@@ -0,0 +1,42 @@
+// include/workload_replay.hpp
+#ifndef WORKLOAD_REPLAY_HPP
+#define WORKLOAD_REPLAY_HPP
+
+#include "order.hpp"
+#include "order_book.hpp"
+#include "workload_generator.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Applies a WorkloadStream to one OrderBook per symbol. Every order the
+// stream adds is constructed up front and owned here (the books only
+// reference them), so applying a command does no order construction and can
+// be timed on its own. Cancels of unknown orders are ignored, as the book
+// ignores cancels of orders it no longer holds.
+//
+// The stream is referenced, not copied, and must outlive the replay.
+class WorkloadReplay {
+public:
+    explicit WorkloadReplay(const WorkloadStream& stream);
+    // A temporary stream would be gone before the first apply()
+    explicit WorkloadReplay(WorkloadStream&& stream) = delete;
+
+    WorkloadReplay(const WorkloadReplay&) = delete;
+    WorkloadReplay& operator=(const WorkloadReplay&) = delete;
+
+    void apply(const WorkloadCommand& command);
+    // Applies the stream's commands in order
+    void applyAll();
+
+    [[nodiscard]] OrderBook& book(uint32_t symbol) { return *books_.at(symbol); }
+    [[nodiscard]] const WorkloadStream& stream() const noexcept { return stream_; }
+
+private:
+    const WorkloadStream& stream_;
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    std::vector<Order> orders_;
+    std::unordered_map<uint64_t, size_t> orderIndex_;
+};
+
+#endif // WORKLOAD_REPLAY_HPP
@@ -0,0 +1,153 @@
+// src/engine_trace.cpp
+#include "engine_trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        uint64_t ticks;
+        const char* name;
+        char phase;
+    };
+
+    struct ThreadRing {
+        explicit ThreadRing(uint32_t id)
+            : threadId(id)
+            , events(std::make_unique<TraceEvent[]>(EngineTrace::kEventsPerThread))
+        {}
+
+        const uint32_t threadId;
+        std::unique_ptr<TraceEvent[]> events;
+        std::atomic<uint64_t> written{0};
+    };
+
+    // Rings outlive their threads so that a dump still sees their events
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadRing>> rings;
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    ThreadRing& threadRing() {
+        thread_local std::shared_ptr<ThreadRing> ring = [] {
+            Registry& rings = registry();
+            std::lock_guard<std::mutex> lock(rings.mutex);
+            auto created = std::make_shared<ThreadRing>(static_cast<uint32_t>(rings.rings.size() + 1));
+            rings.rings.push_back(created);
+            return created;
+        }();
+        return *ring;
+    }
+
+    // Events still in the ring, oldest first
+    std::vector<TraceEvent> readRing(const ThreadRing& ring) {
+        uint64_t written = ring.written.load(std::memory_order_acquire);
+        uint64_t first = written > EngineTrace::kEventsPerThread ? written - EngineTrace::kEventsPerThread : 0;
+        std::vector<TraceEvent> events;
+        events.reserve(static_cast<size_t>(written - first));
+        for (uint64_t index = first; index < written; ++index) {
+            events.push_back(ring.events[index & (EngineTrace::kEventsPerThread - 1)]);
+        }
+        return events;
+    }
+
+    void appendJsonString(std::ostringstream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+static_assert((EngineTrace::kEventsPerThread & (EngineTrace::kEventsPerThread - 1)) == 0,
+              "Ring indexing needs a power-of-two capacity");
+
+void EngineTrace::record(const char* name, char phase) noexcept {
+    ThreadRing& ring = threadRing();
+    uint64_t index = ring.written.load(std::memory_order_relaxed);
+    ring.events[index & (kEventsPerThread - 1)] = TraceEvent{TscClock::now(), name, phase};
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+std::string EngineTrace::chromeTraceJson() {
+    Registry& rings = registry();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+
+    std::vector<std::pair<uint32_t, std::vector<TraceEvent>>> threads;
+    uint64_t origin = UINT64_MAX;
+    for (const auto& ring : rings.rings) {
+        auto events = readRing(*ring);
+        if (!events.empty()) {
+            origin = std::min(origin, events.front().ticks);
+            threads.emplace_back(ring->threadId, std::move(events));
+        }
+    }
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& [threadId, events] : threads) {
+        // A wrapped ring can start part-way through a scope; its unmatched
+        // end events are dropped so the viewer's nesting stays intact
+        size_t depth = 0;
+        for (const auto& event : events) {
+            if (event.phase == 'E') {
+                if (depth == 0) {
+                    continue;
+                }
+                --depth;
+            } else {
+                ++depth;
+            }
+            out << (first ? "" : ",") << "{\"name\":";
+            appendJsonString(out, event.name);
+            out << ",\"cat\":\"engine\",\"ph\":\"" << event.phase << "\",\"ts\":"
+                << static_cast<double>(TscClock::toNanos(event.ticks - origin)) / 1000.0
+                << ",\"pid\":1,\"tid\":" << threadId << "}";
+            first = false;
+        }
+    }
+    out << "],\"displayTimeUnit\":\"ns\"}";
+    return out.str();
+}
+
+bool EngineTrace::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << chromeTraceJson();
+    return static_cast<bool>(out);
+}
+
+void EngineTrace::clear() {
+    Registry& rings = registry();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+    for (const auto& ring : rings.rings) {
+        ring->written.store(0, std::memory_order_release);
+    }
+}
+
+size_t EngineTrace::eventCount() {
+    Registry& rings = registry();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+    size_t total = 0;
+    for (const auto& ring : rings.rings) {
+        total += static_cast<size_t>(std::min<uint64_t>(ring->written.load(std::memory_order_acquire),
+                                                        kEventsPerThread));
+    }
+    return total;
+}
@@ -1,5 +1,6 @@
 // order.cpp
 #include "order.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -36,6 +37,20 @@ void Order::setQuantity(int newQuantity) {
     remainingQuantity_ = newQuantity;
 }
 
+void Order::amend(double newPrice, int newRemainingQuantity) {
+    if (newRemainingQuantity <= 0) {
+        throw std::invalid_argument("New quantity must be positive");
+    }
+    if (newPrice != price_ || newRemainingQuantity > remainingQuantity_) {
+        // Strictly later, so the order queues behind any it was level with
+        int64_t now = std::chrono::system_clock::now().time_since_epoch().count();
+        timestamp_ = std::max(now, timestamp_ + 1);
+    }
+    quantity_ += newRemainingQuantity - remainingQuantity_;
+    remainingQuantity_ = newRemainingQuantity;
+    price_ = newPrice;
+}
+
 void Order::reduceQuantity(int amount) {
     if (amount <= 0) {
         throw std::invalid_argument("Amount to reduce must be positive");
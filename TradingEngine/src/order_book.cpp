@@ -1,16 +1,29 @@
 // src/order_book.cpp
 #include "order_book.hpp"
+#include "engine_trace.hpp"
 #include <algorithm>
 #include <iostream>
 
+// Times the rest of the enclosing operation into latencies->histogram. The
+// histograms are only allocated, and operations only timed, when latency
+// tracking is compiled in.
+#ifdef TE_LATENCY_HISTOGRAMS
+#define TE_TIME_OPERATION(histogram) ScopedLatencyTimer operationTimer(latencies->histogram)
+#else
+#define TE_TIME_OPERATION(histogram) static_cast<void>(0)
+#endif
+
 OrderBook::OrderBook()
     : buyOrders(std::make_unique<PrioritizableValueST<std::string, Order>>())
     , sellOrders(std::make_unique<PrioritizableValueST<std::string, Order>>())
+    , latencies(latencyTrackingEnabled() ? std::make_unique<OrderBookLatencies>() : nullptr)
 {}
 
 OrderBook::~OrderBook() = default;
 
 void OrderBook::addOrder(Order& order) {
+    TE_TIME_OPERATION(addOrder);
+    TE_TRACE_SCOPE("OrderBook::addOrder");
     if (order.getQuantity() <= 0) {
         return;  // Ignore orders with zero or negative quantity
     }
@@ -27,16 +40,17 @@ int OrderBook::getQuantityAtPrice(double price, bool isBuyOrder) const {
     int totalQuantity = 0;
     const auto& orders = isBuyOrder ? buyOrders : sellOrders;
     
-    for (const auto& orderRef : orders->getAllValues()) {
-        const auto& order = orderRef.get();
+    orders->forEachValue([&](const Order& order) {
         if (order.getPrice() == price && !order.isCanceled()) {
             totalQuantity += order.getRemainingQuantity();
         }
-    }
+    });
     return totalQuantity;
 }
 
 void OrderBook::cancelOrder(const std::string& orderId, bool isBuyOrder) {
+    TE_TIME_OPERATION(cancelOrder);
+    TE_TRACE_SCOPE("OrderBook::cancelOrder");
     auto& orders = isBuyOrder ? buyOrders : sellOrders;
     if (auto orderOpt = orders->get(orderId)) {
         Order& order = orderOpt->get();
@@ -46,6 +60,19 @@ void OrderBook::cancelOrder(const std::string& orderId, bool isBuyOrder) {
     }
 }
 
+bool OrderBook::amendOrder(const std::string& orderId, bool isBuyOrder, double newPrice, int newQuantity) {
+    TE_TRACE_SCOPE("OrderBook::amendOrder");
+    auto& orders = isBuyOrder ? buyOrders : sellOrders;
+    auto orderOpt = orders->get(orderId);
+    if (!orderOpt || orderOpt->get().isCanceled()) {
+        return false;
+    }
+    Order& order = orderOpt->get();
+    order.amend(newPrice, newQuantity);
+    reinsertOrder(order, isBuyOrder);
+    return true;
+}
+
 bool OrderBook::isMatchPossible(const Order& buyOrder, const Order& sellOrder) const {
     if (buyOrder.isBuyOrder() == sellOrder.isBuyOrder()) {
         std::cout << "Attempted to match orders of the same type: "
@@ -62,6 +89,7 @@ bool OrderBook::isMatchPossible(const Order& buyOrder, const Order& sellOrder) c
 }
 
 void OrderBook::reinsertOrder(Order& order, bool isBuyOrder) {
+    TE_TRACE_SCOPE("OrderBook::reinsertOrder");
     auto& orders = isBuyOrder ? buyOrders : sellOrders;
     orders->put(order.getOrderId(), 
                 order.getPrice(), 
@@ -80,6 +108,7 @@ bool OrderBook::isOrderCanceled(const std::string& orderId, bool isBuyOrder) con
 }
 
 void OrderBook::processMatch(Order& buyOrder, Order& sellOrder) {
+    TE_TRACE_SCOPE("OrderBook::processMatch");
     if (!isMatchPossible(buyOrder, sellOrder)) {
         std::cout << "No match possible for " << buyOrder.getOrderId()
                   << " and " << sellOrder.getOrderId() << std::endl;
@@ -99,28 +128,35 @@ void OrderBook::processMatch(Order& buyOrder, Order& sellOrder) {
               << " remaining: " << buyOrder.getRemainingQuantity() << ", "
               << sellOrder.getOrderId() << " remaining: " << sellOrder.getRemainingQuantity() << std::endl;
 
+    // Partially filled orders keep their place in the book; filled ones leave it
     if (buyOrder.getRemainingQuantity() > 0) {
-        std::cout << "Reinserting buy order with remaining quantity: " 
+        std::cout << "Buy order keeps remaining quantity: " 
                   << buyOrder.getRemainingQuantity() << std::endl;
-        reinsertOrder(buyOrder, true);
+    } else {
+        buyOrders->delete_(buyOrder.getOrderId());
     }
     if (sellOrder.getRemainingQuantity() > 0) {
-        std::cout << "Reinserting sell order with remaining quantity: " 
+        std::cout << "Sell order keeps remaining quantity: " 
                   << sellOrder.getRemainingQuantity() << std::endl;
-        reinsertOrder(sellOrder, false);
+    } else {
+        sellOrders->delete_(sellOrder.getOrderId());
     }
 }
 
 void OrderBook::matchOrders() {
+    TE_TIME_OPERATION(matchOrders);
+    TE_TRACE_SCOPE("OrderBook::matchOrders");
     bool madeMatch;
     do {
+        TE_TRACE_SCOPE("OrderBook::matchOrders/iteration");
         madeMatch = false;
         if (buyOrders->isEmpty() || sellOrders->isEmpty()) {
             break;
         }
 
-        // Get highest priority buy order
-        auto buyOrderOpt = buyOrders->deleteMin();
+        // Orders are inspected in place rather than popped and re-put, so a
+        // sweep only touches the book for orders it removes
+        auto buyOrderOpt = buyOrders->peekMin();
         if (!buyOrderOpt) {
             break;
         }
@@ -128,28 +164,24 @@ void OrderBook::matchOrders() {
         Order& buyOrder = buyOrderOpt->get();
         if (buyOrder.isCanceled() || buyOrder.getRemainingQuantity() <= 0) {
             std::cout << "Skipping canceled or zero-quantity buy order: " << buyOrder.getOrderId() << "\n";
+            buyOrders->delete_(buyOrder.getOrderId());
             continue;
         }
 
-        // Get highest priority sell order
-        auto sellOrderOpt = sellOrders->deleteMin();
+        auto sellOrderOpt = sellOrders->peekMin();
         if (!sellOrderOpt) {
-            reinsertOrder(buyOrder, true);
             break;
         }
 
         Order& sellOrder = sellOrderOpt->get();
         if (sellOrder.isCanceled() || sellOrder.getRemainingQuantity() <= 0) {
             std::cout << "Skipping canceled or zero-quantity sell order: " << sellOrder.getOrderId() << "\n";
-            reinsertOrder(buyOrder, true);
+            sellOrders->delete_(sellOrder.getOrderId());
             continue;
         }
 
-        // Proceed with matching
         if (!isMatchPossible(buyOrder, sellOrder)) {
             std::cout << "No match possible for " << buyOrder.getOrderId() << " and " << sellOrder.getOrderId() << "\n";
-            reinsertOrder(buyOrder, true);
-            reinsertOrder(sellOrder, false);
             break;
         }
 
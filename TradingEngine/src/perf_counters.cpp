@@ -0,0 +1,198 @@
+// src/perf_counters.cpp
+#include "perf_counters.hpp"
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    uint64_t steadyNanos() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    bool countersDisabledByEnvironment() {
+        const char* value = std::getenv("TE_PERF_COUNTERS");
+        return value != nullptr && std::strcmp(value, "0") == 0;
+    }
+
+#ifdef __linux__
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    constexpr uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    constexpr std::array<EventConfig, PerfSample::kEventCount> kEventConfigs = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                         PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                         PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    }};
+
+    int openEvent(const EventConfig& event) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+bool PerfSample::anyCounters() const noexcept {
+    for (bool isValid : valid) {
+        if (isValid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+    if (countersDisabledByEnvironment()) {
+        unavailableReason_ = "disabled by TE_PERF_COUNTERS=0";
+        return;
+    }
+#ifdef __linux__
+    int lastError = 0;
+    for (size_t i = 0; i < PerfSample::kEventCount; ++i) {
+        fds_[i] = openEvent(kEventConfigs[i]);
+        if (fds_[i] < 0) {
+            lastError = errno;
+        } else {
+            // Counters run from here on and each region reads them at both
+            // ends, which keeps enable/disable system calls out of it
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    if (!available()) {
+        unavailableReason_ = std::string("perf_event_open failed: ") + std::strerror(lastError);
+    }
+#else
+    unavailableReason_ = "perf_event_open is Linux only";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::available() const noexcept {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PerfCounters::read(size_t index, Reading& reading) const {
+#ifdef __linux__
+    uint64_t buffer[3];
+    if (fds_[index] < 0 || ::read(fds_[index], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+        return false;
+    }
+    reading = Reading{buffer[0], buffer[1], buffer[2]};
+    return true;
+#else
+    static_cast<void>(index);
+    static_cast<void>(reading);
+    return false;
+#endif
+}
+
+void PerfCounters::start() {
+    for (size_t i = 0; i < PerfSample::kEventCount; ++i) {
+        read(i, startReadings_[i]);
+    }
+    startNanos_ = steadyNanos();
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    sample.elapsedNanos = steadyNanos() - startNanos_;
+    for (size_t i = 0; i < PerfSample::kEventCount; ++i) {
+        Reading end;
+        if (!read(i, end)) {
+            continue;
+        }
+        const Reading& begin = startReadings_[i];
+        uint64_t running = end.timeRunning - begin.timeRunning;
+        uint64_t enabled = end.timeEnabled - begin.timeEnabled;
+        if (running == 0) {
+            // Never scheduled on the PMU during the region
+            continue;
+        }
+        double delta = static_cast<double>(end.value - begin.value);
+        if (running < enabled) {
+            delta *= static_cast<double>(enabled) / static_cast<double>(running);
+        }
+        sample.values[i] = static_cast<uint64_t>(delta);
+        sample.valid[i] = true;
+    }
+    return sample;
+}
+
+const char* PerfCounters::eventName(PerfEvent event) noexcept {
+    switch (event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::L1DMisses: return "L1d misses";
+        case PerfEvent::LlcMisses: return "LLC misses";
+        case PerfEvent::BranchMisses: return "branch misses";
+        case PerfEvent::DtlbMisses: return "dTLB misses";
+        case PerfEvent::Count: break;
+    }
+    return "unknown";
+}
+
+void PerfCounters::printPerOperation(std::ostream& out, const PerfSample& sample, size_t operations) {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    double ops = static_cast<double>(operations == 0 ? 1 : operations);
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < PerfSample::kEventCount; ++i) {
+        auto event = static_cast<PerfEvent>(i);
+        out << std::left << std::setw(16) << eventName(event) << std::right;
+        if (sample.has(event)) {
+            out << std::setw(14) << static_cast<double>(sample.get(event)) / ops << " /op\n";
+        } else {
+            out << std::setw(14) << "n/a" << "\n";
+        }
+    }
+    if (sample.has(PerfEvent::Cycles) && sample.has(PerfEvent::Instructions) && sample.get(PerfEvent::Cycles) > 0) {
+        out << std::left << std::setw(16) << "IPC" << std::right << std::setw(14)
+            << static_cast<double>(sample.get(PerfEvent::Instructions)) /
+               static_cast<double>(sample.get(PerfEvent::Cycles)) << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
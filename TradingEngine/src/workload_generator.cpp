@@ -0,0 +1,288 @@
+// src/workload_generator.cpp
+#include "workload_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::runtime_error csvError(size_t lineNumber, const std::string& message) {
+        return std::runtime_error("workload CSV line " + std::to_string(lineNumber) + ": " + message);
+    }
+
+    std::vector<std::string> splitCsv(const std::string& line) {
+        std::vector<std::string> fields;
+        std::string field;
+        std::istringstream in(line);
+        while (std::getline(in, field, ',')) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    template<typename T>
+    T parseField(const std::string& text, size_t lineNumber, const char* name) {
+        std::istringstream in(text);
+        T value{};
+        if (!(in >> value) || !in.eof()) {
+            throw csvError(lineNumber, std::string("bad ") + name + " '" + text + "'");
+        }
+        return value;
+    }
+}
+
+void WorkloadStream::writeCsv(std::ostream& out) const {
+    out << "#symbols";
+    for (const auto& symbol : symbols) {
+        out << ',' << symbol;
+    }
+    out << "\ntimestamp_ns,type,order_id,symbol,side,price,quantity\n";
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    // Shortest form that round-trips a double
+    out << std::setprecision(17) << std::defaultfloat;
+    for (const auto& command : commands) {
+        out << command.timestampNanos << ',' << static_cast<char>(command.type) << ','
+            << command.orderId << ',' << symbols.at(command.symbol) << ','
+            << (command.isBuyOrder ? 'B' : 'S') << ',' << command.price << ','
+            << command.quantity << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+WorkloadStream WorkloadStream::readCsv(std::istream& in) {
+    WorkloadStream stream;
+    std::string line;
+    size_t lineNumber = 0;
+    auto symbolIndex = [&stream](const std::string& name) {
+        auto it = std::find(stream.symbols.begin(), stream.symbols.end(), name);
+        if (it == stream.symbols.end()) {
+            stream.symbols.push_back(name);
+            return static_cast<uint32_t>(stream.symbols.size() - 1);
+        }
+        return static_cast<uint32_t>(it - stream.symbols.begin());
+    };
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line.rfind("timestamp_ns,", 0) == 0) {
+            continue;
+        }
+        std::vector<std::string> fields = splitCsv(line);
+        if (line.rfind("#symbols", 0) == 0) {
+            for (size_t i = 1; i < fields.size(); ++i) {
+                symbolIndex(fields[i]);
+            }
+            continue;
+        }
+        if (line.front() == '#') {
+            continue;
+        }
+        if (fields.size() != 7) {
+            throw csvError(lineNumber, "expected 7 fields, got " + std::to_string(fields.size()));
+        }
+
+        WorkloadCommand command;
+        command.timestampNanos = parseField<uint64_t>(fields[0], lineNumber, "timestamp");
+        if (fields[1] == "A") {
+            command.type = WorkloadCommandType::Add;
+        } else if (fields[1] == "C") {
+            command.type = WorkloadCommandType::Cancel;
+        } else if (fields[1] == "M") {
+            command.type = WorkloadCommandType::Match;
+        } else {
+            throw csvError(lineNumber, "bad type '" + fields[1] + "'");
+        }
+        command.orderId = parseField<uint64_t>(fields[2], lineNumber, "order id");
+        command.symbol = symbolIndex(fields[3]);
+        if (fields[4] != "B" && fields[4] != "S") {
+            throw csvError(lineNumber, "bad side '" + fields[4] + "'");
+        }
+        command.isBuyOrder = fields[4] == "B";
+        command.price = parseField<double>(fields[5], lineNumber, "price");
+        command.quantity = parseField<int>(fields[6], lineNumber, "quantity");
+        stream.commands.push_back(command);
+    }
+    return stream;
+}
+
+void WorkloadStream::writeFile(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open workload file for writing: " + path);
+    }
+    writeCsv(out);
+    if (!out) {
+        throw std::runtime_error("failed writing workload file: " + path);
+    }
+}
+
+WorkloadStream WorkloadStream::readFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot open workload file: " + path);
+    }
+    return readCsv(in);
+}
+
+WorkloadGenerator::WorkloadGenerator(WorkloadConfig config)
+    : config_(std::move(config))
+    , gen_(config_.seed)
+{
+    if (config_.symbols.empty()) {
+        throw std::invalid_argument("WorkloadConfig needs at least one symbol");
+    }
+    if (!(config_.baseRatePerSecond > 0.0)) {
+        throw std::invalid_argument("WorkloadConfig needs a positive baseRatePerSecond");
+    }
+    if (config_.arrivals == ArrivalProcess::Hawkes &&
+        config_.hawkesJumpPerSecond >= config_.hawkesDecayPerSecond) {
+        throw std::invalid_argument("Hawkes arrivals need hawkesJumpPerSecond < hawkesDecayPerSecond");
+    }
+
+    double total = 0.0;
+    for (size_t i = 0; i < config_.symbols.size(); ++i) {
+        total += 1.0 / std::pow(static_cast<double>(i + 1), config_.zipfExponent);
+        symbolCdf_.push_back(total);
+    }
+    for (double& cumulative : symbolCdf_) {
+        cumulative /= total;
+    }
+    midTicks_.assign(config_.symbols.size(), std::llround(config_.midPrice / config_.tickSize));
+}
+
+double WorkloadGenerator::uniform() {
+    // 53 random bits in [0, 1)
+    return static_cast<double>(gen_() >> 11) * 0x1.0p-53;
+}
+
+uint64_t WorkloadGenerator::geometric(double mean) {
+    // Failures before the first success with success probability 1 / (1 + mean)
+    if (mean <= 0.0) {
+        return 0;
+    }
+    double failure = mean / (1.0 + mean);
+    return static_cast<uint64_t>(std::floor(std::log1p(-uniform()) / std::log(failure)));
+}
+
+uint32_t WorkloadGenerator::drawSymbol() {
+    auto it = std::upper_bound(symbolCdf_.begin(), symbolCdf_.end(), uniform());
+    return static_cast<uint32_t>(std::min<size_t>(static_cast<size_t>(it - symbolCdf_.begin()),
+                                                  symbolCdf_.size() - 1));
+}
+
+uint64_t WorkloadGenerator::advanceClock() {
+    double base = config_.baseRatePerSecond;
+    if (config_.arrivals == ArrivalProcess::Poisson) {
+        clockNanos_ += -std::log1p(-uniform()) / base * 1e9;
+        return static_cast<uint64_t>(clockNanos_);
+    }
+
+    // Ogata thinning: the intensity only decays between arrivals, so its
+    // current value bounds it until the next candidate
+    double decay = config_.hawkesDecayPerSecond;
+    for (;;) {
+        double bound = base + excitation_;
+        double waitSeconds = -std::log1p(-uniform()) / bound;
+        clockNanos_ += waitSeconds * 1e9;
+        excitation_ *= std::exp(-decay * waitSeconds);
+        if (uniform() * bound <= base + excitation_) {
+            excitation_ += config_.hawkesJumpPerSecond;
+            return static_cast<uint64_t>(clockNanos_);
+        }
+    }
+}
+
+WorkloadCommand WorkloadGenerator::makeAdd(uint32_t symbol, bool isBuyOrder, bool marketable, uint64_t timestamp) {
+    int64_t& mid = midTicks_[symbol];
+    if (uniform() < config_.midMoveProbability) {
+        mid += uniform() < 0.5 ? -1 : 1;
+        mid = std::max<int64_t>(mid, config_.halfSpreadTicks + 1);
+    }
+
+    int64_t touch = isBuyOrder ? mid - config_.halfSpreadTicks : mid + config_.halfSpreadTicks;
+    int64_t priceTicks;
+    if (marketable) {
+        // Through the opposite touch
+        int64_t opposite = isBuyOrder ? mid + config_.halfSpreadTicks : mid - config_.halfSpreadTicks;
+        auto cross = static_cast<int64_t>(uniform() * (config_.maxCrossTicks + 1));
+        priceTicks = isBuyOrder ? opposite + cross : opposite - cross;
+    } else {
+        auto offset = static_cast<int64_t>(geometric(config_.meanPassiveOffsetTicks));
+        priceTicks = isBuyOrder ? touch - offset : touch + offset;
+    }
+    priceTicks = std::max<int64_t>(priceTicks, 1);
+
+    WorkloadCommand command;
+    command.type = WorkloadCommandType::Add;
+    command.timestampNanos = timestamp;
+    command.orderId = nextOrderId_++;
+    command.symbol = symbol;
+    command.isBuyOrder = isBuyOrder;
+    // Rounded to the tick grid so prices compare exactly within a level
+    command.price = std::round(static_cast<double>(priceTicks) * config_.tickSize * 1e8) / 1e8;
+    command.quantity = config_.lotSize * static_cast<int>(1 + geometric(config_.meanLots - 1.0));
+    return command;
+}
+
+WorkloadCommand WorkloadGenerator::next() {
+    if (pendingMatch_) {
+        WorkloadCommand match = *pendingMatch_;
+        pendingMatch_.reset();
+        return match;
+    }
+
+    uint64_t timestamp = advanceClock();
+    double event = uniform();
+    if (event < config_.cancelProbability && !liveOrders_.empty()) {
+        auto rank = std::min<uint64_t>(geometric(config_.meanCancelAgeRank), liveOrders_.size() - 1);
+        auto position = liveOrders_.end() - 1 - static_cast<std::ptrdiff_t>(rank);
+        // The cancel repeats the order's symbol, side, price and quantity
+        // for consumers that need more than the id
+        WorkloadCommand command = *position;
+        command.type = WorkloadCommandType::Cancel;
+        command.timestampNanos = timestamp;
+        liveOrders_.erase(position);
+        return command;
+    }
+
+    bool marketable = event >= config_.cancelProbability &&
+                      event < config_.cancelProbability + config_.marketableProbability;
+    uint32_t symbol = drawSymbol();
+    WorkloadCommand add = makeAdd(symbol, uniform() < 0.5, marketable, timestamp);
+    if (marketable) {
+        WorkloadCommand match;
+        match.type = WorkloadCommandType::Match;
+        match.timestampNanos = timestamp;
+        match.symbol = symbol;
+        match.isBuyOrder = add.isBuyOrder;
+        pendingMatch_ = match;
+    } else {
+        liveOrders_.push_back(add);
+    }
+    return add;
+}
+
+WorkloadCommand WorkloadGenerator::nextAdd(bool isBuyOrder) {
+    uint64_t timestamp = advanceClock();
+    double addShare = 1.0 - config_.cancelProbability;
+    bool marketable = addShare > 0.0 && uniform() * addShare < config_.marketableProbability;
+    return makeAdd(drawSymbol(), isBuyOrder, marketable, timestamp);
+}
+
+WorkloadStream WorkloadGenerator::generate(size_t count) {
+    WorkloadStream stream;
+    stream.symbols = config_.symbols;
+    stream.commands.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        stream.commands.push_back(next());
+    }
+    return stream;
+}
@@ -0,0 +1,59 @@
+// src/workload_replay.cpp
+#include "workload_replay.hpp"
+#include <string>
+
+WorkloadReplay::WorkloadReplay(const WorkloadStream& stream)
+    : stream_(stream)
+{
+    for (size_t i = 0; i < stream_.symbols.size(); ++i) {
+        books_.push_back(std::make_unique<OrderBook>());
+    }
+
+    size_t adds = 0;
+    for (const auto& command : stream_.commands) {
+        adds += command.type == WorkloadCommandType::Add ? 1 : 0;
+    }
+    // Reserved so that the books' references stay valid
+    orders_.reserve(adds);
+    orderIndex_.reserve(adds);
+    for (const auto& command : stream_.commands) {
+        if (command.type == WorkloadCommandType::Add) {
+            orderIndex_.emplace(command.orderId, orders_.size());
+            std::string traderId = "T";
+            traderId += std::to_string(command.orderId % 100);
+            orders_.emplace_back(std::to_string(command.orderId), traderId,
+                                 stream_.symbols.at(command.symbol), command.price, command.quantity,
+                                 command.isBuyOrder);
+        }
+    }
+}
+
+void WorkloadReplay::apply(const WorkloadCommand& command) {
+    OrderBook& orderBook = *books_.at(command.symbol);
+    switch (command.type) {
+        case WorkloadCommandType::Add: {
+            auto it = orderIndex_.find(command.orderId);
+            if (it != orderIndex_.end()) {
+                orderBook.addOrder(orders_[it->second]);
+            }
+            break;
+        }
+        case WorkloadCommandType::Cancel: {
+            auto it = orderIndex_.find(command.orderId);
+            if (it != orderIndex_.end()) {
+                const Order& order = orders_[it->second];
+                orderBook.cancelOrder(order.getOrderId(), order.isBuyOrder());
+            }
+            break;
+        }
+        case WorkloadCommandType::Match:
+            orderBook.matchOrders();
+            break;
+    }
+}
+
+void WorkloadReplay::applyAll() {
+    for (const auto& command : stream_.commands) {
+        apply(command);
+    }
+}
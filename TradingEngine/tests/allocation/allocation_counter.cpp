@@ -0,0 +1,81 @@
+// tests/allocation/allocation_counter.cpp
+#include "allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Constant-initialized so counting works before any dynamic init runs
+    thread_local constinit AllocationStats counters;
+
+    void* allocate(std::size_t size) noexcept {
+        void* memory = std::malloc(size == 0 ? 1 : size);
+        if (memory) {
+            ++counters.allocations;
+            counters.bytes += size;
+        }
+        return memory;
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+        auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a size that is a multiple of the alignment
+        std::size_t rounded = (size + align - 1) / align * align;
+        void* memory = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+        if (memory) {
+            ++counters.allocations;
+            counters.bytes += size;
+        }
+        return memory;
+    }
+
+    void* allocateOrThrow(std::size_t size) {
+        if (void* memory = allocate(size)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+        if (void* memory = allocateAligned(size, alignment)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void release(void* memory) noexcept {
+        if (memory) {
+            ++counters.deallocations;
+            std::free(memory);
+        }
+    }
+}
+
+AllocationStats threadAllocationStats() noexcept {
+    return counters;
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { release(memory); }
+void operator delete[](void* memory) noexcept { release(memory); }
+void operator delete(void* memory, std::size_t) noexcept { release(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { release(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { release(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { release(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { release(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { release(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { release(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { release(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { release(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { release(memory); }
@@ -0,0 +1,48 @@
+// tests/allocation/allocation_counter.hpp
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap traffic seen by the calling thread. Linking allocation_counter.cpp
+// into a test binary replaces the global operator new/delete family so that
+// every allocation made through them is counted here.
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes = 0;
+
+    AllocationStats& operator+=(const AllocationStats& other) noexcept {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        bytes += other.bytes;
+        return *this;
+    }
+
+    AllocationStats operator-(const AllocationStats& earlier) const noexcept {
+        return {allocations - earlier.allocations,
+                deallocations - earlier.deallocations,
+                bytes - earlier.bytes};
+    }
+};
+
+[[nodiscard]] AllocationStats threadAllocationStats() noexcept;
+
+// Captures the allocations made on this thread between construction and
+// each call to stats()
+class AllocationScope {
+public:
+    AllocationScope() noexcept
+        : start_(threadAllocationStats())
+    {}
+
+    [[nodiscard]] AllocationStats stats() const noexcept {
+        return threadAllocationStats() - start_;
+    }
+
+private:
+    AllocationStats start_;
+};
+
+#endif // ALLOCATION_COUNTER_HPP
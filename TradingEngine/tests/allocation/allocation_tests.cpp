@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "allocation_counter.hpp"
+#include "order_book.hpp"
+#include "order.hpp"
+#include "prioritizable_value_st.hpp"
+
+namespace {
+    constexpr int kOperations = 1000;
+    // make_shared entry, index node and priority-map node
+    constexpr double kAddOrderAllocationBudget = 3.0;
+
+    struct OperationCost {
+        std::string name;
+        int operations;
+        AllocationStats stats;
+        bool zeroAllocation;
+    };
+
+    double perOperation(uint64_t total, int operations) {
+        return static_cast<double>(total) / static_cast<double>(operations);
+    }
+
+    // Distinct prices keep the book's price/time keys unique however close
+    // together the orders are created
+    std::vector<Order> makeOrders(const std::string& prefix, int count, double basePrice, int quantity, bool isBuyOrder) {
+        std::vector<Order> orders;
+        orders.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            orders.emplace_back(prefix + std::to_string(i), "T1", "AAPL",
+                                basePrice + 0.01 * i, quantity, isBuyOrder);
+        }
+        return orders;
+    }
+}
+
+class AllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        orderBook = std::make_unique<OrderBook>();
+    }
+
+    static void TearDownTestSuite() {
+        printAllocationReport();
+    }
+
+    // Runs the operation once per index inside a single allocation scope
+    template<typename Operation>
+    static AllocationStats measure(int operations, Operation&& operation) {
+        AllocationScope scope;
+        for (int i = 0; i < operations; ++i) {
+            operation(i);
+        }
+        return scope.stats();
+    }
+
+    static void record(const std::string& name, int operations, const AllocationStats& stats, bool zeroAllocation) {
+        report().push_back({name, operations, stats, zeroAllocation});
+    }
+
+    static std::vector<OperationCost>& report() {
+        static std::vector<OperationCost> costs;
+        return costs;
+    }
+
+    static void printAllocationReport() {
+        std::cout << "\nPer-Operation Allocation Report:" << std::endl;
+        std::cout << std::left << std::setw(36) << "Operation" << std::right
+                  << std::setw(8) << "Ops" << std::setw(12) << "Allocs/op" << std::setw(12) << "Frees/op"
+                  << std::setw(12) << "Bytes/op" << std::setw(8) << "Zero" << std::endl;
+        std::cout << "----------------------------------------------------------------------------------------" << std::endl;
+        for (const auto& cost : report()) {
+            std::cout << std::left << std::setw(36) << cost.name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(8) << cost.operations
+                      << std::setw(12) << perOperation(cost.stats.allocations, cost.operations)
+                      << std::setw(12) << perOperation(cost.stats.deallocations, cost.operations)
+                      << std::setw(12) << perOperation(cost.stats.bytes, cost.operations)
+                      << std::setw(8) << (cost.zeroAllocation ? "yes" : "-") << std::endl;
+        }
+    }
+
+    std::unique_ptr<OrderBook> orderBook;
+};
+
+TEST_F(AllocationTest, CounterSeesHeapTraffic) {
+    AllocationScope scope;
+    auto buffer = std::make_unique<char[]>(256);
+    buffer.reset();
+    AllocationStats stats = scope.stats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.deallocations, 1u);
+    EXPECT_EQ(stats.bytes, 256u);
+}
+
+TEST_F(AllocationTest, AddOrderStaysWithinBudget) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    AllocationStats stats = measure(kOperations, [&](int i) { orderBook->addOrder(buys[i]); });
+    record("OrderBook::addOrder", kOperations, stats, false);
+
+    // Index growth adds a handful of rehashes on top of the per-order nodes
+    EXPECT_LE(perOperation(stats.allocations, kOperations), kAddOrderAllocationBudget + 0.05);
+}
+
+TEST_F(AllocationTest, CancelOrderDoesNotAllocate) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    for (auto& order : buys) {
+        orderBook->addOrder(order);
+    }
+    AllocationStats stats = measure(kOperations, [&](int i) {
+        orderBook->cancelOrder(buys[i].getOrderId(), true);
+    });
+    record("OrderBook::cancelOrder", kOperations, stats, true);
+    EXPECT_EQ(stats.allocations, 0u);
+}
+
+TEST_F(AllocationTest, AmendOrderDoesNotAllocate) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    for (auto& order : buys) {
+        orderBook->addOrder(order);
+    }
+    AllocationStats stats = measure(kOperations, [&](int i) {
+        orderBook->amendOrder(buys[i].getOrderId(), true, buys[i].getPrice() - 50.0, 5);
+    });
+    record("OrderBook::amendOrder", kOperations, stats, true);
+    EXPECT_EQ(stats.allocations, 0u);
+}
+
+TEST_F(AllocationTest, SteadyStateMatchDoesNotAllocate) {
+    // One large resting buy is partially filled by each incoming sell
+    Order restingBuy("RB", "T1", "AAPL", 200.0, kOperations * 10, true);
+    auto sells = makeOrders("S", kOperations, 50.0, 1, false);
+    orderBook->addOrder(restingBuy);
+
+    AllocationStats stats;
+    for (auto& sell : sells) {
+        orderBook->addOrder(sell);
+        AllocationScope scope;
+        orderBook->matchOrders();
+        stats += scope.stats();
+    }
+    record("OrderBook::matchOrders", kOperations, stats, true);
+    EXPECT_EQ(stats.allocations, 0u);
+    EXPECT_EQ(restingBuy.getRemainingQuantity(), kOperations * 9);
+    EXPECT_EQ(orderBook->getQuantityAtPrice(200.0, true), kOperations * 9);
+}
+
+TEST_F(AllocationTest, UncrossedMatchDoesNotAllocate) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    auto sells = makeOrders("S", kOperations, 150.0, 10, false);
+    for (int i = 0; i < kOperations; ++i) {
+        orderBook->addOrder(buys[i]);
+        orderBook->addOrder(sells[i]);
+    }
+    AllocationStats stats = measure(kOperations, [&](int) { orderBook->matchOrders(); });
+    record("OrderBook::matchOrders (no cross)", kOperations, stats, true);
+    EXPECT_EQ(stats.allocations, 0u);
+}
+
+TEST_F(AllocationTest, BookQueriesDoNotAllocate) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    for (auto& order : buys) {
+        orderBook->addOrder(order);
+    }
+
+    AllocationStats quantityStats = measure(kOperations, [&](int i) {
+        EXPECT_EQ(orderBook->getQuantityAtPrice(buys[i].getPrice(), true), 10);
+    });
+    record("OrderBook::getQuantityAtPrice", kOperations, quantityStats, true);
+    EXPECT_EQ(quantityStats.allocations, 0u);
+
+    AllocationStats canceledStats = measure(kOperations, [&](int i) {
+        EXPECT_FALSE(orderBook->isOrderCanceled(buys[i].getOrderId(), true));
+    });
+    record("OrderBook::isOrderCanceled", kOperations, canceledStats, true);
+    EXPECT_EQ(canceledStats.allocations, 0u);
+
+    // Snapshot accessors copy the book and are reported but not budgeted
+    AllocationStats snapshotStats = measure(10, [&](int) {
+        EXPECT_EQ(orderBook->getBuyOrders().size(), static_cast<size_t>(kOperations));
+    });
+    record("OrderBook::getBuyOrders", 10, snapshotStats, false);
+}
+
+TEST_F(AllocationTest, PrioritizableValueSTOperations) {
+    auto buys = makeOrders("B", kOperations, 100.0, 10, true);
+    PrioritizableValueST<std::string, Order> pvst;
+
+    AllocationStats putStats = measure(kOperations, [&](int i) {
+        Order& order = buys[i];
+        pvst.put(order.getOrderId(), order.getPrice(), order.getTimestamp(), order, true);
+    });
+    record("PVST::put (new key)", kOperations, putStats, false);
+
+    AllocationStats rePutStats = measure(kOperations, [&](int i) {
+        Order& order = buys[i];
+        pvst.put(order.getOrderId(), order.getPrice() + 1000.0, order.getTimestamp(), order, true);
+    });
+    record("PVST::put (existing key)", kOperations, rePutStats, true);
+    EXPECT_EQ(rePutStats.allocations, 0u);
+
+    AllocationStats getStats = measure(kOperations, [&](int i) {
+        EXPECT_TRUE(pvst.get(buys[i].getOrderId()).has_value());
+    });
+    record("PVST::get", kOperations, getStats, true);
+    EXPECT_EQ(getStats.allocations, 0u);
+
+    AllocationStats deleteMinStats = measure(kOperations, [&](int) {
+        EXPECT_TRUE(pvst.deleteMin().has_value());
+    });
+    record("PVST::deleteMin", kOperations, deleteMinStats, true);
+    EXPECT_EQ(deleteMinStats.allocations, 0u);
+    EXPECT_TRUE(pvst.isEmpty());
+}
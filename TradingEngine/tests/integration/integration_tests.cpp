@@ -146,7 +146,8 @@ TEST_F(TradingSystemIntegrationTest, StressTest) {
     // Generate orders
     for (int i = 0; i < numOrders; ++i) {
         bool isBuyOrder = (i % 2 == 0);
-        std::string orderId = "O" + std::to_string(i);
+        std::string orderId = "O";
+        orderId += std::to_string(i);
         std::string traderId = isBuyOrder ? buyer1->getTraderId() : seller1->getTraderId();
         
         orders.emplace_back(orderId, traderId, "AAPL", 
@@ -1,6 +1,5 @@
 #include <gtest/gtest.h>
 #include <chrono>
-#include <random>
 #include <vector>
 #include <algorithm>
 #include <numeric>
@@ -10,26 +9,95 @@
 #include "trader.hpp"
 #include "trade.hpp"
 #include "order.hpp"
+#include "latency_histogram.hpp"
+#include "engine_trace.hpp"
+#include "perf_counters.hpp"
+#include "workload_generator.hpp"
+#include "workload_replay.hpp"
 
 class PerformanceTest : public ::testing::Test {
 protected:
     PerformanceTest() 
-        : orderBook(), rd(), gen(rd()), price_dist(90.0, 110.0), quantity_dist(1, 100),
+        : orderBook(), workload(singleBookFlow()),
           next_buy_order_id(1), next_sell_order_id(1) {}
 
+    // Orders for one AAPL book from a fixed seed: passive orders clustered
+    // behind the touch, with a fifth of them marketable so that matching
+    // has work to do. Tests choose sides and cancels themselves.
+    static WorkloadConfig singleBookFlow() {
+        WorkloadConfig config;
+        config.seed = 42;
+        config.symbols = {"AAPL"};
+        config.cancelProbability = 0.0;
+        config.marketableProbability = 0.2;
+        return config;
+    }
+
     void SetUp() override {
         orderBook = std::make_unique<OrderBook>();
     }
 
-    // Helper function to measure execution time
+    // Helper function to measure execution time. Hardware counters for the
+    // same region, when available, are left in lastCounters.
     template<typename Func>
     std::chrono::nanoseconds measureExecutionTime(Func&& func) {
-        auto start = std::chrono::high_resolution_clock::now();
-        func();
-        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::high_resolution_clock::time_point start;
+        std::chrono::high_resolution_clock::time_point end;
+        {
+            ScopedPerfRegion region(perfCounters, lastCounters);
+            start = std::chrono::high_resolution_clock::now();
+            func();
+            end = std::chrono::high_resolution_clock::now();
+        }
         return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
     }
 
+    void printHardwareCounters(const std::string& label, const PerfSample& sample, std::size_t n) {
+        if (!sample.anyCounters()) {
+            std::cout << label << ": hardware counters unavailable ("
+                      << perfCounters.unavailableReason() << "), timing only" << std::endl;
+            return;
+        }
+        std::cout << label << " hardware counters per operation:" << std::endl;
+        PerfCounters::printPerOperation(std::cout, sample, n);
+    }
+
+    // Times a single call into `histogram`
+    template<typename Func>
+    void timeOperation(LatencyHistogram& histogram, Func&& func) {
+        uint64_t start = TscClock::now();
+        func();
+        histogram.record(TscClock::toNanos(TscClock::now() - start));
+    }
+
+    void printPercentileTable(const std::string& testName,
+                              const std::vector<std::pair<std::string, const LatencyHistogram*>>& rows) {
+        auto micros = [](uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+        std::cout << "\n" << testName << " Latency Percentiles (μs):" << std::endl;
+        std::cout << std::left << std::setw(16) << "Operation" << std::right
+                  << std::setw(10) << "Count" << std::setw(10) << "p50" << std::setw(10) << "p90"
+                  << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(12) << "Max" << std::endl;
+        std::cout << "------------------------------------------------------------------------------" << std::endl;
+        for (const auto& [name, histogram] : rows) {
+            std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(10) << histogram->count()
+                      << std::setw(10) << micros(histogram->valueAtPercentile(50.0))
+                      << std::setw(10) << micros(histogram->valueAtPercentile(90.0))
+                      << std::setw(10) << micros(histogram->valueAtPercentile(99.0))
+                      << std::setw(10) << micros(histogram->valueAtPercentile(99.9))
+                      << std::setw(12) << micros(histogram->max()) << std::endl;
+        }
+    }
+
+    // The book's own histograms, when the engine is built with them
+    void printEngineLatencies(const std::string& testName) {
+        if (const OrderBookLatencies* latencies = orderBook->getLatencies()) {
+            printPercentileTable(testName + " (engine)", {{"addOrder", &latencies->addOrder},
+                                                          {"cancelOrder", &latencies->cancelOrder},
+                                                          {"matchOrders", &latencies->matchOrders}});
+        }
+    }
+
     void printPerformanceMetrics(const std::string& testName, 
                                std::size_t n, 
                                std::chrono::nanoseconds duration,
@@ -51,6 +119,7 @@ protected:
         if (includeLogN) {
             std::cout << "Time per operation / log(n): " << timePerLogN << " ms" << std::endl;
         }
+        printHardwareCounters(testName, lastCounters, n);
         std::cout << "----------------------------------------" << std::endl;
     }
 
@@ -58,22 +127,24 @@ protected:
     Order generateRandomOrder(bool isBuyOrder) {
         std::string prefix = isBuyOrder ? "B" : "S";
         int orderNumber = isBuyOrder ? next_buy_order_id++ : next_sell_order_id++;
+        WorkloadCommand add = workload.nextAdd(isBuyOrder);
+        std::string traderId = "T";
+        traderId += std::to_string(orderNumber % 100);
         
         return Order(
             prefix + std::to_string(orderNumber),
-            "T" + std::to_string(orderNumber % 100),
+            traderId,
             "AAPL",
-            price_dist(gen),
-            quantity_dist(gen),
+            add.price,
+            add.quantity,
             isBuyOrder
         );
     }
 
     std::unique_ptr<OrderBook> orderBook;
-    std::random_device rd;
-    std::mt19937 gen;
-    std::uniform_real_distribution<double> price_dist;
-    std::uniform_int_distribution<int> quantity_dist;
+    PerfCounters perfCounters;
+    PerfSample lastCounters;
+    WorkloadGenerator workload;
     int next_buy_order_id;
     int next_sell_order_id;
 };
@@ -85,6 +156,8 @@ TEST_F(PerformanceTest, OrderInsertionScaling) {
     std::cout << "Size\tTime(ms)\tTime/n(μs)\tTime/nlogn(μs)" << std::endl;
     std::cout << "------------------------------------------------" << std::endl;
 
+    std::vector<std::unique_ptr<LatencyHistogram>> latencies;
+    std::vector<PerfSample> counters;
     for (std::size_t n : sizes) {
         std::vector<Order> orders;
         orders.reserve(n);
@@ -98,6 +171,14 @@ TEST_F(PerformanceTest, OrderInsertionScaling) {
                 orderBook->addOrder(order);
             }
         });
+        counters.push_back(lastCounters);
+
+        // Second pass into a fresh book, timing each insertion on its own
+        auto& histogram = *latencies.emplace_back(std::make_unique<LatencyHistogram>());
+        OrderBook timedBook;
+        for (auto& order : orders) {
+            timeOperation(histogram, [&]() { timedBook.addOrder(order); });
+        }
 
         double milliseconds = static_cast<double>(duration.count()) / 1e6;
         double microsPerOp = (milliseconds * 1000.0) / static_cast<double>(n);
@@ -111,6 +192,15 @@ TEST_F(PerformanceTest, OrderInsertionScaling) {
 
         orderBook = std::make_unique<OrderBook>();
     }
+
+    std::vector<std::pair<std::string, const LatencyHistogram*>> rows;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        rows.emplace_back("addOrder@" + std::to_string(sizes[i]), latencies[i].get());
+    }
+    printPercentileTable("Order Insertion", rows);
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        printHardwareCounters("\naddOrder@" + std::to_string(sizes[i]), counters[i], sizes[i]);
+    }
 }
 
 TEST_F(PerformanceTest, OrderMatchingPerformance) {
@@ -146,6 +236,7 @@ TEST_F(PerformanceTest, OrderMatchingPerformance) {
         std::cout << n << "\t"
                   << std::fixed << std::setprecision(2) << milliseconds << "\t\t"
                   << microsPerOp << std::endl;
+        printHardwareCounters("matchOrders@" + std::to_string(n), lastCounters, n);
 
         // Reset the order book for the next iteration
         orderBook = std::make_unique<OrderBook>();
@@ -167,13 +258,15 @@ TEST_F(PerformanceTest, ConcurrentOrderProcessing) {
         sellOrders.push_back(generateRandomOrder(false));
     }
 
+    LatencyHistogram addLatency;
+    LatencyHistogram matchLatency;
     auto duration = measureExecutionTime([&]() {
         for (std::size_t i = 0; i < numOrders; i += batchSize) {
             for (std::size_t j = 0; j < batchSize && (i + j) < numOrders; ++j) {
-                orderBook->addOrder(buyOrders[i + j]);
-                orderBook->addOrder(sellOrders[i + j]);
+                timeOperation(addLatency, [&]() { orderBook->addOrder(buyOrders[i + j]); });
+                timeOperation(addLatency, [&]() { orderBook->addOrder(sellOrders[i + j]); });
             }
-            orderBook->matchOrders();
+            timeOperation(matchLatency, [&]() { orderBook->matchOrders(); });
         }
     });
 
@@ -181,6 +274,9 @@ TEST_F(PerformanceTest, ConcurrentOrderProcessing) {
                            numOrders * 2, // Total number of orders processed
                            duration,
                            false);
+    printPercentileTable("Concurrent Order Processing", {{"addOrder", &addLatency},
+                                                         {"matchOrders", &matchLatency}});
+    printEngineLatencies("Concurrent Order Processing");
 }
 
 TEST_F(PerformanceTest, OrderCancellationPerformance) {
@@ -196,13 +292,15 @@ TEST_F(PerformanceTest, OrderCancellationPerformance) {
         orderBook->addOrder(order);
     }
 
+    LatencyHistogram cancelLatency;
     auto duration = measureExecutionTime([&]() {
         for (const auto& [orderId, isBuyOrder] : orderIds) {
-            orderBook->cancelOrder(orderId, isBuyOrder);
+            timeOperation(cancelLatency, [&]() { orderBook->cancelOrder(orderId, isBuyOrder); });
         }
     });
 
     printPerformanceMetrics("Order Cancellation", numOrders, duration);
+    printPercentileTable("Order Cancellation", {{"cancelOrder", &cancelLatency}});
 }
 
 TEST_F(PerformanceTest, MixedOperationsPerformance) {
@@ -215,25 +313,33 @@ TEST_F(PerformanceTest, MixedOperationsPerformance) {
         orders.push_back(generateRandomOrder(i % 2 == 0));
     }
 
+    LatencyHistogram addLatency;
+    LatencyHistogram cancelLatency;
+    LatencyHistogram matchLatency;
     auto duration = measureExecutionTime([&]() {
         for (std::size_t i = 0; i < numOperations; ++i) {
             if (i % 3 == 0) {
                 // Add new order
-                orderBook->addOrder(orders[i]);
+                timeOperation(addLatency, [&]() { orderBook->addOrder(orders[i]); });
             } else if (i % 3 == 1) {
                 // Cancel an order
                 if (!orders.empty()) {
                     const auto& order = orders[i % orders.size()];
-                    orderBook->cancelOrder(order.getOrderId(), order.isBuyOrder());
+                    timeOperation(cancelLatency, [&]() {
+                        orderBook->cancelOrder(order.getOrderId(), order.isBuyOrder());
+                    });
                 }
             } else {
                 // Match orders
-                orderBook->matchOrders();
+                timeOperation(matchLatency, [&]() { orderBook->matchOrders(); });
             }
         }
     });
 
     printPerformanceMetrics("Mixed Operations", numOperations, duration, false);
+    printPercentileTable("Mixed Operations", {{"addOrder", &addLatency},
+                                              {"cancelOrder", &cancelLatency},
+                                              {"matchOrders", &matchLatency}});
 }
 
 TEST_F(PerformanceTest, HighFrequencyTrading) {
@@ -248,21 +354,26 @@ TEST_F(PerformanceTest, HighFrequencyTrading) {
         orders.push_back(generateRandomOrder(i % 2 == 0));
     }
 
+    LatencyHistogram addLatency;
+    LatencyHistogram cancelLatency;
+    LatencyHistogram matchLatency;
     auto duration = measureExecutionTime([&]() {
         for (std::size_t i = 0; i < numOrders; i += batchSize) {
             // Process a batch of orders
             for (std::size_t j = 0; j < batchSize && (i + j) < numOrders; ++j) {
-                orderBook->addOrder(orders[i + j]);
+                timeOperation(addLatency, [&]() { orderBook->addOrder(orders[i + j]); });
             }
             
             // Match after each batch
-            orderBook->matchOrders();
+            timeOperation(matchLatency, [&]() { orderBook->matchOrders(); });
             
             // Cancel oldest orders periodically
             if (i >= batchSize * 10) {
                 for (std::size_t k = 0; k < batchSize / 2; ++k) {
                     const auto& oldOrder = orders[i - batchSize * 10 + k];
-                    orderBook->cancelOrder(oldOrder.getOrderId(), oldOrder.isBuyOrder());
+                    timeOperation(cancelLatency, [&]() {
+                        orderBook->cancelOrder(oldOrder.getOrderId(), oldOrder.isBuyOrder());
+                    });
                 }
             }
         }
@@ -272,6 +383,59 @@ TEST_F(PerformanceTest, HighFrequencyTrading) {
                            numOrders, 
                            duration, 
                            true);
+    printPercentileTable("High Frequency Trading Simulation", {{"addOrder", &addLatency},
+                                                               {"cancelOrder", &cancelLatency},
+                                                               {"matchOrders", &matchLatency}});
+    printEngineLatencies("High Frequency Trading Simulation");
+}
+
+// Replays the generator's default multi-symbol flow (Zipfian symbols, about
+// twenty cancels per trade) with Hawkes arrivals, timing each command
+TEST_F(PerformanceTest, GeneratedOrderFlowReplay) {
+    constexpr std::size_t numCommands = 200000;
+    WorkloadConfig config;
+    config.seed = 42;
+    config.arrivals = ArrivalProcess::Hawkes;
+    WorkloadStream stream = WorkloadGenerator(config).generate(numCommands);
+    WorkloadReplay replay(stream);
+
+    LatencyHistogram addLatency;
+    LatencyHistogram cancelLatency;
+    LatencyHistogram matchLatency;
+    auto duration = measureExecutionTime([&]() {
+        for (const auto& command : stream.commands) {
+            LatencyHistogram& histogram = command.type == WorkloadCommandType::Add ? addLatency
+                                        : command.type == WorkloadCommandType::Cancel ? cancelLatency
+                                                                                      : matchLatency;
+            timeOperation(histogram, [&]() { replay.apply(command); });
+        }
+    });
+
+    printPerformanceMetrics("Generated Order Flow Replay", numCommands, duration, false);
+    printPercentileTable("Generated Order Flow Replay", {{"addOrder", &addLatency},
+                                                         {"cancelOrder", &cancelLatency},
+                                                         {"matchOrders", &matchLatency}});
+}
+
+// Writes one match sweep as a Chrome trace (engine_trace.json in the working
+// directory) for inspection in chrome://tracing or Perfetto
+TEST_F(PerformanceTest, TracedMatchSweep) {
+#ifndef TE_TRACEPOINTS
+    GTEST_SKIP() << "Built without TRADING_ENGINE_TRACEPOINTS";
+#endif
+    constexpr std::size_t numOrders = 2000;
+    std::vector<Order> orders;
+    orders.reserve(numOrders);
+    for (std::size_t i = 0; i < numOrders; ++i) {
+        orders.push_back(generateRandomOrder(i % 2 == 0));
+        orderBook->addOrder(orders.back());
+    }
+
+    EngineTrace::clear();
+    orderBook->matchOrders();
+    ASSERT_TRUE(EngineTrace::writeChromeTrace("engine_trace.json"));
+    std::cout << "\nWrote " << EngineTrace::eventCount() << " trace events for one match sweep to engine_trace.json"
+              << std::endl;
 }
 
 int main(int argc, char** argv) {
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "engine_trace.hpp"
+#include "order_book.hpp"
+#include "order.hpp"
+
+namespace {
+    size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+}
+
+class EngineTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        EngineTrace::clear();
+    }
+};
+
+TEST_F(EngineTraceTest, ScopesProduceBalancedEvents) {
+    {
+        TraceScope outer("outer");
+        TraceScope inner("inner");
+    }
+    EXPECT_EQ(EngineTrace::eventCount(), 4u);
+
+    std::string json = EngineTrace::chromeTraceJson();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), 2u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"E\""), 2u);
+    EXPECT_LT(json.find("\"name\":\"outer\""), json.find("\"name\":\"inner\""));
+}
+
+TEST_F(EngineTraceTest, EachThreadGetsItsOwnTrack) {
+    EngineTrace::begin("main");
+    std::thread worker([] {
+        TraceScope scope("worker");
+    });
+    worker.join();
+    EngineTrace::end("main");
+
+    std::string json = EngineTrace::chromeTraceJson();
+    EXPECT_EQ(EngineTrace::eventCount(), 4u);
+    auto mainTid = json.substr(json.find("\"tid\":", json.find("\"name\":\"main\"")), 8);
+    auto workerTid = json.substr(json.find("\"tid\":", json.find("\"name\":\"worker\"")), 8);
+    EXPECT_NE(mainTid, workerTid);
+}
+
+TEST_F(EngineTraceTest, WrappedRingDropsOrphanedEnds) {
+    EngineTrace::begin("cut");
+    for (size_t i = 0; i < EngineTrace::kEventsPerThread / 2; ++i) {
+        TraceScope scope("filler");
+    }
+    EngineTrace::end("cut");
+
+    EXPECT_EQ(EngineTrace::eventCount(), EngineTrace::kEventsPerThread);
+    std::string json = EngineTrace::chromeTraceJson();
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"cut\""), 0u);
+}
+
+TEST_F(EngineTraceTest, MatchSweepIsTracedWhenEnabled) {
+#ifndef TE_TRACEPOINTS
+    GTEST_SKIP() << "Built without TRADING_ENGINE_TRACEPOINTS";
+#endif
+    OrderBook orderBook;
+    Order buyOrder("O1", "T1", "AAPL", 100.0, 10, true);
+    Order sellOrder("O2", "T2", "AAPL", 100.0, 5, false);
+    orderBook.addOrder(buyOrder);
+    orderBook.addOrder(sellOrder);
+    orderBook.matchOrders();
+
+    std::string json = EngineTrace::chromeTraceJson();
+    EXPECT_NE(json.find("OrderBook::matchOrders/iteration"), std::string::npos);
+    EXPECT_NE(json.find("OrderBook::processMatch"), std::string::npos);
+    EXPECT_NE(json.find("PVST::delete"), std::string::npos);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), countOccurrences(json, "\"ph\":\"E\""));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "latency_histogram.hpp"
+#include "order_book.hpp"
+#include "order.hpp"
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.valueAtPercentile(99.0), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.valueAtPercentile(50.0), 50u);
+    EXPECT_EQ(histogram.valueAtPercentile(99.0), 99u);
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), 100u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+}
+
+TEST(LatencyHistogramTest, BucketsStayWithinRelativePrecision) {
+    for (uint64_t value : {128ull, 1000ull, 12345ull, 999999ull, 123456789ull, 1ull << 40}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::kBucketCount);
+        uint64_t low = LatencyHistogram::bucketLowestValue(index);
+        uint64_t high = LatencyHistogram::bucketHighestValue(index);
+        EXPECT_LE(low, value);
+        EXPECT_GE(high, value);
+        EXPECT_LE(static_cast<double>(high - low), static_cast<double>(value) / 64.0);
+    }
+    // Out-of-range values land in the last bucket
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, TailPercentilesSeeOutliers) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(1'000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(1'000'000);
+    }
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(50.0)), 1'000.0, 1'000.0 / 64);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(99.0)), 1'000.0, 1'000.0 / 64);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(99.9)), 1'000'000.0, 1'000'000.0 / 64);
+    EXPECT_EQ(histogram.max(), 1'000'000u);
+}
+
+TEST(LatencyHistogramTest, MergeAddsCounts) {
+    LatencyHistogram first;
+    LatencyHistogram second;
+    first.record(10);
+    second.record(5'000);
+    second.record(20);
+
+    first.merge(second);
+    EXPECT_EQ(first.count(), 3u);
+    EXPECT_EQ(first.min(), 10u);
+    EXPECT_EQ(first.max(), 5'000u);
+    EXPECT_EQ(first.valueAtPercentile(50.0), 20u);
+}
+
+TEST(LatencyHistogramTest, CopiesAndRecordsDurations) {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::nanoseconds(-5));  // Counted as zero
+
+    LatencyHistogram copy(histogram);
+    histogram.reset();
+    EXPECT_EQ(copy.count(), 2u);
+    EXPECT_EQ(copy.min(), 0u);
+    EXPECT_EQ(copy.max(), 3'000u);
+
+    histogram.record(7);
+    copy = histogram;
+    EXPECT_EQ(copy.count(), 1u);
+    EXPECT_EQ(copy.min(), 7u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordingLosesNothing) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (uint64_t i = 0; i < 10'000; ++i) {
+                histogram.record(static_cast<uint64_t>(t) * 1'000 + i % 500);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.count(), 40'000u);
+    EXPECT_EQ(histogram.max(), 3'499u);
+}
+
+TEST(LatencyHistogramTest, PercentileDistributionEndsAtMax) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1'000; ++value) {
+        histogram.record(value * 1'000);
+    }
+    std::ostringstream out;
+    histogram.outputPercentileDistribution(out);
+    std::string text = out.str();
+    EXPECT_NE(text.find("Percentile"), std::string::npos);
+    EXPECT_NE(text.find("1000.000 1.000000000000       1000"), std::string::npos);
+    EXPECT_NE(text.find("#[Total count    =         1000"), std::string::npos);
+}
+
+TEST(LatencyHistogramTest, OrderBookRecordsOperationsWhenEnabled) {
+    OrderBook orderBook;
+    if (!OrderBook::latencyTrackingEnabled()) {
+        EXPECT_EQ(orderBook.getLatencies(), nullptr);
+        GTEST_SKIP() << "Built without TRADING_ENGINE_LATENCY_HISTOGRAMS";
+    }
+    Order buyOrder("O1", "T1", "AAPL", 100.0, 10, true);
+    Order sellOrder("O2", "T2", "AAPL", 100.0, 10, false);
+    orderBook.addOrder(buyOrder);
+    orderBook.addOrder(sellOrder);
+    orderBook.matchOrders();
+    orderBook.cancelOrder("O1", true);
+
+    const OrderBookLatencies* latencies = orderBook.getLatencies();
+    ASSERT_NE(latencies, nullptr);
+    EXPECT_EQ(latencies->addOrder.count(), 2u);
+    EXPECT_EQ(latencies->matchOrders.count(), 1u);
+    EXPECT_EQ(latencies->cancelOrder.count(), 1u);
+}
@@ -284,6 +284,81 @@ TEST_F(OrderBookTest, ZeroQuantityOrders) {
     EXPECT_THROW(Order("S1", "T2", "APPL", 160.0, 0, false), std::invalid_argument);
 }
 
+TEST_F(OrderBookTest, AmendOrderMovesPriceAndQuantity) {
+    Order buyOrder("B1", "T1", "AAPL", 99.0, 5, true);
+    Order sellOrder("S1", "T2", "AAPL", 100.0, 8, false);
+    orderBook->addOrder(buyOrder);
+    orderBook->addOrder(sellOrder);
+
+    EXPECT_TRUE(orderBook->amendOrder("B1", true, 100.0, 8));
+    EXPECT_EQ(orderBook->getQuantityAtPrice(99.0, true), 0);
+    EXPECT_EQ(orderBook->getQuantityAtPrice(100.0, true), 8);
+
+    // The amended price now crosses
+    orderBook->matchOrders();
+    EXPECT_EQ(buyOrder.getRemainingQuantity(), 0);
+    EXPECT_EQ(sellOrder.getRemainingQuantity(), 0);
+}
+
+TEST_F(OrderBookTest, AmendOrderRejectsMissingCanceledAndInvalid) {
+    Order buyOrder("B1", "T1", "AAPL", 99.0, 5, true);
+    orderBook->addOrder(buyOrder);
+
+    EXPECT_FALSE(orderBook->amendOrder("B2", true, 98.0, 5));
+    EXPECT_FALSE(orderBook->amendOrder("B1", false, 98.0, 5));
+    EXPECT_THROW(orderBook->amendOrder("B1", true, 98.0, 0), std::invalid_argument);
+    EXPECT_EQ(orderBook->getQuantityAtPrice(99.0, true), 5);
+
+    orderBook->cancelOrder("B1", true);
+    EXPECT_FALSE(orderBook->amendOrder("B1", true, 98.0, 5));
+}
+
+TEST_F(OrderBookTest, AmendOrderLosesPriorityOnPriceChangeOrIncrease) {
+    Order first("B1", "T1", "AAPL", 99.0, 5, true);
+    Order second("B2", "T1", "AAPL", 99.0, 5, true);
+    Order third("B3", "T1", "AAPL", 99.0, 5, true);
+    orderBook->addOrder(first);
+    orderBook->addOrder(second);
+    orderBook->addOrder(third);
+
+    // B1 grows, B2 leaves the level and comes back, and B3 only shrinks
+    EXPECT_TRUE(orderBook->amendOrder("B1", true, 99.0, 6));
+    EXPECT_TRUE(orderBook->amendOrder("B2", true, 98.0, 5));
+    EXPECT_TRUE(orderBook->amendOrder("B2", true, 99.0, 5));
+    EXPECT_TRUE(orderBook->amendOrder("B3", true, 99.0, 4));
+
+    Order sellOrder("S1", "T2", "AAPL", 99.0, 4, false);
+    orderBook->addOrder(sellOrder);
+    orderBook->matchOrders();
+    EXPECT_EQ(third.getRemainingQuantity(), 0);
+    EXPECT_EQ(first.getRemainingQuantity(), 6);
+    EXPECT_EQ(second.getRemainingQuantity(), 5);
+
+    Order nextSell("S2", "T2", "AAPL", 99.0, 6, false);
+    orderBook->addOrder(nextSell);
+    orderBook->matchOrders();
+    EXPECT_EQ(first.getRemainingQuantity(), 0);
+    EXPECT_EQ(second.getRemainingQuantity(), 5);
+}
+
+TEST_F(OrderBookTest, AmendOrderChangesOnlyTheRemainingQuantity) {
+    Order buyOrder("B1", "T1", "AAPL", 100.0, 10, true);
+    Order sellOrder("S1", "T2", "AAPL", 100.0, 4, false);
+    orderBook->addOrder(buyOrder);
+    orderBook->addOrder(sellOrder);
+    orderBook->matchOrders();
+    ASSERT_EQ(buyOrder.getRemainingQuantity(), 6);
+
+    EXPECT_TRUE(orderBook->amendOrder("B1", true, 100.0, 3));
+    EXPECT_EQ(buyOrder.getRemainingQuantity(), 3);
+    EXPECT_EQ(buyOrder.getQuantity(), 7);  // The 4 filled plus the 3 open
+    EXPECT_EQ(orderBook->getQuantityAtPrice(100.0, true), 3);
+
+    EXPECT_TRUE(orderBook->amendOrder("B1", true, 101.0, 8));
+    EXPECT_EQ(buyOrder.getRemainingQuantity(), 8);
+    EXPECT_EQ(buyOrder.getQuantity(), 12);
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <sstream>
+#include "perf_counters.hpp"
+
+namespace {
+    // Enough dependent work for every counter to move
+    uint64_t spin(uint64_t iterations) {
+        volatile uint64_t sink = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            sink = sink + (i ^ (sink << 1));
+        }
+        return sink;
+    }
+}
+
+TEST(PerfCountersTest, TimesRegionWhetherOrNotCountersOpen) {
+    PerfCounters counters;
+    PerfSample sample;
+    {
+        ScopedPerfRegion region(counters, sample);
+        spin(100'000);
+    }
+    EXPECT_GT(sample.elapsedNanos, 0u);
+    EXPECT_EQ(sample.anyCounters(), counters.available());
+    EXPECT_EQ(counters.unavailableReason().empty(), counters.available());
+}
+
+TEST(PerfCountersTest, EnvironmentDisablesCounters) {
+    setenv("TE_PERF_COUNTERS", "0", 1);
+    PerfCounters counters;
+    unsetenv("TE_PERF_COUNTERS");
+
+    EXPECT_FALSE(counters.available());
+    EXPECT_NE(counters.unavailableReason().find("TE_PERF_COUNTERS"), std::string::npos);
+    counters.start();
+    PerfSample sample = counters.stop();
+    EXPECT_FALSE(sample.anyCounters());
+}
+
+TEST(PerfCountersTest, CountsInstructionsWhenAvailable) {
+    PerfCounters counters;
+    counters.start();
+    spin(1'000'000);
+    PerfSample sample = counters.stop();
+    if (!sample.has(PerfEvent::Instructions)) {
+        GTEST_SKIP() << "Instruction counter unavailable: " << counters.unavailableReason();
+    }
+    // At least one instruction per loop iteration
+    EXPECT_GE(sample.get(PerfEvent::Instructions), 1'000'000u);
+}
+
+TEST(PerfCountersTest, PerOperationReportMarksMissingCounters) {
+    PerfSample sample;
+    sample.values[static_cast<size_t>(PerfEvent::Cycles)] = 2'000;
+    sample.valid[static_cast<size_t>(PerfEvent::Cycles)] = true;
+    sample.values[static_cast<size_t>(PerfEvent::Instructions)] = 3'000;
+    sample.valid[static_cast<size_t>(PerfEvent::Instructions)] = true;
+
+    std::ostringstream out;
+    PerfCounters::printPerOperation(out, sample, 10);
+    std::string text = out.str();
+    EXPECT_NE(text.find("200.00 /op"), std::string::npos);
+    EXPECT_NE(text.find("IPC"), std::string::npos);
+    EXPECT_NE(text.find("1.50"), std::string::npos);
+    EXPECT_NE(text.find("n/a"), std::string::npos);
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <sstream>
+#include <type_traits>
+#include "workload_generator.hpp"
+#include "workload_replay.hpp"
+
+namespace {
+    size_t countType(const WorkloadStream& stream, WorkloadCommandType type) {
+        return static_cast<size_t>(std::count_if(stream.commands.begin(), stream.commands.end(),
+                                                 [type](const WorkloadCommand& command) { return command.type == type; }));
+    }
+
+    // Variance over mean of arrivals per window: 1 for Poisson, above 1 when bursty
+    double dispersion(const WorkloadStream& stream, uint64_t windowNanos) {
+        std::map<uint64_t, double> counts;
+        for (const auto& command : stream.commands) {
+            if (command.type != WorkloadCommandType::Match) {
+                counts[command.timestampNanos / windowNanos] += 1.0;
+            }
+        }
+        uint64_t windows = stream.commands.back().timestampNanos / windowNanos + 1;
+        double mean = 0.0;
+        for (const auto& [_, count] : counts) {
+            mean += count;
+        }
+        mean /= static_cast<double>(windows);
+        double variance = 0.0;
+        for (uint64_t window = 0; window < windows; ++window) {
+            auto it = counts.find(window);
+            double count = it == counts.end() ? 0.0 : it->second;
+            variance += (count - mean) * (count - mean);
+        }
+        variance /= static_cast<double>(windows);
+        return variance / mean;
+    }
+}
+
+TEST(WorkloadGeneratorTest, SameSeedSameStream) {
+    WorkloadConfig config;
+    config.seed = 7;
+    WorkloadStream first = WorkloadGenerator(config).generate(5'000);
+    WorkloadStream second = WorkloadGenerator(config).generate(5'000);
+    EXPECT_EQ(first.commands, second.commands);
+
+    config.seed = 8;
+    WorkloadStream other = WorkloadGenerator(config).generate(5'000);
+    EXPECT_NE(first.commands, other.commands);
+}
+
+TEST(WorkloadGeneratorTest, EventMixFollowsConfig) {
+    WorkloadStream stream = WorkloadGenerator(WorkloadConfig{}).generate(200'000);
+    double cancels = static_cast<double>(countType(stream, WorkloadCommandType::Cancel));
+    double matches = static_cast<double>(countType(stream, WorkloadCommandType::Match));
+    EXPECT_NEAR(cancels / matches, 20.0, 2.0);
+
+    // Every marketable add is followed by a match on its symbol
+    for (size_t i = 0; i < stream.commands.size(); ++i) {
+        if (stream.commands[i].type == WorkloadCommandType::Match) {
+            ASSERT_GT(i, 0u);
+            EXPECT_EQ(stream.commands[i - 1].type, WorkloadCommandType::Add);
+            EXPECT_EQ(stream.commands[i - 1].symbol, stream.commands[i].symbol);
+        }
+    }
+}
+
+TEST(WorkloadGeneratorTest, CancelsNameLiveOrdersAndFavourYoungOnes) {
+    WorkloadStream stream = WorkloadGenerator(WorkloadConfig{}).generate(50'000);
+    std::map<uint64_t, size_t> addedAt;
+    std::set<uint64_t> canceled;
+    std::vector<size_t> ages;
+    for (size_t i = 0; i < stream.commands.size(); ++i) {
+        const WorkloadCommand& command = stream.commands[i];
+        if (command.type == WorkloadCommandType::Add) {
+            addedAt[command.orderId] = i;
+        } else if (command.type == WorkloadCommandType::Cancel) {
+            ASSERT_TRUE(addedAt.count(command.orderId)) << "cancel before add";
+            EXPECT_TRUE(canceled.insert(command.orderId).second) << "canceled twice";
+            ages.push_back(i - addedAt[command.orderId]);
+        }
+    }
+    std::sort(ages.begin(), ages.end());
+    // Most cancels land within a few dozen events of the add
+    EXPECT_LT(ages[ages.size() / 2], 100u);
+}
+
+TEST(WorkloadGeneratorTest, SymbolActivityIsZipfian) {
+    WorkloadStream stream = WorkloadGenerator(WorkloadConfig{}).generate(100'000);
+    std::vector<double> adds(stream.symbols.size(), 0.0);
+    for (const auto& command : stream.commands) {
+        if (command.type == WorkloadCommandType::Add) {
+            adds[command.symbol] += 1.0;
+        }
+    }
+    // With exponent 1 the top symbol sees about twice the second's flow
+    EXPECT_NEAR(adds[0] / adds[1], 2.0, 0.2);
+    EXPECT_NEAR(adds[0] / adds[3], 4.0, 0.5);
+}
+
+TEST(WorkloadGeneratorTest, PassivePricesClusterNearTheTouch) {
+    WorkloadConfig config;
+    config.symbols = {"AAPL"};
+    config.midMoveProbability = 0.0;
+    config.marketableProbability = 0.0;
+    WorkloadStream stream = WorkloadGenerator(config).generate(20'000);
+    size_t nearTouch = 0;
+    size_t adds = 0;
+    for (const auto& command : stream.commands) {
+        if (command.type != WorkloadCommandType::Add) {
+            continue;
+        }
+        ++adds;
+        // On the tick grid and on the passive side of the mid
+        EXPECT_NEAR(command.price * 100.0, std::round(command.price * 100.0), 1e-6);
+        EXPECT_TRUE(command.isBuyOrder ? command.price <= 99.99 : command.price >= 100.01);
+        nearTouch += std::abs(command.price - 100.0) <= 0.05 + 1e-9 ? 1 : 0;
+    }
+    EXPECT_GT(static_cast<double>(nearTouch) / static_cast<double>(adds), 0.6);
+}
+
+TEST(WorkloadGeneratorTest, HawkesArrivalsAreBursty) {
+    WorkloadConfig config;
+    WorkloadStream poisson = WorkloadGenerator(config).generate(100'000);
+    config.arrivals = ArrivalProcess::Hawkes;
+    WorkloadStream hawkes = WorkloadGenerator(config).generate(100'000);
+
+    constexpr uint64_t kWindowNanos = 100'000;
+    EXPECT_NEAR(dispersion(poisson, kWindowNanos), 1.0, 0.2);
+    EXPECT_GT(dispersion(hawkes, kWindowNanos), 2.0);
+
+    config.hawkesJumpPerSecond = config.hawkesDecayPerSecond;
+    EXPECT_THROW(WorkloadGenerator{config}, std::invalid_argument);
+}
+
+TEST(WorkloadGeneratorTest, RejectsNonPositiveRates) {
+    WorkloadConfig config;
+    config.baseRatePerSecond = 0.0;
+    EXPECT_THROW(WorkloadGenerator{config}, std::invalid_argument);
+    config.baseRatePerSecond = -1.0;
+    EXPECT_THROW(WorkloadGenerator{config}, std::invalid_argument);
+    config.baseRatePerSecond = std::nan("");
+    EXPECT_THROW(WorkloadGenerator{config}, std::invalid_argument);
+}
+
+TEST(WorkloadGeneratorTest, CsvRoundTrips) {
+    WorkloadStream stream = WorkloadGenerator(WorkloadConfig{}).generate(2'000);
+    std::stringstream csv;
+    stream.writeCsv(csv);
+    WorkloadStream parsed = WorkloadStream::readCsv(csv);
+    EXPECT_EQ(parsed.symbols, stream.symbols);
+    EXPECT_EQ(parsed.commands, stream.commands);
+
+    std::istringstream bad("timestamp_ns,type,order_id,symbol,side,price,quantity\n1,X,1,AAPL,B,1.0,100\n");
+    EXPECT_THROW(WorkloadStream::readCsv(bad), std::runtime_error);
+}
+
+// The replay keeps a reference to its stream, so it cannot take a temporary
+static_assert(!std::is_constructible_v<WorkloadReplay, WorkloadStream&&>);
+static_assert(std::is_constructible_v<WorkloadReplay, const WorkloadStream&>);
+
+TEST(WorkloadReplayTest, ReplaysOntoPerSymbolBooks) {
+    WorkloadStream stream;
+    stream.symbols = {"AAPL", "MSFT"};
+    stream.commands = {
+        {WorkloadCommandType::Add, 1, 1, 0, true, 100.0, 300},
+        {WorkloadCommandType::Add, 2, 2, 1, true, 50.0, 100},
+        {WorkloadCommandType::Add, 3, 3, 0, false, 100.0, 100},
+        {WorkloadCommandType::Match, 3, 0, 0, false, 0.0, 0},
+        {WorkloadCommandType::Cancel, 4, 2, 1, true, 50.0, 100},
+        {WorkloadCommandType::Cancel, 5, 99, 1, true, 50.0, 100},
+    };
+    WorkloadReplay replay(stream);
+    replay.applyAll();
+
+    EXPECT_EQ(replay.book(0).getQuantityAtPrice(100.0, true), 200);
+    EXPECT_EQ(replay.book(0).getQuantityAtPrice(100.0, false), 0);
+    EXPECT_TRUE(replay.book(1).isOrderCanceled("2", true));
+}
@@ -0,0 +1,102 @@
+// common/include/latency_histogram.hpp
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include "tsc_clock.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Log-linear (HDR-style) histogram of latencies in nanoseconds.
+//
+// Values below 128 ns are counted exactly. Above that, each power of two is
+// split into 64 equal sub-buckets, so any recorded value is reported within
+// 1/64 (about 1.6%) of its true value, up to 2^41 ns (about 36 minutes);
+// larger values are clamped. The bucket array is fixed, so recording never
+// allocates.
+//
+// record() is lock-free and safe from any number of threads: every counter
+// is a relaxed atomic. Readers see a consistent-enough view for reporting,
+// not a snapshot. Histograms with the same layout merge by adding buckets,
+// and a copy is such a merge into an empty histogram. The engine times its
+// operations with it, and the order client its RPCs.
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 6;
+    static constexpr uint64_t kSubBucketCount = uint64_t{1} << kSubBucketBits;   // Per power of two
+    static constexpr uint64_t kExactLimit = 2 * kSubBucketCount;                 // Values counted exactly
+    static constexpr unsigned kMaxExponent = 40;                                 // Highest power of two tracked
+    static constexpr uint64_t kMaxTrackable = (uint64_t{1} << (kMaxExponent + 1)) - 1;
+    static constexpr size_t kBucketCount =
+        kExactLimit + (kMaxExponent - kSubBucketBits) * kSubBucketCount;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram& other) noexcept { merge(other); }
+    LatencyHistogram& operator=(const LatencyHistogram& other) noexcept {
+        if (this != &other) {
+            reset();
+            merge(other);
+        }
+        return *this;
+    }
+
+    void record(uint64_t nanos) noexcept;
+    // Negative durations count as zero
+    void record(std::chrono::nanoseconds value) noexcept {
+        record(static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(value.count(), 0)));
+    }
+    void merge(const LatencyHistogram& other) noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t min() const noexcept;
+    [[nodiscard]] uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+    [[nodiscard]] double mean() const noexcept;
+    // Smallest recorded value (to bucket precision) that at least `percentile`
+    // percent of recorded values are at or below; 0 when empty
+    [[nodiscard]] uint64_t valueAtPercentile(double percentile) const noexcept;
+
+    // One-line p50/p90/p99/p99.9/max summary in microseconds
+    [[nodiscard]] std::string summary() const;
+    // HdrHistogram's percentile distribution text (Value, Percentile,
+    // TotalCount, 1/(1-Percentile)), values in microseconds, readable by
+    // the HdrHistogram plotter
+    void outputPercentileDistribution(std::ostream& out, unsigned ticksPerHalfDistance = 5) const;
+
+    // Bucket layout, exposed for tests and exporters
+    [[nodiscard]] static size_t bucketIndex(uint64_t nanos) noexcept;
+    [[nodiscard]] static uint64_t bucketLowestValue(size_t index) noexcept;
+    [[nodiscard]] static uint64_t bucketHighestValue(size_t index) noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+// Records the time from construction to destruction into a histogram
+class ScopedLatencyTimer {
+public:
+    explicit ScopedLatencyTimer(LatencyHistogram& histogram) noexcept
+        : histogram_(histogram)
+        , startTicks_(TscClock::now())
+    {}
+
+    ~ScopedLatencyTimer() { histogram_.record(TscClock::toNanos(TscClock::now() - startTicks_)); }
+
+    ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+    ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    uint64_t startTicks_;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,53 @@
+// common/include/tsc_clock.hpp
+#ifndef TSC_CLOCK_HPP
+#define TSC_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cycle-counter clock for timing engine operations and tracing server
+// requests. Reading it costs a few nanoseconds and no system call. On x86
+// it is the invariant TSC; elsewhere it falls back to steady_clock
+// nanoseconds, so ticks always convert with nanosPerTick().
+class TscClock {
+public:
+    [[nodiscard]] static uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Calibrated once against steady_clock, on first use (about 10 ms)
+    [[nodiscard]] static double nanosPerTick() {
+        static const double nanosPerTick = calibrate();
+        return nanosPerTick;
+    }
+
+    [[nodiscard]] static uint64_t toNanos(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * nanosPerTick());
+    }
+
+private:
+    static double calibrate() {
+#if defined(__x86_64__) || defined(__i386__)
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t startTicks = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t endTicks = now();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+        return endTicks > startTicks ? elapsed.count() / static_cast<double>(endTicks - startTicks) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+};
+
+#endif // TSC_CLOCK_HPP
@@ -0,0 +1,169 @@
+// common/src/latency_histogram.cpp
+#include "latency_histogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    void storeMin(std::atomic<uint64_t>& target, uint64_t value) noexcept {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void storeMax(std::atomic<uint64_t>& target, uint64_t value) noexcept {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    double toMicros(uint64_t nanos) {
+        return static_cast<double>(nanos) / 1000.0;
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t nanos) noexcept {
+    if (nanos < kExactLimit) {
+        return static_cast<size_t>(nanos);
+    }
+    nanos = std::min(nanos, kMaxTrackable);
+    auto exponent = static_cast<unsigned>(std::bit_width(nanos) - 1);
+    unsigned shift = exponent - kSubBucketBits;
+    uint64_t subBucket = (nanos >> shift) - kSubBucketCount;
+    return static_cast<size_t>(kExactLimit + (exponent - kSubBucketBits - 1) * kSubBucketCount + subBucket);
+}
+
+uint64_t LatencyHistogram::bucketLowestValue(size_t index) noexcept {
+    if (index < kExactLimit) {
+        return index;
+    }
+    uint64_t offset = index - kExactLimit;
+    unsigned shift = static_cast<unsigned>(offset / kSubBucketCount) + 1;
+    return (kSubBucketCount + offset % kSubBucketCount) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHighestValue(size_t index) noexcept {
+    if (index < kExactLimit) {
+        return index;
+    }
+    unsigned shift = static_cast<unsigned>((index - kExactLimit) / kSubBucketCount) + 1;
+    return bucketLowestValue(index) + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanos) noexcept {
+    buckets_[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(nanos, std::memory_order_relaxed);
+    storeMin(min_, nanos);
+    storeMax(max_, nanos);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        if (uint64_t count = other.buckets_[i].load(std::memory_order_relaxed)) {
+            buckets_[i].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    count_.fetch_add(other.count(), std::memory_order_relaxed);
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    storeMin(min_, other.min_.load(std::memory_order_relaxed));
+    storeMax(max_, other.max());
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::min() const noexcept {
+    return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const noexcept {
+    uint64_t total = count();
+    return total == 0 ? 0.0
+                      : static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(total);
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const noexcept {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        if (cumulative >= target) {
+            // Reported at the top of the bucket, but never above the true max
+            return std::min(bucketHighestValue(i), max());
+        }
+    }
+    return max();
+}
+
+std::string LatencyHistogram::summary() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2)
+        << "count=" << count()
+        << " p50=" << toMicros(valueAtPercentile(50.0)) << "us"
+        << " p90=" << toMicros(valueAtPercentile(90.0)) << "us"
+        << " p99=" << toMicros(valueAtPercentile(99.0)) << "us"
+        << " p99.9=" << toMicros(valueAtPercentile(99.9)) << "us"
+        << " max=" << toMicros(max()) << "us";
+    return out.str();
+}
+
+void LatencyHistogram::outputPercentileDistribution(std::ostream& out, unsigned ticksPerHalfDistance) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed
+        << std::setw(12) << "Value" << " " << std::setw(14) << "Percentile" << " "
+        << std::setw(10) << "TotalCount" << " " << std::setw(14) << "1/(1-Percentile)" << "\n\n";
+
+    // Walk the buckets once, emitting a line for each reporting percentile
+    // the cumulative count has reached. Reporting steps halve every
+    // time the remaining distance to 100% halves, as HdrHistogram does.
+    uint64_t total = count();
+    double nextPercentile = 0.0;
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kBucketCount && total > 0; ++i) {
+        uint64_t bucketCount = buckets_[i].load(std::memory_order_relaxed);
+        if (bucketCount == 0) {
+            continue;
+        }
+        cumulative += bucketCount;
+        double reached = 100.0 * static_cast<double>(cumulative) / static_cast<double>(total);
+        uint64_t value = std::min(bucketHighestValue(i), max());
+        while (nextPercentile <= reached && cumulative < total) {
+            out << std::setprecision(3) << std::setw(12) << toMicros(value) << " "
+                << std::setprecision(12) << std::setw(14) << nextPercentile / 100.0 << " "
+                << std::setw(10) << cumulative << " "
+                << std::setprecision(2) << std::setw(14) << 1.0 / (1.0 - nextPercentile / 100.0) << "\n";
+            double halfDistance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - nextPercentile))) + 1.0);
+            nextPercentile += 100.0 / (ticksPerHalfDistance * halfDistance);
+        }
+    }
+    if (total > 0) {
+        out << std::setprecision(3) << std::setw(12) << toMicros(max()) << " "
+            << std::setprecision(12) << std::setw(14) << 1.0 << " "
+            << std::setw(10) << total << "\n";
+    }
+    out << std::setprecision(3)
+        << "#[Mean    = " << std::setw(12) << mean() / 1000.0
+        << ", Max            = " << std::setw(12) << toMicros(max()) << "]\n"
+        << "#[Total count    = " << std::setw(12) << total
+        << ", SubBuckets     = " << std::setw(12) << kSubBucketCount << "]\n";
+    out.flags(flags);
+    out.precision(precision);
+}